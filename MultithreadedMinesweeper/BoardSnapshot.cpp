@@ -0,0 +1,171 @@
+#include "stdafx.h"
+#include "BoardSnapshot.h"
+
+static_assert(sizeof(BoardSnapshot::Header) == 48, "the snapshot header must match the file format");
+
+/*
+*	Constructor
+*
+*	creates the snapshot of a board that has not been generated, every tile is unshown
+*/
+BoardSnapshot::BoardSnapshot(uint32_t rows, uint32_t columns, uint32_t mines, uint64_t seed) {
+	std::memcpy(header.magic, "MSNP", 4);
+	header.version = VERSION;
+	header.seed = seed;
+	header.rows = rows;
+	header.columns = columns;
+	header.mines = mines;
+	header.flagsLeft = mines;
+	header.time = 0;
+	header.isGenerated = 0;
+	header.firstRow = 0;
+	header.firstColumn = 0;
+	tiles.assign(static_cast<size_t>(getMineBytes() + getVisibilityBytes()), 0);
+}
+/*
+*	Constructor
+*
+*	only used by load(), which fills in the header and the mapping
+*/
+BoardSnapshot::BoardSnapshot() {
+}
+
+/*
+* Function: load
+*
+* Paramters: const std::string &path
+*
+* Return Type: BoardSnapshot
+*
+* Description: Maps a snapshot file and checks its header, the tiles are not read until
+*					they are used. Throws an Exception if the file can not be mapped or
+*					is not a snapshot of this version.
+*
+*/
+BoardSnapshot BoardSnapshot::load(const std::string &path) throw(Exception) {
+	try {
+		BoardSnapshot snapshot;
+		snapshot.pMapping = std::make_shared<MappedFile>(path);
+		if (snapshot.pMapping->getSize() < sizeof(Header)) {
+			throw Exception("file is too small to be a snapshot", "BoardSnapshot.cpp", "load");
+		}
+		std::memcpy(&snapshot.header, snapshot.pMapping->getData(), sizeof(Header));
+		if (std::memcmp(snapshot.header.magic, "MSNP", 4) != 0 || snapshot.header.version != VERSION) {
+			throw Exception("file is not a snapshot of version " + std::to_string(VERSION), "BoardSnapshot.cpp", "load");
+		}
+		if (snapshot.pMapping->getSize() != sizeof(Header) + snapshot.getMineBytes() + snapshot.getVisibilityBytes()) {
+			throw Exception("snapshot size does not match its header", "BoardSnapshot.cpp", "load");
+		}
+		return snapshot;
+	}
+	catch (Exception &excpt) {
+		throw excpt;
+	}
+}
+/*
+* Function: save
+*
+* Paramters: const std::string &path
+*
+* Return Type: void
+*
+* Description: Writes the snapshot to a file, replacing the file if it exists.
+*					Throws an Exception if the file can not be written.
+*
+*/
+void BoardSnapshot::save(const std::string &path) const throw(Exception) {
+	try {
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) {
+			throw Exception("failed to open file " + path, "BoardSnapshot.cpp", "save");
+		}
+		file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+		file.write(reinterpret_cast<const char*>(getTiles()), static_cast<std::streamsize>(getMineBytes() + getVisibilityBytes()));
+		if (!file.good()) {
+			throw Exception("failed to write file " + path, "BoardSnapshot.cpp", "save");
+		}
+	}
+	catch (Exception &excpt) {
+		throw excpt;
+	}
+}
+
+/*
+* The next four functions read and write the tiles, a cell is indexed as
+*		column + row * columns. The mines are bit n % 8 of byte n / 8, the
+*		visibility is bits 2 * (n % 4) and up of byte n / 4 after the mines.
+*
+*/
+bool BoardSnapshot::isMine(uint64_t cell) const {
+	return (getTiles()[cell >> 3] >> (cell & 7)) & 1;
+}
+
+void BoardSnapshot::setMine(uint64_t cell, bool isMine) {
+	uint8_t &byte = editTiles()[cell >> 3];
+	uint8_t bit = static_cast<uint8_t>(1 << (cell & 7));
+	byte = isMine ? (byte | bit) : (byte & ~bit);
+}
+
+BoardSnapshot::tile_visibility BoardSnapshot::getVisibility(uint64_t cell) const {
+	uint8_t byte = getTiles()[getMineBytes() + (cell >> 2)];
+	return static_cast<tile_visibility>((byte >> ((cell & 3) * 2)) & 3);
+}
+
+void BoardSnapshot::setVisibility(uint64_t cell, tile_visibility visibility) {
+	uint8_t &byte = editTiles()[getMineBytes() + (cell >> 2)];
+	uint32_t shift = static_cast<uint32_t>(cell & 3) * 2;
+	byte = static_cast<uint8_t>((byte & ~(3 << shift)) | (visibility << shift));
+}
+
+/*
+* The following functions are generic accessor methods
+*
+*/
+const BoardSnapshot::Header & BoardSnapshot::getHeader() const {
+	return header;
+}
+
+BoardSnapshot::Header & BoardSnapshot::editHeader() {
+	return header;
+}
+
+uint64_t BoardSnapshot::getNumOfCells() const {
+	return static_cast<uint64_t>(header.rows) * header.columns;
+}
+
+//************************************************
+//END OF PUBLIC METHODS, START OF PRIVATE METHODS*
+//************************************************
+
+//returns the number of bytes of the mine bits and the visibility bits
+uint64_t BoardSnapshot::getMineBytes() const {
+	return (getNumOfCells() + 7) / 8;
+}
+
+uint64_t BoardSnapshot::getVisibilityBytes() const {
+	return (getNumOfCells() + 3) / 4;
+}
+
+//returns the tiles, from the mapping if the snapshot was loaded and has not been changed
+const uint8_t * BoardSnapshot::getTiles() const {
+	return (pMapping != nullptr) ? pMapping->getData() + sizeof(Header) : tiles.data();
+}
+/*
+* Function: editTiles
+*
+* Paramters: none
+*
+* Return Type: uint8_t *
+*
+* Description: returns the tiles to be changed, the first change to a loaded snapshot
+*					copies its tiles out of the mapping since the mapping is read only
+*
+*/
+uint8_t * BoardSnapshot::editTiles() {
+	if (pMapping != nullptr) {
+		const uint8_t *pMapped = getTiles();
+		tiles.assign(pMapped, pMapped + getMineBytes() + getVisibilityBytes());
+		pMapping.reset();
+	}
+	return tiles.data();
+}
@@ -0,0 +1,76 @@
+/*
+* TITLE:	Multi-threaded Minesweeper
+* BY:		Eric Hollas
+*
+* FILE:		BoardSnapshot.h
+* DETAILS:	This file defines the binary snapshot of a game. The file is a fixed size
+*				header followed by one bit per tile for the mines and two bits per tile
+*				for what the player sees (unshown, flagged or showing), the numbers of
+*				the tiles are not stored since they are counted from the mines on load.
+*				A board of n tiles takes 48 + n / 8 + n / 4 bytes.
+*			A snapshot that is loaded maps the file instead of reading it, see MappedFile.h,
+*				so the tiles are read straight from the mapping until the first change,
+*				which copies them. The header is checked against the size of the file.
+*/
+
+#pragma once
+#include "stdafx.h"
+#include "Exception.h"
+#include "MappedFile.h"
+#include <memory>
+
+class BoardSnapshot {
+public:
+	// what the player sees of a tile, the same values as TileManager::gameboard_isShowing
+	enum tile_visibility : uint8_t {
+		tile_unshown,
+		tile_flagged,
+		tile_showing
+	};
+
+	// the header at the start of the file, every field is little endian
+	struct Header {
+		char magic[4];				//"MSNP"
+		uint32_t version;
+		uint64_t seed;
+		uint32_t rows;
+		uint32_t columns;
+		uint32_t mines;
+		uint32_t flagsLeft;			//the mine count shown on the scoreboard
+		int32_t time;				//the seconds shown on the scoreboard
+		uint32_t isGenerated;		//0 before the first click, the mines are all clear
+		uint32_t firstRow;			//the first click, kept clear of mines by the generator
+		uint32_t firstColumn;
+	};
+
+	static const uint32_t VERSION = 1;
+
+	BoardSnapshot(uint32_t rows, uint32_t columns, uint32_t mines, uint64_t seed);
+
+	static BoardSnapshot load(const std::string &path) throw(Exception);
+	void save(const std::string &path) const throw(Exception);
+
+	bool isMine(uint64_t cell) const;
+	void setMine(uint64_t cell, bool isMine);
+	tile_visibility getVisibility(uint64_t cell) const;
+	void setVisibility(uint64_t cell, tile_visibility visibility);
+
+	const Header & getHeader() const;
+	Header & editHeader();
+	uint64_t getNumOfCells() const;
+
+private:
+	Header header;
+
+	// the tiles are either owned or read from a mapped file, the mapping is
+	//	shared so that a loaded snapshot can be copied
+	std::vector<uint8_t> tiles;
+	std::shared_ptr<MappedFile> pMapping;
+
+	BoardSnapshot();
+
+	uint64_t getMineBytes() const;
+	uint64_t getVisibilityBytes() const;
+	const uint8_t * getTiles() const;
+	uint8_t * editTiles();
+};
@@ -0,0 +1,753 @@
+#include "stdafx.h"
+#include "BoardSolver.h"
+
+//definitions of the static constants, needed since they are passed by reference
+const uint8_t BoardSolver::CELL_UNKNOWN;
+const uint8_t BoardSolver::CELL_FLAGGED;
+const uint32_t BoardSolver::MAX_COMPONENT_CELLS;
+const uint64_t BoardSolver::MAX_SEARCH_NODES;
+
+/*
+*	Constructor
+*/
+BoardSolver::BoardSolver(uint32_t numRows, uint32_t numColumns, uint32_t numMines) {
+	rows = numRows;
+	columns = numColumns;
+	totalMines = numMines;
+	cells.assign(rows * columns, CELL_UNKNOWN);
+	results.assign(rows * columns, result_unknown);
+	probabilities.assign(rows * columns, 0.0f);
+	numbers.assign(rows * columns, constraint());
+	isQueued.assign(rows * columns, 0);
+	markedMines = 0;
+	unknownLeft = rows * columns;
+}
+
+/*
+* Function: setBoard
+*
+* Paramters: const std::vector<uint8_t> &board
+*
+* Return Type: void
+*
+* Description: Sets the tiles the solver reasons about, indexed as column + row * columns.
+*					A showing tile is its number of adjacent mines, any other tile is
+*					CELL_UNKNOWN or CELL_FLAGGED. Clears everything the solver knew and
+*					makes the constraints of the showing numbers, which are all queued
+*					for deduce().
+*
+*/
+void BoardSolver::setBoard(const std::vector<uint8_t> &board) {
+	cells = board;
+	for (uint32_t cell = 0; cell < cells.size(); cell++) {
+		results[cell] = result_unknown;
+		probabilities[cell] = 0.0f;
+		numbers[cell].cells.clear();
+		numbers[cell].mines = 0;
+		isQueued[cell] = 0;
+	}
+	queue.clear();
+	markedMines = 0;
+	unknownLeft = static_cast<uint32_t>(cells.size());
+
+	for (uint32_t cell = 0; cell < cells.size(); cell++) {
+		if (board[cell] < CELL_UNKNOWN) {
+			showCell(cell, board[cell]);
+		}
+	}
+	foundSafe.clear();
+}
+/*
+* Function: deduce
+*
+* Paramters: none
+*
+* Return Type: bool
+*
+* Description: Finds every tile that is certainly safe or certainly a mine. Repeats the
+*					following until nothing new is found:
+*					single point: a number that already touches all of its mines makes
+*						its other unknown neighbors safe, a number with as many unknown
+*						neighbors as missing mines makes them all mines
+*					subset: for two numbers A and B that share tiles, if B needs as many
+*						more mines than A as B has tiles that A does not, those tiles are
+*						mines and the tiles only A has are safe
+*					mine count: if no mines are left every unknown tile is safe, if the
+*						mines left equal the unknown tiles they are all mines
+*					Returns true if anything was found. The rules are run by propagate()
+*					on the numbers queued by setBoard(), so only the numbers around the
+*					tiles it finds are checked again instead of the whole board.
+*
+*/
+bool BoardSolver::deduce() {
+	uint32_t unknownBefore = unknownLeft;
+	propagate();
+	foundSafe.clear();
+	return unknownLeft != unknownBefore;
+}
+/*
+* Function: solve
+*
+* Paramters: none
+*
+* Return Type: void
+*
+* Description: Runs deduce() and then calculates the chance that each tile left unknown
+*					is a mine. The unknown tiles next to numbers (the frontier) are split
+*					into components that share no number, every mine layout of a component
+*					is counted by mine total, and the components are combined with the
+*					tiles away from the frontier through the number of mines left. A
+*					component too large to count gets the average of its numbers instead.
+*
+*/
+void BoardSolver::solve() {
+	deduce();
+
+	uint32_t minesLeft = totalMines;
+	for (uint32_t cell = 0; cell < cells.size(); cell++) {
+		probabilities[cell] = (results[cell] == result_mine) ? 1.0f : 0.0f;
+		if (results[cell] == result_mine && minesLeft > 0) {
+			minesLeft--;
+		}
+	}
+
+	//groups the frontier tiles into components with a union-find over the constraints
+	std::vector<constraint> constraints = buildConstraints();
+	std::vector<uint32_t> parent(cells.size());
+	for (uint32_t cell = 0; cell < cells.size(); cell++) {
+		parent[cell] = cell;
+	}
+	auto find = [&parent](uint32_t cell) {
+		while (parent[cell] != cell) {
+			parent[cell] = parent[parent[cell]];
+			cell = parent[cell];
+		}
+		return cell;
+	};
+	std::vector<bool> isFrontier(cells.size(), false);
+	for (const constraint &c : constraints) {
+		for (uint32_t cell : c.cells) {
+			isFrontier[cell] = true;
+			parent[find(cell)] = find(c.cells[0]);
+		}
+	}
+
+	std::vector<component> groups;
+	std::vector<uint32_t> groupOf(cells.size(), UINT32_MAX);
+	std::vector<uint32_t> localIndex(cells.size(), 0);
+	uint32_t interior = 0;
+	for (uint32_t cell = 0; cell < cells.size(); cell++) {
+		if (results[cell] != result_unknown) {
+			continue;
+		}
+		if (!isFrontier[cell]) {
+			interior++;
+			continue;
+		}
+		uint32_t root = find(cell);
+		if (groupOf[root] == UINT32_MAX) {
+			groupOf[root] = static_cast<uint32_t>(groups.size());
+			groups.push_back(component());
+		}
+		component &group = groups[groupOf[root]];
+		localIndex[cell] = static_cast<uint32_t>(group.cells.size());
+		group.cells.push_back(cell);
+	}
+	for (const constraint &c : constraints) {
+		constraint local;
+		local.mines = c.mines;
+		for (uint32_t cell : c.cells) {
+			local.cells.push_back(localIndex[cell]);
+		}
+		groups[groupOf[find(c.cells[0])]].constraints.push_back(local);
+	}
+
+	//counts each component, the ones too large to count are estimated and their
+	//	expected mines are taken out of the mines left
+	double estimatedMines = 0.0;
+	for (component &group : groups) {
+		countComponent(group);
+		if (!group.isExact) {
+			std::vector<double> sum(group.cells.size(), 0.0);
+			std::vector<uint32_t> count(group.cells.size(), 0);
+			for (const constraint &c : group.constraints) {
+				for (uint32_t i : c.cells) {
+					sum[i] += (double)c.mines / c.cells.size();
+					count[i]++;
+				}
+			}
+			for (uint32_t i = 0; i < group.cells.size(); i++) {
+				probabilities[group.cells[i]] = static_cast<float>(sum[i] / count[i]);
+				estimatedMines += sum[i] / count[i];
+			}
+		}
+	}
+	uint32_t remaining = static_cast<uint32_t>(std::max(0.0, std::round(minesLeft - estimatedMines)));
+
+	//weight of t mines on the counted frontier, the number of ways to put the rest in the interior
+	double maxLog = logChoose(interior, std::min(interior, remaining));
+	auto interiorWeight = [&](uint32_t t) {
+		if (t > remaining || remaining - t > interior) {
+			return 0.0;
+		}
+		return std::exp(logChoose(interior, remaining - t) - maxLog);
+	};
+
+	//the counted components are combined in two passes so each one is only convolved
+	//	once. before[i] is how many mines the components ahead of the i-th one can
+	//	hold, capped at the mines that are left since more can not fit
+	std::vector<uint32_t> exact;
+	for (uint32_t g = 0; g < groups.size(); g++) {
+		if (groups[g].isExact) {
+			exact.push_back(g);
+		}
+	}
+	uint32_t numExact = static_cast<uint32_t>(exact.size());
+	std::vector<uint32_t> before(numExact + 1, 0);
+	for (uint32_t i = 0; i < numExact; i++) {
+		before[i + 1] = std::min(remaining, before[i] + static_cast<uint32_t>(groups[exact[i]].cells.size()));
+	}
+
+	//after[i][t] is the weight of t mines in the components ahead of the i-th one, from
+	//	every way the i-th one, the ones after it and the interior can hold the rest.
+	//	Each is scaled so the largest entry is 1, the same as convolve()
+	std::vector<std::vector<double>> after(numExact + 1);
+	after[numExact].resize(before[numExact] + 1);
+	for (uint32_t t = 0; t <= before[numExact]; t++) {
+		after[numExact][t] = interiorWeight(t);
+	}
+	for (uint32_t i = numExact; i-- > 0;) {
+		const std::vector<double> &solutions = groups[exact[i]].solutions;
+		after[i].assign(before[i] + 1, 0.0);
+		double largest = 0.0;
+		for (uint32_t t = 0; t <= before[i]; t++) {
+			for (uint32_t k = 0; k < solutions.size() && t + k <= before[i + 1]; k++) {
+				after[i][t] += solutions[k] * after[i + 1][t + k];
+			}
+			largest = std::max(largest, after[i][t]);
+		}
+		if (largest > 0.0) {
+			for (double &value : after[i]) {
+				value /= largest;
+			}
+		}
+	}
+
+	//all is the distribution of the mines in the components already passed
+	std::vector<double> all = { 1.0 };
+	for (uint32_t i = 0; i < numExact; i++) {
+		const component &group = groups[exact[i]];
+
+		//weight[k] is how likely the other components and the interior make k mines in this one
+		std::vector<double> weight(group.solutions.size(), 0.0);
+		double total = 0.0;
+		for (uint32_t k = 0; k < group.solutions.size(); k++) {
+			for (uint32_t m = 0; m < all.size() && m + k <= before[i + 1]; m++) {
+				weight[k] += all[m] * after[i + 1][m + k];
+			}
+			total += group.solutions[k] * weight[k];
+		}
+		for (uint32_t c = 0; c < group.cells.size(); c++) {
+			double mine = 0.0;
+			for (uint32_t k = 0; k < group.solutions.size(); k++) {
+				mine += group.cellMines[k][c] * weight[k];
+			}
+			probabilities[group.cells[c]] = (total > 0.0) ? static_cast<float>(mine / total) : 0.5f;
+		}
+
+		all = convolve(all, group.solutions);
+		all.resize(std::min(all.size(), (size_t)before[i + 1] + 1));
+	}
+
+	//every interior tile is equally likely to be a mine
+	if (interior > 0) {
+		double mines = 0.0;
+		double total = 0.0;
+		for (uint32_t t = 0; t < all.size(); t++) {
+			double w = all[t] * interiorWeight(t);
+			total += w;
+			if (t <= remaining) {
+				mines += w * (remaining - t);
+			}
+		}
+		float interiorProbability = (total > 0.0) ? static_cast<float>(mines / (total * interior)) : (float)remaining / interior;
+		for (uint32_t cell = 0; cell < cells.size(); cell++) {
+			if (results[cell] == result_unknown && !isFrontier[cell]) {
+				probabilities[cell] = interiorProbability;
+			}
+		}
+	}
+}
+
+/*
+* Function: getHint
+*
+* Paramters: none
+*
+* Return Type: BoardSolver::Hint
+*
+* Description: Suggests the next move after solve(), a tile that is certainly safe if
+*					there is one, otherwise a tile that is certainly a mine and not flagged,
+*					otherwise the unknown tile least likely to be a mine as a guess.
+*
+*/
+BoardSolver::Hint BoardSolver::getHint() const {
+	Hint hint = { false, 0, false, false, 1.0f };
+	for (uint32_t cell = 0; cell < cells.size(); cell++) {
+		if (cells[cell] == CELL_UNKNOWN && results[cell] == result_safe) {
+			hint = { true, cell, false, false, 0.0f };
+			return hint;
+		}
+	}
+	for (uint32_t cell = 0; cell < cells.size(); cell++) {
+		if (cells[cell] == CELL_UNKNOWN && results[cell] == result_mine) {
+			hint = { true, cell, true, false, 1.0f };
+			return hint;
+		}
+	}
+	for (uint32_t cell = 0; cell < cells.size(); cell++) {
+		if (cells[cell] == CELL_UNKNOWN && results[cell] == result_unknown && probabilities[cell] < hint.mineProbability) {
+			hint = { true, cell, false, true, probabilities[cell] };
+		}
+	}
+	return hint;
+}
+
+/*
+* The next two functions are generic accessor functions for the results of solve()
+*
+*/
+BoardSolver::cell_result BoardSolver::getResult(uint32_t cell) const {
+	return static_cast<cell_result>(results[cell]);
+}
+
+float BoardSolver::getMineProbability(uint32_t cell) const {
+	return probabilities[cell];
+}
+
+/*
+* Function: isNoGuess
+*
+* Paramters: uint32_t numRows,
+*			 uint32_t numColumns,
+*			 uint32_t numMines,
+*			 const std::vector<uint8_t> &values,
+*			 uint32_t firstCell
+*
+* Return Type: bool
+*
+* Description: Checks the quality of a generated board, values is the whole board
+*					(>= 10 for a mine, otherwise the adjacent mines). Plays the board from
+*					firstCell only revealing tiles that the same rules as deduce() prove
+*					safe, and returns true if every tile that is not a mine can be revealed
+*					that way. The constraints are kept between moves and only the numbers
+*					around newly known tiles are checked again, so a board costs time in
+*					proportion to its size instead of its size squared.
+*
+*/
+bool BoardSolver::isNoGuess(uint32_t numRows, uint32_t numColumns, uint32_t numMines, const std::vector<uint8_t> &values, uint32_t firstCell) {
+	if (values[firstCell] >= 10) {
+		return false;
+	}
+	BoardSolver solver(numRows, numColumns, numMines);
+	uint32_t safeLeft = static_cast<uint32_t>(values.size()) - numMines;
+
+	//reveals a tile and every tile connected to it through blank tiles
+	std::vector<uint32_t> stack;
+	auto reveal = [&](uint32_t start) {
+		stack.push_back(start);
+		while (!stack.empty()) {
+			uint32_t cell = stack.back();
+			stack.pop_back();
+			if (solver.cells[cell] != CELL_UNKNOWN || values[cell] >= 10) {
+				continue;
+			}
+			solver.showCell(cell, values[cell]);
+			safeLeft--;
+			if (values[cell] == 0) {
+				uint32_t neighbors[8];
+				uint32_t count = solver.getNeighbors(cell, neighbors);
+				stack.insert(stack.end(), neighbors, neighbors + count);
+			}
+		}
+	};
+
+	reveal(firstCell);
+	std::vector<uint32_t> found;
+	while (safeLeft > 0) {
+		solver.propagate();
+		if (solver.foundSafe.empty()) {
+			return false;
+		}
+
+		found.swap(solver.foundSafe);
+		for (uint32_t cell : found) {
+			reveal(cell);
+		}
+		found.clear();
+	}
+	return true;
+}
+
+//************************************************
+//END OF PUBLIC METHODS, START OF PRIVATE METHODS*
+//************************************************
+
+/*
+* Function: buildConstraints
+*
+* Paramters: none
+*
+* Return Type: std::vector<BoardSolver::constraint>
+*
+* Description: Makes a constraint for every showing number that touches an unknown tile,
+*					the tiles already known to be mines are taken out of the number.
+*					Numbers with the same unknown tiles only make one constraint.
+*
+*/
+std::vector<BoardSolver::constraint> BoardSolver::buildConstraints() const {
+	std::vector<constraint> constraints;
+	uint32_t neighbors[8];
+	for (uint32_t cell = 0; cell < cells.size(); cell++) {
+		if (cells[cell] >= CELL_UNKNOWN || cells[cell] == 0) {
+			continue;
+		}
+		constraint c;
+		c.mines = cells[cell];
+		uint32_t count = getNeighbors(cell, neighbors);
+		for (uint32_t i = 0; i < count; i++) {
+			if (results[neighbors[i]] == result_mine) {
+				c.mines--;
+			}
+			else if (results[neighbors[i]] == result_unknown) {
+				c.cells.push_back(neighbors[i]);
+			}
+		}
+		if (!c.cells.empty()) {
+			constraints.push_back(c);
+		}
+	}
+
+	std::sort(constraints.begin(), constraints.end(), [](const constraint &a, const constraint &b) {
+		return a.cells < b.cells;
+	});
+	constraints.erase(std::unique(constraints.begin(), constraints.end(), [](const constraint &a, const constraint &b) {
+		return a.cells == b.cells;
+	}), constraints.end());
+	return constraints;
+}
+/*
+* Function: getNeighbors
+*
+* Paramters: uint32_t cell,
+*			 uint32_t neighbors[8]
+*
+* Return Type: uint32_t
+*
+* Description: Fills neighbors with the tiles around cell in ascending order and
+*					returns how many there are
+*
+*/
+uint32_t BoardSolver::getNeighbors(uint32_t cell, uint32_t neighbors[8]) const {
+	uint32_t row = cell / columns;
+	uint32_t column = cell % columns;
+	uint32_t count = 0;
+	for (uint32_t r = (row == 0) ? 0 : row - 1; r <= row + 1 && r < rows; r++) {
+		for (uint32_t c = (column == 0) ? 0 : column - 1; c <= column + 1 && c < columns; c++) {
+			if (r != row || c != column) {
+				neighbors[count++] = c + r * columns;
+			}
+		}
+	}
+	return count;
+}
+/*
+* Function: showCell
+*
+* Paramters: uint32_t cell,
+*			 uint8_t value
+*
+* Return Type: void
+*
+* Description: Shows a tile for setBoard() and isNoGuess() and makes the constraint of its number out of
+*					the neighbors that are still unknown, then queues it to be checked
+*
+*/
+void BoardSolver::showCell(uint32_t cell, uint8_t value) {
+	cells[cell] = value;
+	markCell(cell, result_safe);
+	if (value == 0) {
+		return;
+	}
+
+	constraint &c = numbers[cell];
+	c.mines = value;
+	c.cells.clear();
+	uint32_t neighbors[8];
+	uint32_t count = getNeighbors(cell, neighbors);
+	for (uint32_t i = 0; i < count; i++) {
+		if (results[neighbors[i]] == result_mine) {
+			c.mines--;
+		}
+		else if (results[neighbors[i]] == result_unknown) {
+			c.cells.push_back(neighbors[i]);
+		}
+	}
+	if (!isQueued[cell]) {
+		isQueued[cell] = 1;
+		queue.push_back(cell);
+	}
+}
+/*
+* Function: markCell
+*
+* Paramters: uint32_t cell,
+*			 cell_result result
+*
+* Return Type: void
+*
+* Description: Sets the result of an unknown tile for propagate(), takes it out of the
+*					constraints of the numbers around it and queues those numbers. A safe
+*					tile is added to foundSafe so it can be revealed.
+*
+*/
+void BoardSolver::markCell(uint32_t cell, cell_result result) {
+	if (results[cell] != result_unknown) {
+		return;
+	}
+	results[cell] = result;
+	unknownLeft--;
+	if (result == result_mine) {
+		markedMines++;
+	}
+	else {
+		foundSafe.push_back(cell);
+	}
+
+	uint32_t neighbors[8];
+	uint32_t count = getNeighbors(cell, neighbors);
+	for (uint32_t i = 0; i < count; i++) {
+		constraint &c = numbers[neighbors[i]];
+		std::vector<uint32_t>::iterator it = std::lower_bound(c.cells.begin(), c.cells.end(), cell);
+		if (it == c.cells.end() || *it != cell) {
+			continue;
+		}
+		c.cells.erase(it);
+		if (result == result_mine) {
+			c.mines--;
+		}
+		if (!isQueued[neighbors[i]]) {
+			isQueued[neighbors[i]] = 1;
+			queue.push_back(neighbors[i]);
+		}
+	}
+}
+/*
+* Function: propagate
+*
+* Paramters: none
+*
+* Return Type: void
+*
+* Description: Runs the rules of deduce() for it and isNoGuess(). Checks each queued
+*					number with the single point rule and with the subset rule against the
+*					numbers close enough to share a tile, every tile it finds queues the
+*					numbers around it again. When the queue is empty the mine count rule is
+*					tried on the counts kept by markCell().
+*
+*/
+void BoardSolver::propagate() {
+	std::vector<uint32_t> targets, onlyA, onlyB;
+	while (true) {
+		while (!queue.empty()) {
+			uint32_t a = queue.back();
+			queue.pop_back();
+			isQueued[a] = 0;
+			const constraint &A = numbers[a];
+			if (A.cells.empty()) {
+				continue;
+			}
+			if (A.mines == 0 || A.mines == (int)A.cells.size()) {
+				targets = A.cells;
+				cell_result result = (A.mines == 0) ? result_safe : result_mine;
+				for (uint32_t cell : targets) {
+					markCell(cell, result);
+				}
+				continue;
+			}
+
+			//two numbers can only share a tile if they are at most two tiles apart
+			uint32_t row = a / columns;
+			uint32_t column = a % columns;
+			bool isChanged = false;
+			for (uint32_t r = (row < 2) ? 0 : row - 2; r <= row + 2 && r < rows && !isChanged; r++) {
+				for (uint32_t c = (column < 2) ? 0 : column - 2; c <= column + 2 && c < columns && !isChanged; c++) {
+					uint32_t b = c + r * columns;
+					const constraint &B = numbers[b];
+					if (b == a || B.cells.empty()) {
+						continue;
+					}
+					onlyA.clear();
+					onlyB.clear();
+					std::set_difference(A.cells.begin(), A.cells.end(), B.cells.begin(), B.cells.end(), std::back_inserter(onlyA));
+					std::set_difference(B.cells.begin(), B.cells.end(), A.cells.begin(), A.cells.end(), std::back_inserter(onlyB));
+					//numbers that share no tile, or the same tiles, can not show anything new
+					if (onlyB.size() == B.cells.size() || (onlyA.empty() && onlyB.empty())) {
+						continue;
+					}
+					if (B.mines - A.mines == (int)onlyB.size()) {
+						isChanged = true;
+					}
+					else if (A.mines - B.mines == (int)onlyA.size()) {
+						onlyA.swap(onlyB);
+						isChanged = true;
+					}
+					if (isChanged) {
+						//A and B change under the marks, so the number is queued again by markCell().
+						//	If only tiles of B were marked A is queued here, the numbers after B
+						//	were not compared with it yet
+						for (uint32_t cell : onlyB) {
+							markCell(cell, result_mine);
+						}
+						for (uint32_t cell : onlyA) {
+							markCell(cell, result_safe);
+						}
+						if (!isQueued[a]) {
+							isQueued[a] = 1;
+							queue.push_back(a);
+						}
+					}
+				}
+			}
+		}
+
+		if (unknownLeft == 0 || markedMines > totalMines) {
+			return;
+		}
+		cell_result result;
+		if (markedMines == totalMines) {
+			result = result_safe;
+		}
+		else if (totalMines - markedMines == unknownLeft) {
+			result = result_mine;
+		}
+		else {
+			return;
+		}
+		for (uint32_t cell = 0; cell < cells.size(); cell++) {
+			markCell(cell, result);
+		}
+	}
+}
+/*
+* Function: countComponent
+*
+* Paramters: component &group
+*
+* Return Type: void
+*
+* Description: Counts every mine layout of the component that fits all of its constraints
+*					with a backtracking search, the tiles are tried in the order they were
+*					found so that the constraints are checked as early as possible. Gives up
+*					and marks the component as not exact if it is too large.
+*
+*/
+void BoardSolver::countComponent(component &group) const {
+	uint32_t size = static_cast<uint32_t>(group.cells.size());
+	group.isExact = false;
+	group.solutions.assign(size + 1, 0.0);
+	group.cellMines.assign(size + 1, std::vector<double>(size, 0.0));
+	if (size > MAX_COMPONENT_CELLS) {
+		return;
+	}
+
+	//the constraints of each tile, and how many mines and unset tiles each constraint has
+	std::vector<std::vector<uint32_t>> tileConstraints(size);
+	for (uint32_t i = 0; i < group.constraints.size(); i++) {
+		for (uint32_t cell : group.constraints[i].cells) {
+			tileConstraints[cell].push_back(i);
+		}
+	}
+
+	struct search {
+		component &group;
+		const std::vector<std::vector<uint32_t>> &tileConstraints;
+		std::vector<int> mines;
+		std::vector<int> unset;
+		std::vector<uint8_t> layout;
+		uint64_t nodes;
+
+		bool run(uint32_t tile, uint32_t mineCount) {
+			if (++nodes > MAX_SEARCH_NODES) {
+				return false;
+			}
+			if (tile == layout.size()) {
+				group.solutions[mineCount] += 1.0;
+				for (uint32_t i = 0; i < layout.size(); i++) {
+					group.cellMines[mineCount][i] += layout[i];
+				}
+				return true;
+			}
+			for (uint8_t value = 0; value < 2; value++) {
+				bool isValid = true;
+				for (uint32_t c : tileConstraints[tile]) {
+					mines[c] += value;
+					unset[c]--;
+					if (mines[c] > group.constraints[c].mines || mines[c] + unset[c] < group.constraints[c].mines) {
+						isValid = false;
+					}
+				}
+				layout[tile] = value;
+				bool isDone = !isValid || run(tile + 1, mineCount + value);
+				for (uint32_t c : tileConstraints[tile]) {
+					mines[c] -= value;
+					unset[c]++;
+				}
+				if (!isDone) {
+					return false;
+				}
+			}
+			return true;
+		}
+	};
+
+	search counter = { group, tileConstraints, std::vector<int>(group.constraints.size(), 0), std::vector<int>(group.constraints.size(), 0), std::vector<uint8_t>(size, 0), 0 };
+	for (uint32_t i = 0; i < group.constraints.size(); i++) {
+		counter.unset[i] = static_cast<int>(group.constraints[i].cells.size());
+	}
+	group.isExact = counter.run(0, 0);
+}
+/*
+* Function: convolve
+*
+* Paramters: const std::vector<double> &a,
+*			 const std::vector<double> &b
+*
+* Return Type: std::vector<double>
+*
+* Description: Returns the distribution of the mine total of two independent components,
+*					scaled so the largest entry is 1 to keep large boards from overflowing
+*
+*/
+std::vector<double> BoardSolver::convolve(const std::vector<double> &a, const std::vector<double> &b) {
+	std::vector<double> result(a.size() + b.size() - 1, 0.0);
+	double largest = 0.0;
+	for (uint32_t i = 0; i < a.size(); i++) {
+		for (uint32_t j = 0; j < b.size(); j++) {
+			result[i + j] += a[i] * b[j];
+		}
+	}
+	for (double value : result) {
+		largest = std::max(largest, value);
+	}
+	if (largest > 0.0) {
+		for (double &value : result) {
+			value /= largest;
+		}
+	}
+	return result;
+}
+//returns the log of n choose k
+double BoardSolver::logChoose(uint32_t n, uint32_t k) {
+	return std::lgamma(n + 1.0) - std::lgamma(k + 1.0) - std::lgamma(n - k + 1.0);
+}
@@ -0,0 +1,105 @@
+/*
+* TITLE:	Multi-threaded Minesweeper
+* BY:		Eric Hollas
+*
+* FILE:		BoardSolver.h
+* DETAILS:	This file defines the solver that reasons about a board the way a player
+*				does, only using the tiles that are showing. It finds the tiles that are
+*				certainly safe or certainly mines with single point deductions and by
+*				comparing the constraints of neighboring number tiles (subset reasoning).
+*				When nothing is certain it estimates the chance that each unknown tile is
+*				a mine by splitting the frontier into independent groups, counting the
+*				mine layouts of each group and combining them with the total mine count.
+*			It is used for the hint API of the TileManager and to check if a board can
+*				be won from the first click without guessing.
+*/
+
+#pragma once
+#include "stdafx.h"
+#include <cmath>
+#include <iterator>
+
+class BoardSolver {
+public:
+	// the value of a tile in the board passed to setBoard() that is not showing,
+	//	showing tiles are passed as their number of adjacent mines (0 to 8)
+	static const uint8_t CELL_UNKNOWN = 9;
+	// a tile the player flagged, it is reasoned about the same as an unknown tile since
+	//	the flag may be wrong, but a hint never suggests a flagged tile
+	static const uint8_t CELL_FLAGGED = 10;
+
+	// what the solver knows about a tile after solve()
+	enum cell_result : uint8_t {
+		result_unknown,
+		result_safe,
+		result_mine
+	};
+
+	// the move suggested by getHint()
+	struct Hint {
+		bool found;				//false if every tile is already showing
+		uint32_t cell;			//column + row * columns
+		bool isMine;			//true if the tile is certainly a mine and should be flagged
+		bool isGuess;			//true if no tile is certain, cell is the tile least likely to be a mine
+		float mineProbability;
+	};
+
+	BoardSolver(uint32_t numRows, uint32_t numColumns, uint32_t numMines);
+
+	void setBoard(const std::vector<uint8_t> &board);
+	bool deduce();
+	void solve();
+
+	Hint getHint() const;
+	cell_result getResult(uint32_t cell) const;
+	float getMineProbability(uint32_t cell) const;
+
+	static bool isNoGuess(uint32_t numRows, uint32_t numColumns, uint32_t numMines, const std::vector<uint8_t> &values, uint32_t firstCell);
+
+private:
+	// the number of mines among a set of unknown tiles, the tiles are kept sorted
+	struct constraint {
+		std::vector<uint32_t> cells;
+		int mines;
+	};
+
+	uint32_t rows;
+	uint32_t columns;
+	uint32_t totalMines;
+
+	std::vector<uint8_t> cells;
+	std::vector<uint8_t> results;
+	std::vector<float> probabilities;
+
+	// a group of frontier tiles that share constraints, it can be counted on its own
+	struct component {
+		std::vector<uint32_t> cells;
+		std::vector<constraint> constraints;	//the cells are indices into cells above
+		std::vector<double> solutions;			//solutions[k] is the number of layouts with k mines
+		std::vector<std::vector<double>> cellMines;	//cellMines[k][i] is how many of them have a mine on cells[i]
+		bool isExact;							//false if the component was too large to count
+	};
+
+	// the state kept by deduce() and isNoGuess() between moves, numbers[cell] is the
+	//	constraint of a showing number and only changes when one of its tiles becomes
+	//	known, the numbers that changed wait in queue to be checked again
+	std::vector<constraint> numbers;
+	std::vector<uint32_t> queue;
+	std::vector<uint8_t> isQueued;
+	std::vector<uint32_t> foundSafe;
+	uint32_t markedMines;
+	uint32_t unknownLeft;
+
+	// the limits on counting a component, larger components get an estimate instead
+	static const uint32_t MAX_COMPONENT_CELLS = 48;
+	static const uint64_t MAX_SEARCH_NODES = 1000000;
+
+	std::vector<constraint> buildConstraints() const;
+	uint32_t getNeighbors(uint32_t cell, uint32_t neighbors[8]) const;
+	void showCell(uint32_t cell, uint8_t value);
+	void markCell(uint32_t cell, cell_result result);
+	void propagate();
+	void countComponent(component &group) const;
+	static std::vector<double> convolve(const std::vector<double> &a, const std::vector<double> &b);
+	static double logChoose(uint32_t n, uint32_t k);
+};
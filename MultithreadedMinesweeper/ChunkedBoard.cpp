@@ -0,0 +1,370 @@
+#include "stdafx.h"
+#include "ChunkedBoard.h"
+
+//definitions of the static constants, needed since they are passed by reference
+const int32_t ChunkedBoard::CHUNK_SIZE;
+const uint32_t ChunkedBoard::CHUNK_CELLS;
+const uint32_t ChunkedBoard::MAX_FLOOD_TILES;
+
+/*
+*	Constructor
+*
+*	every chunk has exactly minesPerChunk mines, less the ones kept off the first click
+*/
+ChunkedBoard::ChunkedBoard(uint64_t seed, uint32_t minesPerChunk) {
+	board_seed = seed;
+	mines_per_chunk = std::min(minesPerChunk, CHUNK_CELLS);
+	isStarted = false;
+	safe_tile = { 0, 0 };
+	num_of_active = 0;
+}
+
+/*
+* Function: reveal
+*
+* Paramters: int64_t x,
+*			 int64_t y,
+*			 std::vector<Tile> &revealed
+*
+* Return Type: bool
+*
+* Description: Reveals the tile and, if it is blank, every tile connected to it through
+*					blank tiles, up to MAX_FLOOD_TILES tiles. The tiles revealed are added
+*					to revealed. The first reveal of the board sets the tile that is kept
+*					clear of mines. Returns true if the tile was a mine.
+*
+*/
+bool ChunkedBoard::reveal(int64_t x, int64_t y, std::vector<Tile> &revealed) {
+	if (!isStarted) {
+		isStarted = true;
+		safe_tile = { x, y };
+	}
+
+	std::vector<Tile> stack(1, Tile{ x, y });
+	uint32_t flooded = 0;
+	while (!stack.empty() && flooded < MAX_FLOOD_TILES) {
+		Tile tile = stack.back();
+		stack.pop_back();
+
+		int64_t chunkX = floorDivide(tile.x);
+		int64_t chunkY = floorDivide(tile.y);
+		chunk &target = getChunk(chunkX, chunkY);
+		uint32_t cell = static_cast<uint32_t>((tile.x - chunkX * CHUNK_SIZE) + (tile.y - chunkY * CHUNK_SIZE) * CHUNK_SIZE);
+		if (getState(target, cell) != tile_unshown) {
+			continue;
+		}
+		setState(target, cell, tile_showing);
+		revealed.push_back(tile);
+		flooded++;
+
+		if (target.values[cell] >= 10) {
+			return true;
+		}
+		if (target.values[cell] == 0) {
+			for (int64_t dy = -1; dy <= 1; dy++) {
+				for (int64_t dx = -1; dx <= 1; dx++) {
+					if (dx != 0 || dy != 0) {
+						stack.push_back(Tile{ tile.x + dx, tile.y + dy });
+					}
+				}
+			}
+		}
+	}
+	return false;
+}
+/*
+* Function: toggleFlag
+*
+* Paramters: int64_t x,
+*			 int64_t y
+*
+* Return Type: void
+*
+* Description: flags an unshown tile or unflags a flagged tile, the chunk is not
+*					generated since a flag does not need the mines
+*
+*/
+void ChunkedBoard::toggleFlag(int64_t x, int64_t y) {
+	int64_t chunkX = floorDivide(x);
+	int64_t chunkY = floorDivide(y);
+	chunk &target = chunks[getKey(chunkX, chunkY)];
+	uint32_t cell = static_cast<uint32_t>((x - chunkX * CHUNK_SIZE) + (y - chunkY * CHUNK_SIZE) * CHUNK_SIZE);
+	tile_state state = getState(target, cell);
+	if (state == tile_unshown) {
+		setState(target, cell, tile_flagged);
+	}
+	else if (state == tile_flagged) {
+		setState(target, cell, tile_unshown);
+	}
+	if (target.numOfTouched == 0 && target.values.empty()) {
+		chunks.erase(getKey(chunkX, chunkY));
+	}
+}
+/*
+* Function: getState
+*
+* Paramters: int64_t x,
+*			 int64_t y
+*
+* Return Type: ChunkedBoard::tile_state
+*
+* Description: returns what the player sees of a tile, a tile of a chunk that was
+*					never stored is unshown
+*
+*/
+ChunkedBoard::tile_state ChunkedBoard::getState(int64_t x, int64_t y) const {
+	int64_t chunkX = floorDivide(x);
+	int64_t chunkY = floorDivide(y);
+	std::unordered_map<uint64_t, chunk>::const_iterator it = chunks.find(getKey(chunkX, chunkY));
+	if (it == chunks.end()) {
+		return tile_unshown;
+	}
+	return getState(it->second, static_cast<uint32_t>((x - chunkX * CHUNK_SIZE) + (y - chunkY * CHUNK_SIZE) * CHUNK_SIZE));
+}
+/*
+* Function: getValue
+*
+* Paramters: int64_t x,
+*			 int64_t y
+*
+* Return Type: uint8_t
+*
+* Description: returns the value of a tile, >= 10 for a mine, otherwise the number of
+*					adjacent mines. Generates the chunk of the tile if it is not active.
+*					Every tile is 0 until the first tile has been revealed.
+*
+*/
+uint8_t ChunkedBoard::getValue(int64_t x, int64_t y) {
+	if (!isStarted) {
+		return 0;
+	}
+	int64_t chunkX = floorDivide(x);
+	int64_t chunkY = floorDivide(y);
+	return getChunk(chunkX, chunkY).values[(x - chunkX * CHUNK_SIZE) + (y - chunkY * CHUNK_SIZE) * CHUNK_SIZE];
+}
+
+/*
+* Function: viewRegion
+*
+* Paramters: int64_t minX,
+*			 int64_t minY,
+*			 int64_t maxX,
+*			 int64_t maxY
+*
+* Return Type: void
+*
+* Description: generates every chunk that overlaps the tiles from (minX, minY) to
+*					(maxX, maxY), to be called with the tiles the camera can see so they
+*					are ready before they are drawn. Nothing is generated before the
+*					first tile has been revealed.
+*
+*/
+void ChunkedBoard::viewRegion(int64_t minX, int64_t minY, int64_t maxX, int64_t maxY) {
+	if (!isStarted) {
+		return;
+	}
+	for (int64_t chunkY = floorDivide(minY); chunkY <= floorDivide(maxY); chunkY++) {
+		for (int64_t chunkX = floorDivide(minX); chunkX <= floorDivide(maxX); chunkX++) {
+			getChunk(chunkX, chunkY);
+		}
+	}
+}
+/*
+* Function: evictOutside
+*
+* Paramters: int64_t minX,
+*			 int64_t minY,
+*			 int64_t maxX,
+*			 int64_t maxY
+*
+* Return Type: void
+*
+* Description: makes every active chunk that does not overlap the tiles from (minX, minY)
+*					to (maxX, maxY) compact, its values are dropped and only what the player
+*					sees is kept. A chunk the player never touched is removed. Called with
+*					an area somewhat larger than the view so that panning back and forth
+*					does not generate the same chunks over and over.
+*
+*/
+void ChunkedBoard::evictOutside(int64_t minX, int64_t minY, int64_t maxX, int64_t maxY) {
+	int64_t minChunkX = floorDivide(minX);
+	int64_t minChunkY = floorDivide(minY);
+	int64_t maxChunkX = floorDivide(maxX);
+	int64_t maxChunkY = floorDivide(maxY);
+
+	std::unordered_map<uint64_t, chunk>::iterator it = chunks.begin();
+	while (it != chunks.end()) {
+		int64_t chunkX = static_cast<int32_t>(it->first >> 32);
+		int64_t chunkY = static_cast<int32_t>(it->first & 0xFFFFFFFFull);
+		bool isOutside = chunkX < minChunkX || chunkX > maxChunkX || chunkY < minChunkY || chunkY > maxChunkY;
+		if (isOutside && !it->second.values.empty()) {
+			std::vector<uint8_t>().swap(it->second.values);
+			num_of_active--;
+		}
+		if (isOutside && it->second.numOfTouched == 0) {
+			it = chunks.erase(it);
+		}
+		else {
+			it++;
+		}
+	}
+}
+
+/*
+* The following functions are generic accessor methods, the memory usage is an
+*		estimate of the bytes used by the chunks and the hash map
+*
+*/
+uint64_t ChunkedBoard::getSeed() const {
+	return board_seed;
+}
+
+size_t ChunkedBoard::getNumOfActiveChunks() const {
+	return num_of_active;
+}
+
+size_t ChunkedBoard::getNumOfCompactChunks() const {
+	return chunks.size() - num_of_active;
+}
+
+size_t ChunkedBoard::getMemoryUsage() const {
+	return chunks.bucket_count() * sizeof(void*)
+		 + chunks.size() * (sizeof(chunk) + sizeof(uint64_t) + 2 * sizeof(void*))
+		 + num_of_active * CHUNK_CELLS;
+}
+
+//************************************************
+//END OF PUBLIC METHODS, START OF PRIVATE METHODS*
+//************************************************
+
+//returns the chunk at the chunk position, it is added and generated if needed
+ChunkedBoard::chunk & ChunkedBoard::getChunk(int64_t chunkX, int64_t chunkY) {
+	chunk &target = chunks[getKey(chunkX, chunkY)];
+	if (target.values.empty() && isStarted) {
+		activate(target, chunkX, chunkY);
+	}
+	return target;
+}
+/*
+* Function: activate
+*
+* Paramters: chunk &target,
+*			 int64_t chunkX,
+*			 int64_t chunkY
+*
+* Return Type: void
+*
+* Description: Generates the values of a chunk. The mines of the chunk and of the edges
+*					of its eight neighbors are gathered into one mask with a border of one
+*					tile, a neighbor that is active gives its values, the others are
+*					generated, then every tile counts the mines around it.
+*
+*/
+void ChunkedBoard::activate(chunk &target, int64_t chunkX, int64_t chunkY) {
+	const int32_t SIDE = CHUNK_SIZE + 2;
+	std::vector<uint8_t> mask(SIDE * SIDE, 0);
+	std::vector<uint8_t> mines;
+
+	for (int64_t dy = -1; dy <= 1; dy++) {
+		for (int64_t dx = -1; dx <= 1; dx++) {
+			std::unordered_map<uint64_t, chunk>::const_iterator it = chunks.find(getKey(chunkX + dx, chunkY + dy));
+			if (it != chunks.end() && !it->second.values.empty()) {
+				mines.resize(CHUNK_CELLS);
+				for (uint32_t cell = 0; cell < CHUNK_CELLS; cell++) {
+					mines[cell] = (it->second.values[cell] >= 10) ? 1 : 0;
+				}
+			}
+			else {
+				generateMines(chunkX + dx, chunkY + dy, mines);
+			}
+
+			//copies the part of the neighbor that is inside the mask
+			int32_t firstX = (dx < 0) ? CHUNK_SIZE - 1 : 0;
+			int32_t lastX = (dx > 0) ? 0 : CHUNK_SIZE - 1;
+			int32_t firstY = (dy < 0) ? CHUNK_SIZE - 1 : 0;
+			int32_t lastY = (dy > 0) ? 0 : CHUNK_SIZE - 1;
+			for (int32_t y = firstY; y <= lastY; y++) {
+				for (int32_t x = firstX; x <= lastX; x++) {
+					int32_t maskX = x + 1 + static_cast<int32_t>(dx) * CHUNK_SIZE;
+					int32_t maskY = y + 1 + static_cast<int32_t>(dy) * CHUNK_SIZE;
+					mask[maskX + maskY * SIDE] = mines[x + y * CHUNK_SIZE];
+				}
+			}
+		}
+	}
+
+	target.values.resize(CHUNK_CELLS);
+	for (int32_t y = 0; y < CHUNK_SIZE; y++) {
+		for (int32_t x = 0; x < CHUNK_SIZE; x++) {
+			const uint8_t *pCenter = &mask[(x + 1) + (y + 1) * SIDE];
+			uint8_t count = pCenter[-SIDE - 1] + pCenter[-SIDE] + pCenter[-SIDE + 1]
+						  + pCenter[-1] + pCenter[1]
+						  + pCenter[SIDE - 1] + pCenter[SIDE] + pCenter[SIDE + 1];
+			target.values[x + y * CHUNK_SIZE] = (*pCenter != 0) ? 10 + count : count;
+		}
+	}
+	num_of_active++;
+}
+/*
+* Function: generateMines
+*
+* Paramters: int64_t chunkX,
+*			 int64_t chunkY,
+*			 std::vector<uint8_t> &mines
+*
+* Return Type: void
+*
+* Description: Sets mines to 1 for every mine of the chunk and 0 otherwise. The mines are
+*					picked with a partial Fisher-Yates shuffle on the chunk's own stream of
+*					the seed, skipping the tiles next to the first revealed tile, so the
+*					chunk is the same every time it is generated.
+*
+*/
+void ChunkedBoard::generateMines(int64_t chunkX, int64_t chunkY, std::vector<uint8_t> &mines) const {
+	mines.assign(CHUNK_CELLS, 0);
+
+	std::vector<uint32_t> open;
+	open.reserve(CHUNK_CELLS);
+	for (uint32_t cell = 0; cell < CHUNK_CELLS; cell++) {
+		int64_t x = chunkX * CHUNK_SIZE + (cell % CHUNK_SIZE);
+		int64_t y = chunkY * CHUNK_SIZE + (cell / CHUNK_SIZE);
+		if (x + 1 < safe_tile.x || x > safe_tile.x + 1 || y + 1 < safe_tile.y || y > safe_tile.y + 1) {
+			open.push_back(cell);
+		}
+	}
+
+	RandomStream stream(board_seed, getKey(chunkX, chunkY));
+	uint32_t count = std::min(mines_per_chunk, static_cast<uint32_t>(open.size()));
+	for (uint32_t i = 0; i < count; i++) {
+		uint32_t pick = i + stream.nextBelow(static_cast<uint32_t>(open.size()) - i);
+		std::swap(open[i], open[pick]);
+		mines[open[i]] = 1;
+	}
+}
+//sets the state of a tile and keeps count of the tiles that are not unshown
+void ChunkedBoard::setState(chunk &target, uint32_t cell, tile_state state) {
+	tile_state previous = getState(target, cell);
+	if (previous == tile_unshown && state != tile_unshown) {
+		target.numOfTouched++;
+	}
+	else if (previous != tile_unshown && state == tile_unshown) {
+		target.numOfTouched--;
+	}
+	uint32_t shift = (cell & 3) * 2;
+	target.visibility[cell >> 2] = static_cast<uint8_t>((target.visibility[cell >> 2] & ~(3 << shift)) | (state << shift));
+}
+
+//returns the chunk position of a tile position, rounding down for negative positions
+int64_t ChunkedBoard::floorDivide(int64_t value) {
+	return (value >= 0) ? value / CHUNK_SIZE : -((-value - 1) / CHUNK_SIZE) - 1;
+}
+
+//packs a chunk position into the key of the hash map
+uint64_t ChunkedBoard::getKey(int64_t chunkX, int64_t chunkY) {
+	return (static_cast<uint64_t>(static_cast<uint32_t>(chunkX)) << 32) | static_cast<uint32_t>(chunkY);
+}
+
+//returns the state of a tile of a chunk
+ChunkedBoard::tile_state ChunkedBoard::getState(const chunk &target, uint32_t cell) {
+	return static_cast<tile_state>((target.visibility[cell >> 2] >> ((cell & 3) * 2)) & 3);
+}
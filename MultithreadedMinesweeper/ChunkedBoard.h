@@ -0,0 +1,87 @@
+/*
+* TITLE:	Multi-threaded Minesweeper
+* BY:		Eric Hollas
+*
+* FILE:		ChunkedBoard.h
+* DETAILS:	This file defines a board without edges. The board is split into chunks of
+*				CHUNK_SIZE x CHUNK_SIZE tiles kept in a hash map by chunk position, so
+*				only the chunks that have been seen use memory. The mines of a chunk are
+*				a function of the seed and the chunk position (see RandomStream.h), a
+*				chunk is only generated when one of its tiles is revealed or viewed and
+*				generates the same no matter when or in what order that happens.
+*			A chunk is either active or compact. An active chunk keeps the value of each
+*				tile (>= 10 for a mine, the same as the TileManager) and two bits per tile
+*				for what the player sees. Evicting a chunk that is far from the camera
+*				drops its values since they can be generated again, a compact chunk that
+*				the player never touched is removed completely. Memory is proportional to
+*				the area explored and viewed, not to the size of the board.
+*			The first revealed tile and its neighbors are never mines, the same as the
+*				board of the TileManager.
+*/
+
+#pragma once
+#include "stdafx.h"
+#include "RandomStream.h"
+#include <unordered_map>
+
+class ChunkedBoard {
+public:
+	static const int32_t CHUNK_SIZE = 64;
+	static const uint32_t CHUNK_CELLS = CHUNK_SIZE * CHUNK_SIZE;
+
+	// the largest number of tiles a single reveal floods, a board with very few mines
+	//	can have blank areas without an end
+	static const uint32_t MAX_FLOOD_TILES = 1 << 20;
+
+	// what the player sees of a tile, the same values as TileManager::gameboard_isShowing
+	enum tile_state : uint8_t {
+		tile_unshown,
+		tile_flagged,
+		tile_showing
+	};
+
+	// a tile position, x is the column and y is the row
+	struct Tile {
+		int64_t x;
+		int64_t y;
+	};
+
+	ChunkedBoard(uint64_t seed, uint32_t minesPerChunk);
+
+	bool reveal(int64_t x, int64_t y, std::vector<Tile> &revealed);
+	void toggleFlag(int64_t x, int64_t y);
+	tile_state getState(int64_t x, int64_t y) const;
+	uint8_t getValue(int64_t x, int64_t y);
+
+	void viewRegion(int64_t minX, int64_t minY, int64_t maxX, int64_t maxY);
+	void evictOutside(int64_t minX, int64_t minY, int64_t maxX, int64_t maxY);
+
+	uint64_t getSeed() const;
+	size_t getNumOfActiveChunks() const;
+	size_t getNumOfCompactChunks() const;
+	size_t getMemoryUsage() const;
+
+private:
+	struct chunk {
+		uint8_t visibility[CHUNK_CELLS / 4];	//2 bits per tile, tile n is bits 2 * (n % 4) of byte n / 4
+		std::vector<uint8_t> values;			//CHUNK_CELLS values if active, empty if compact
+		uint32_t numOfTouched;					//the tiles that are not unshown
+	};
+
+	uint64_t board_seed;
+	uint32_t mines_per_chunk;
+	bool isStarted;
+	Tile safe_tile;
+	size_t num_of_active;
+
+	std::unordered_map<uint64_t, chunk> chunks;
+
+	chunk & getChunk(int64_t chunkX, int64_t chunkY);
+	void activate(chunk &target, int64_t chunkX, int64_t chunkY);
+	void generateMines(int64_t chunkX, int64_t chunkY, std::vector<uint8_t> &mines) const;
+	void setState(chunk &target, uint32_t cell, tile_state state);
+
+	static int64_t floorDivide(int64_t value);
+	static uint64_t getKey(int64_t chunkX, int64_t chunkY);
+	static tile_state getState(const chunk &target, uint32_t cell);
+};
@@ -0,0 +1,328 @@
+#include "stdafx.h"
+#include "HeadlessDriver.h"
+#include <iomanip>
+
+
+/*
+*	Constructor
+*/
+HeadlessDriver::HeadlessDriver() {
+	board.setNoGuess(false);
+}
+
+/*
+* The next two functions set how the boards of the next games are generated,
+*		see TileManager::setGenerationThreads() and TileManager::setNoGuess()
+*
+*/
+void HeadlessDriver::setGenerationThreads(uint32_t threads) {
+	board.setGenerationThreads(threads);
+}
+
+void HeadlessDriver::setNoGuess(bool isEnabled) {
+	board.setNoGuess(isEnabled);
+}
+
+/*
+* Function: playScript
+*
+* Paramters: uint64_t seed,
+*			 const std::vector<ScriptedClick> &script,
+*			 GameStats &stats
+*
+* Return Type: void
+*
+* Description: Plays a new game of the seed with the clicks of the script in order. The
+*					game stops early if a mine is clicked. It only counts as a win if
+*					the script showed every tile that is not a mine. The results are
+*					added to stats.
+*
+*/
+void HeadlessDriver::playScript(uint64_t seed, const std::vector<ScriptedClick> &script, GameStats &stats) {
+	startGame(seed, stats);
+	for (const ScriptedClick &next : script) {
+		if (click(next.row, next.column, next.isLeftClick, true, stats)) {
+			return;
+		}
+	}
+	if (board.isWon()) {
+		stats.wins++;
+	}
+}
+/*
+* Function: playRandomGame
+*
+* Paramters: uint64_t seed,
+*			 GameStats &stats
+*
+* Return Type: void
+*
+* Description: Plays a new game of the seed by left clicking the tiles that are not
+*					showing in a random order until the game is won. The mines are read
+*					from the board once the first click has generated it and are never
+*					clicked, so every game plays to the end. The order comes from the
+*					seed so a game can be repeated. The results are added to stats.
+*
+*/
+void HeadlessDriver::playRandomGame(uint64_t seed, GameStats &stats) {
+	//the order uses a stream of the seed that the board does not use
+	RandomStream stream(seed, UINT32_MAX);
+	uint32_t order[GAMEBOARD_ROWS * GAMEBOARD_COLUMNS];
+	for (uint32_t i = 0; i < GAMEBOARD_ROWS * GAMEBOARD_COLUMNS; i++) {
+		order[i] = i;
+	}
+
+	startGame(seed, stats);
+	std::vector<bool> isMine(GAMEBOARD_ROWS * GAMEBOARD_COLUMNS, false);
+	for (uint32_t i = 0; i < GAMEBOARD_ROWS * GAMEBOARD_COLUMNS && !board.isWon(); i++) {
+		uint32_t pick = i + stream.nextBelow(GAMEBOARD_ROWS * GAMEBOARD_COLUMNS - i);
+		std::swap(order[i], order[pick]);
+		uint32_t row = order[i] / GAMEBOARD_COLUMNS;
+		uint32_t column = order[i] % GAMEBOARD_COLUMNS;
+		if (isMine[order[i]]) {
+			continue;
+		}
+		if (!board.isTileShowing(row, column) && click(row, column, true, true, stats)) {
+			return;
+		}
+		//the first click is never a mine and generates the board
+		if (i == 0) {
+			BoardSnapshot snapshot = board.takeSnapshot();
+			for (uint32_t cell = 0; cell < isMine.size(); cell++) {
+				isMine[cell] = snapshot.isMine(cell);
+			}
+		}
+	}
+	if (board.isWon()) {
+		stats.wins++;
+	}
+}
+/*
+* Function: runBenchmark
+*
+* Paramters: uint32_t gamesPerRun,
+*			 std::ostream &out
+*
+* Return Type: void
+*
+* Description: Plays gamesPerRun random games for every generation thread count from 1
+*					up to the number of hardware threads, with and without no-guess boards,
+*					and writes one line of results per run to out. The seeds are the same
+*					for every run so the runs play the same games.
+*				The size of the board is set at compile time in TileManager.h, so other
+*					sizes are benchmarked by building with other GAMEBOARD_ROWS and
+*					GAMEBOARD_COLUMNS.
+*
+*/
+void HeadlessDriver::runBenchmark(uint32_t gamesPerRun, std::ostream &out) {
+	std::vector<uint32_t> threadCounts;
+	uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+	for (uint32_t threads = 1; threads < maxThreads; threads *= 2) {
+		threadCounts.push_back(threads);
+	}
+	threadCounts.push_back(maxThreads);
+
+	out << "board " << GAMEBOARD_ROWS << "x" << GAMEBOARD_COLUMNS << ", " << NUM_OF_MINES << " mines, "
+		<< gamesPerRun << " random games per run" << std::endl;
+	out << std::fixed << std::setprecision(1);
+
+	for (uint32_t noGuess = 0; noGuess < 2; noGuess++) {
+		for (uint32_t threads : threadCounts) {
+			setGenerationThreads(threads);
+			setNoGuess(noGuess != 0);
+
+			GameStats stats = { 0, 0, 0, 0.0, 0.0, std::vector<double>() };
+			for (uint32_t game = 0; game < gamesPerRun; game++) {
+				playRandomGame(game + 1, stats);
+			}
+			std::sort(stats.revealMicroseconds.begin(), stats.revealMicroseconds.end());
+
+			out << "threads " << std::setw(2) << threads << ((noGuess != 0) ? "  no-guess" : "  random  ")
+				<< "  boards/s " << std::setw(9) << stats.games / std::max(stats.generationSeconds, 1e-9)
+				<< "  clicks/s " << std::setw(10) << stats.clicks / std::max(stats.clickSeconds, 1e-9)
+				<< "  reveal us p50 " << std::setw(7) << getPercentile(stats.revealMicroseconds, 0.50)
+				<< " p90 " << std::setw(7) << getPercentile(stats.revealMicroseconds, 0.90)
+				<< " p99 " << std::setw(7) << getPercentile(stats.revealMicroseconds, 0.99)
+				<< " max " << std::setw(7) << getPercentile(stats.revealMicroseconds, 1.0)
+				<< "  wins " << stats.wins << "/" << stats.games << std::endl;
+		}
+	}
+	exploreChunkedBoard(1, gamesPerRun * 50, out);
+}
+/*
+* Function: exploreChunkedBoard
+*
+* Paramters: uint64_t seed,
+*			 uint32_t steps,
+*			 std::ostream &out
+*
+* Return Type: void
+*
+* Description: Moves a view of 48 x 48 tiles over a ChunkedBoard in a random walk,
+*					revealing a tile that is not showing at every step. Mines that are
+*					hit are ignored so the walk keeps going. The chunks are generated as
+*					the view reaches them and evicted once they are more than a chunk
+*					away from it. Writes the reveals per second, the chunks kept and the
+*					memory used to out, the memory grows with the area walked and not
+*					with the size of the board.
+*
+*/
+void HeadlessDriver::exploreChunkedBoard(uint64_t seed, uint32_t steps, std::ostream &out) {
+	const int64_t VIEW = 48;
+	ChunkedBoard infinite(seed, ChunkedBoard::CHUNK_CELLS / 5);
+	RandomStream stream(seed, UINT32_MAX);
+	std::vector<ChunkedBoard::Tile> revealed;
+	int64_t viewX = 0;
+	int64_t viewY = 0;
+	uint64_t tiles = 0;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (uint32_t step = 0; step < steps; step++) {
+		viewX += static_cast<int64_t>(stream.nextBelow(5)) - 2;
+		viewY += static_cast<int64_t>(stream.nextBelow(5)) - 2;
+		infinite.viewRegion(viewX, viewY, viewX + VIEW - 1, viewY + VIEW - 1);
+
+		int64_t x = viewX + stream.nextBelow(VIEW);
+		int64_t y = viewY + stream.nextBelow(VIEW);
+		if (infinite.getState(x, y) == ChunkedBoard::tile_unshown) {
+			revealed.clear();
+			infinite.reveal(x, y, revealed);
+			tiles += revealed.size();
+		}
+		infinite.evictOutside(viewX - ChunkedBoard::CHUNK_SIZE, viewY - ChunkedBoard::CHUNK_SIZE,
+							  viewX + VIEW + ChunkedBoard::CHUNK_SIZE, viewY + VIEW + ChunkedBoard::CHUNK_SIZE);
+	}
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	out << "chunked board  " << steps << " reveals, " << tiles << " tiles shown"
+		<< "  reveals/s " << steps / std::max(elapsed.count(), 1e-9)
+		<< "  chunks active " << infinite.getNumOfActiveChunks() << " compact " << infinite.getNumOfCompactChunks()
+		<< "  memory " << infinite.getMemoryUsage() / 1024.0 << " KB" << std::endl;
+}
+
+/*
+* Function: replay
+*
+* Paramters: const std::string &path,
+*			 GameStats &stats
+*
+* Return Type: void
+*
+* Description: Plays every record of an input log in order without waiting between them.
+*					A generated board is only collected where the log collected it, so the
+*					clicks made while it was generating are handled the same as they were.
+*					The board of the last game is left as the log left it, see getBoard().
+*					Throws an Exception if the log can not be read or is of another size
+*					of board.
+*
+*/
+void HeadlessDriver::replay(const std::string &path, GameStats &stats) throw(Exception) {
+	try {
+		InputLog::Header header;
+		std::vector<InputLog::Record> records;
+		InputLog::read(path, header, records);
+		if (header.rows != GAMEBOARD_ROWS || header.columns != GAMEBOARD_COLUMNS || header.mines != NUM_OF_MINES) {
+			throw Exception("input log is of another size of board", "HeadlessDriver.cpp", "replay");
+		}
+
+		bool validClick = false;
+		for (const InputLog::Record &record : records) {
+			switch (record.action) {
+			case InputLog::input_new_game:
+			case InputLog::input_new_no_guess_game:
+				setNoGuess(record.action == InputLog::input_new_no_guess_game);
+				startGame((static_cast<uint64_t>(record.column) << 32) | record.row, stats);
+				break;
+			case InputLog::input_left_click:
+			case InputLog::input_right_click:
+				click(record.row, record.column, record.action == InputLog::input_left_click, false, stats);
+				break;
+			case InputLog::input_hint:
+				board.applyHint(validClick);
+				stats.clicks++;
+				break;
+			case InputLog::input_board_ready:
+				waitForBoard(stats);
+				break;
+			default:
+				throw Exception("unknown input in log", "HeadlessDriver.cpp", "replay");
+			}
+		}
+	}
+	catch (Exception &excpt) {
+		throw excpt;
+	}
+}
+
+//returns the TileManager the games are played on
+const TileManager & HeadlessDriver::getBoard() const {
+	return board;
+}
+
+//************************************************
+//END OF PUBLIC METHODS, START OF PRIVATE METHODS*
+//************************************************
+
+//resets the board for a new game of the seed
+void HeadlessDriver::startGame(uint64_t seed, GameStats &stats) {
+	board.setupMines(seed);
+	stats.games++;
+}
+/*
+* Function: click
+*
+* Paramters: uint32_t row,
+*			 uint32_t column,
+*			 bool isLeftClick,
+*			 bool isWaitingForBoard,
+*			 GameStats &stats
+*
+* Return Type: bool
+*
+* Description: Clicks the center of a tile through the same functions as a mouse click
+*					and times it. If isWaitingForBoard is true the first left click waits
+*					for the board to be generated. Returns true if a mine was clicked.
+*
+*/
+bool HeadlessDriver::click(uint32_t row, uint32_t column, bool isLeftClick, bool isWaitingForBoard, GameStats &stats) {
+	glm::vec2 center = board.getTileCenter(row, column);
+	bool validClick = false;
+	bool isMine = false;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	if (isLeftClick) {
+		isMine = board.processLeftClick(center.x, center.y, validClick);
+	}
+	else {
+		board.processRightClick(center.x, center.y);
+	}
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+	stats.clicks++;
+	stats.clickSeconds += elapsed.count();
+	if (validClick) {
+		stats.revealMicroseconds.push_back(elapsed.count() * 1000000.0);
+	}
+	if (isWaitingForBoard && board.isGenerating()) {
+		waitForBoard(stats);
+	}
+	return isMine;
+}
+//waits for the board started by the first click and adds the time to stats
+void HeadlessDriver::waitForBoard(GameStats &stats) {
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	bool validClick = false;
+	while (!board.collectBoard(validClick)) {
+		std::this_thread::yield();
+	}
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	stats.generationSeconds += elapsed.count();
+}
+//returns the value at a percentile (0 to 1) of a sorted vector, 0 if it is empty
+double HeadlessDriver::getPercentile(const std::vector<double> &sorted, double percentile) {
+	if (sorted.empty()) {
+		return 0.0;
+	}
+	size_t index = static_cast<size_t>(percentile * (sorted.size() - 1) + 0.5);
+	return sorted[std::min(index, sorted.size() - 1)];
+}
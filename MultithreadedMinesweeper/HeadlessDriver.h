@@ -0,0 +1,62 @@
+/*
+* TITLE:	Multi-threaded Minesweeper
+* BY:		Eric Hollas
+*
+* FILE:		HeadlessDriver.h
+* DETAILS:	This file defines the driver that plays games against the TileManager
+*				without a window or render engine. A game is either a scripted list of
+*				clicks or random clicks on the safe tiles that are not showing, the
+*				clicks go through processLeftClick() and processRightClick() the same as
+*				the clicks of the mouse. The benchmark plays many games for every generation
+*				thread count and reports the boards generated per second, the clicks
+*				processed per second and the percentiles of the reveal latency. It is
+*				run with the --benchmark argument, see main.cpp.
+*			The driver also replays input logs (see InputLog.h) at full speed, the game
+*				played is the same as the one logged.
+*/
+
+#pragma once
+#include "stdafx.h"
+#include "TileManager.h"
+#include "ChunkedBoard.h"
+
+class HeadlessDriver {
+public:
+	// a click of a scripted game
+	struct ScriptedClick {
+		uint32_t row;
+		uint32_t column;
+		bool isLeftClick;
+	};
+
+	// the results of one or more games
+	struct GameStats {
+		uint32_t games;
+		uint32_t wins;
+		uint32_t clicks;				//every click processed, including the first
+		double generationSeconds;		//from each first click until its board was ready
+		double clickSeconds;			//in processLeftClick() and processRightClick()
+		std::vector<double> revealMicroseconds;	//the latency of every left click that revealed a tile
+	};
+
+	HeadlessDriver();
+
+	void setGenerationThreads(uint32_t threads);
+	void setNoGuess(bool isEnabled);
+
+	void playScript(uint64_t seed, const std::vector<ScriptedClick> &script, GameStats &stats);
+	void playRandomGame(uint64_t seed, GameStats &stats);
+	void runBenchmark(uint32_t gamesPerRun, std::ostream &out);
+	void replay(const std::string &path, GameStats &stats) throw(Exception);
+	void exploreChunkedBoard(uint64_t seed, uint32_t steps, std::ostream &out);
+
+	const TileManager & getBoard() const;
+
+private:
+	TileManager board;
+
+	void startGame(uint64_t seed, GameStats &stats);
+	bool click(uint32_t row, uint32_t column, bool isLeftClick, bool isWaitingForBoard, GameStats &stats);
+	void waitForBoard(GameStats &stats);
+	static double getPercentile(const std::vector<double> &sorted, double percentile);
+};
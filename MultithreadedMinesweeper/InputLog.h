@@ -0,0 +1,136 @@
+/*
+* TITLE:	Multi-threaded Minesweeper
+* BY:		Eric Hollas
+*
+* FILE:		InputLog.h
+* DETAILS:	This file defines the append only log of the input of the TileManager. The
+*				file is a header followed by fixed size records, one for every new game,
+*				click and hint, and one for the moment the generated board is collected
+*				since the clicks before it are handled differently. A game only depends
+*				on its seed and its input, so playing the records in order reproduces
+*				every game of the log exactly, see HeadlessDriver::replay(). Every record
+*				is flushed as it is appended so a log is complete up to the last input
+*				even if the game crashes.
+*/
+
+#pragma once
+#include "stdafx.h"
+#include "Exception.h"
+#include "MappedFile.h"
+
+class InputLog {
+public:
+	enum input_action : uint32_t {
+		input_new_game,				//row and column are the low and high half of the seed
+		input_new_no_guess_game,	//the same as input_new_game for a no-guess board
+		input_left_click,
+		input_right_click,
+		input_hint,
+		input_board_ready			//the generated board was collected, row and column are the first click
+	};
+
+	struct Record {
+		uint32_t milliseconds;		//from the start of the game
+		uint32_t action;
+		uint32_t row;
+		uint32_t column;
+	};
+
+	// the header at the start of the file, every field is little endian
+	struct Header {
+		char magic[4];				//"MSLG"
+		uint32_t version;
+		uint32_t rows;
+		uint32_t columns;
+		uint32_t mines;
+		uint32_t padding;
+	};
+
+	static const uint32_t VERSION = 1;
+
+	/*
+	* Constructor
+	*
+	* Parameters: const std::string &path,
+	*			  uint32_t rows,
+	*			  uint32_t columns,
+	*			  uint32_t mines
+	*
+	* opens the log to append to it, the header is written if the file is new.
+	*	Throws an Exception if the file can not be opened.
+	*
+	*/
+	InputLog(const std::string &path, uint32_t rows, uint32_t columns, uint32_t mines) throw(Exception) {
+		try {
+			file.open(path, std::ios::binary | std::ios::app);
+			if (!file.is_open()) {
+				throw Exception("failed to open file " + path, "InputLog.h", "InputLog-Constructor");
+			}
+			file.seekp(0, std::ios::end);
+			if (file.tellp() == std::streampos(0)) {
+				Header header = { { 'M', 'S', 'L', 'G' }, VERSION, rows, columns, mines, 0 };
+				file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+				file.flush();
+			}
+		}
+		catch (Exception &excpt) {
+			throw excpt;
+		}
+	}
+
+	/*
+	* Function: append
+	*
+	* Paramters: input_action action,
+	*			 uint32_t row,
+	*			 uint32_t column,
+	*			 uint32_t milliseconds
+	*
+	* Return Type: void
+	*
+	* Description: appends a record to the end of the log
+	*
+	*/
+	void append(input_action action, uint32_t row, uint32_t column, uint32_t milliseconds) {
+		Record record = { milliseconds, action, row, column };
+		file.write(reinterpret_cast<const char*>(&record), sizeof(Record));
+		file.flush();
+	}
+
+	/*
+	* Function: read
+	*
+	* Paramters: const std::string &path,
+	*			 Header &header,
+	*			 std::vector<Record> &records
+	*
+	* Return Type: void
+	*
+	* Description: maps a log and copies out its header and records, a record that was
+	*				only partly written at the end of the file is ignored. Throws an
+	*				Exception if the file can not be mapped or is not a log.
+	*
+	*/
+	static void read(const std::string &path, Header &header, std::vector<Record> &records) throw(Exception) {
+		try {
+			MappedFile mapping(path);
+			if (mapping.getSize() < sizeof(Header)) {
+				throw Exception("file is too small to be an input log", "InputLog.h", "read");
+			}
+			std::memcpy(&header, mapping.getData(), sizeof(Header));
+			if (std::memcmp(header.magic, "MSLG", 4) != 0 || header.version != VERSION) {
+				throw Exception("file is not an input log of version " + std::to_string(VERSION), "InputLog.h", "read");
+			}
+			records.resize((mapping.getSize() - sizeof(Header)) / sizeof(Record));
+			if (!records.empty()) {
+				std::memcpy(records.data(), mapping.getData() + sizeof(Header), records.size() * sizeof(Record));
+			}
+		}
+		catch (Exception &excpt) {
+			throw excpt;
+		}
+	}
+
+private:
+	std::ofstream file;
+};
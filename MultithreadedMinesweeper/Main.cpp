@@ -3,14 +3,35 @@
 * BY:		Eric Hollas
 *	
 * FILE:		main.cpp
-* DETAILS:	This file creates and calls the object to run the game						*
+* DETAILS:	This file creates and calls the object to run the game, or with the
+*				--benchmark argument runs the headless benchmark instead of the game.
+*				The --replay argument plays an input log and can save the snapshot of
+*				the board it ends on.						*
 */
 #include "stdafx.h"
 #include "Window.h"
 #include "Exception.h"
+#include "HeadlessDriver.h"
 
-int main() {
+int main(int argc, char *argv[]) {
 	try {
+		//the optional second argument is the number of games of each benchmark run
+		if (argc > 1 && std::string(argv[1]) == "--benchmark") {
+			HeadlessDriver driver;
+			driver.runBenchmark((argc > 2) ? std::max(1, std::atoi(argv[2])) : 200, std::cout);
+			return EXIT_SUCCESS;
+		}
+		//the optional third argument is the file to save the snapshot of the replayed board to
+		if (argc > 2 && std::string(argv[1]) == "--replay") {
+			HeadlessDriver driver;
+			HeadlessDriver::GameStats stats = { 0, 0, 0, 0.0, 0.0, std::vector<double>() };
+			driver.replay(argv[2], stats);
+			if (argc > 3) {
+				driver.getBoard().takeSnapshot().save(argv[3]);
+			}
+			std::cout << "replayed " << stats.games << " games and " << stats.clicks << " inputs" << std::endl;
+			return EXIT_SUCCESS;
+		}
 		Window app;
 		app.runGame();
 	}
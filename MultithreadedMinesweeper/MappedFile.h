@@ -0,0 +1,128 @@
+/*
+* TITLE:	Multi-threaded Minesweeper
+* BY:		Eric Hollas
+*
+* FILE:		MappedFile.h
+* DETAILS:	This file defines a read only memory mapping of a whole file. Mapping a
+*				file only reserves its pages, they are read in by the os as they are
+*				touched, so a snapshot or input log of any size is opened without
+*				copying it. The mapping is closed when the object is destroyed.
+*/
+
+#pragma once
+#include "stdafx.h"
+#include "Exception.h"
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+class MappedFile {
+public:
+	/*
+	* Constructor
+	*
+	* Parameters: const std::string &path
+	*
+	* maps the whole file, throws an Exception if it can not be opened or mapped
+	*
+	*/
+	MappedFile(const std::string &path) throw(Exception) {
+		try {
+			pData = nullptr;
+			size = 0;
+#ifdef _WIN32
+			hFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			hMapping = nullptr;
+			LARGE_INTEGER fileSize;
+			if (hFile == INVALID_HANDLE_VALUE || !GetFileSizeEx(hFile, &fileSize)) {
+				close();
+				throw Exception("failed to open file " + path, "MappedFile.h", "MappedFile-Constructor");
+			}
+			size = static_cast<size_t>(fileSize.QuadPart);
+			if (size > 0) {
+				hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+				pData = (hMapping == nullptr) ? nullptr : static_cast<const uint8_t*>(MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0));
+			}
+#else
+			fileDescriptor = open(path.c_str(), O_RDONLY);
+			struct stat status;
+			if (fileDescriptor < 0 || fstat(fileDescriptor, &status) != 0) {
+				close();
+				throw Exception("failed to open file " + path, "MappedFile.h", "MappedFile-Constructor");
+			}
+			size = static_cast<size_t>(status.st_size);
+			if (size > 0) {
+				void *pMapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+				pData = (pMapped == MAP_FAILED) ? nullptr : static_cast<const uint8_t*>(pMapped);
+			}
+#endif
+			if (size > 0 && pData == nullptr) {
+				close();
+				throw Exception("failed to map file " + path, "MappedFile.h", "MappedFile-Constructor");
+			}
+		}
+		catch (Exception &excpt) {
+			throw excpt;
+		}
+	}
+	/*
+	* Deconstructor
+	*/
+	~MappedFile() {
+		close();
+	}
+
+	/*
+	* The following functions are generic accessor methods
+	*
+	*/
+	const uint8_t * getData() const {
+		return pData;
+	}
+	size_t getSize() const {
+		return size;
+	}
+
+private:
+	const uint8_t * pData;
+	size_t size;
+#ifdef _WIN32
+	HANDLE hFile;
+	HANDLE hMapping;
+#else
+	int fileDescriptor;
+#endif
+
+	// a mapping can not be copied, it is shared by pointer instead
+	MappedFile(const MappedFile &) = delete;
+	MappedFile & operator=(const MappedFile &) = delete;
+
+	//unmaps the file and closes the handles that were opened
+	void close() {
+#ifdef _WIN32
+		if (pData != nullptr) {
+			UnmapViewOfFile(pData);
+		}
+		if (hMapping != nullptr) {
+			CloseHandle(hMapping);
+		}
+		if (hFile != INVALID_HANDLE_VALUE) {
+			CloseHandle(hFile);
+		}
+		hMapping = nullptr;
+		hFile = INVALID_HANDLE_VALUE;
+#else
+		if (pData != nullptr) {
+			munmap(const_cast<uint8_t*>(pData), size);
+		}
+		if (fileDescriptor >= 0) {
+			::close(fileDescriptor);
+		}
+		fileDescriptor = -1;
+#endif
+		pData = nullptr;
+	}
+};
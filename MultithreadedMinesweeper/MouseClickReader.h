@@ -5,17 +5,37 @@
 * FILE:		MouseClickReader.h	
 * DETAILS:	This file defines the instance object that takes in the mouse coordinates
 *				of a click and then converts them to vulkan coordinates to be used later
+*				The conversion inverts the camera's view and projection, so it stays
+*				correct for any window size or camera set with setView().
 */
 
 #ifndef _MOUSECLICKREADER_H_
 #define _MOUSECLICKREADER_H_
 
 #include "stdafx.h"
+#include "Camera.h"
 
 class MouseClickReader {
 public:
 	static MouseClickReader* instance();
 
+	/*
+	* Function: setView
+	*
+	* Paramters: const Camera::pointOfView &camera,
+	*			 float width,
+	*			 float height
+	*
+	* Return Type: void
+	*
+	* Description: stores the camera and the window size used to convert the clicks,
+	*				to be called whenever the camera or the window size changes
+	*
+	*/
+	void setView(const Camera::pointOfView &camera, float width, float height) {
+		view = camera;
+		windowSize = glm::vec2(width, height);
+	}
 	/*
 	* Function: setClick
 	*
@@ -25,14 +45,16 @@ public:
 	* Return Type: void
 	*
 	* Description: converts the parameters from glfw screen coordinates to
-	*				the coordinates used by vulkan (given the camera, which
-	*				is stagnent, view and projection). It then stores the
-	*				values in vulkan_coordinates member variable to be returned later
+	*				the coordinates used by vulkan by projecting the click onto the
+	*				z = 0 plane the tiles are drawn on (given the camera view and
+	*				projection passed to setView). It then stores the values in
+	*				vulkan_coordinates member variable to be returned later
 	*
 	*/
 	void setClick(float x_position, float y_position) {
-		vulkan_coordinates.x = 1.03f - x_position * (2.06f / DEFAULT_WINDOW_WIDTH);
-		vulkan_coordinates.y = 1.03f - y_position * (2.06f / DEFAULT_WINDOW_HEIGHT);
+		glm::vec3 point = view.screenToPlane(glm::vec2(x_position, y_position), windowSize, 0.0f);
+		vulkan_coordinates.x = point.x;
+		vulkan_coordinates.y = point.y;
 	}
 	// a simple getter method
 	glm::vec2 getVulkanCoordinates() const {
@@ -40,6 +62,8 @@ public:
 	}
 private:
 	glm::vec2 vulkan_coordinates;
+	Camera::pointOfView view;
+	glm::vec2 windowSize;
 };
 
 //returns a static instance of the object, will be defined as the constant PICKER
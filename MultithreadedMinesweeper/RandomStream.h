@@ -0,0 +1,137 @@
+/*
+* TITLE:	Multi-threaded Minesweeper
+* BY:		Eric Hollas
+*
+* FILE:		RandomStream.h
+* DETAILS:	This file defines the counter-based random number generator used to
+*				generate the gameboard. A stream is keyed by a seed and a stream id
+*				(the row of the board), the n-th number of a stream is the splitmix64
+*				mix of the key and n, so every stream is independent of the others and
+*				of the order or thread the streams are used on. The same seed always
+*				produces the same board no matter how many threads generate it.
+*/
+
+#pragma once
+#include "stdafx.h"
+#include <cmath>
+#include <random>
+
+class RandomStream {
+public:
+	/*
+	* Constructor
+	*
+	* Parameters: uint64_t seed,
+	*			  uint64_t stream	the id of the stream, each id gives an independent sequence
+	*
+	*/
+	RandomStream(uint64_t seed, uint64_t stream) {
+		key = mix(seed + mix(stream + 1));
+		counter = 0;
+	}
+
+	/*
+	* Function: next
+	*
+	* Paramters: none
+	*
+	* Return Type: uint64_t
+	*
+	* Description: returns the next number in the stream
+	*
+	*/
+	uint64_t next() {
+		counter++;
+		return mix(key + counter * GOLDEN_GAMMA);
+	}
+	/*
+	* Function: nextBelow
+	*
+	* Paramters: uint32_t bound
+	*
+	* Return Type: uint32_t
+	*
+	* Description: returns an evenly distributed number in [0, bound), the multiply and
+	*				shift is rejected on the few values that would bias the result
+	*
+	*/
+	uint32_t nextBelow(uint32_t bound) {
+		uint64_t product = (next() >> 32) * bound;
+		uint32_t low = static_cast<uint32_t>(product);
+		if (low < bound) {
+			uint32_t threshold = (0u - bound) % bound;
+			while (low < threshold) {
+				product = (next() >> 32) * bound;
+				low = static_cast<uint32_t>(product);
+			}
+		}
+		return static_cast<uint32_t>(product >> 32);
+	}
+	/*
+	* Function: nextUnit
+	*
+	* Paramters: none
+	*
+	* Return Type: double
+	*
+	* Description: returns an evenly distributed number in [0, 1)
+	*
+	*/
+	double nextUnit() {
+		return (next() >> 11) * (1.0 / 9007199254740992.0);
+	}
+	/*
+	* Function: nextHypergeometric
+	*
+	* Paramters: uint32_t population,
+	*			 uint32_t successes,
+	*			 uint32_t draws
+	*
+	* Return Type: uint32_t
+	*
+	* Description: returns how many of the successes are picked when draws items are picked
+	*				without replacement from the population, by walking the cumulative
+	*				distribution from its smallest possible value. Used to split an exact
+	*				number of mines between rows with one number per row.
+	*
+	*/
+	uint32_t nextHypergeometric(uint32_t population, uint32_t successes, uint32_t draws) {
+		uint32_t failures = population - successes;
+		uint32_t k = (draws > failures) ? draws - failures : 0;
+		uint32_t kMax = std::min(draws, successes);
+		if (k == kMax) {
+			return k;
+		}
+
+		double probability = std::exp(logChoose(successes, k) + logChoose(failures, draws - k) - logChoose(population, draws));
+		double u = nextUnit();
+		while (k < kMax && u >= probability) {
+			u -= probability;
+			probability *= (double)(successes - k) * (draws - k) / ((double)(k + 1) * (failures - draws + k + 1));
+			k++;
+		}
+		return k;
+	}
+
+	// returns a seed that is different every call, for boards that do not need to be reproduced
+	static uint64_t randomSeed() {
+		std::random_device device;
+		return (static_cast<uint64_t>(device()) << 32) ^ device();
+	}
+
+private:
+	static const uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ull;
+
+	uint64_t key;
+	uint64_t counter;
+
+	//the splitmix64 finalizer
+	static uint64_t mix(uint64_t z) {
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+	static double logChoose(uint32_t n, uint32_t k) {
+		return std::lgamma(n + 1.0) - std::lgamma(k + 1.0) - std::lgamma(n - k + 1.0);
+	}
+};
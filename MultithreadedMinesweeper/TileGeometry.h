@@ -849,4 +849,88 @@ struct zero_tile_geometry : BaseTileGeometry {
 			}
 		}
 	}
-};
\ No newline at end of file
+};
+
+// the glyphs that a gameboard tile can show, used as the tile state in the InstancedGrid
+//	and as the mesh id in the tile mesh library. The number tiles come first so that a
+//	tile's value in gameboard_values (when it is not a mine) is also its glyph.
+enum tile_glyph : uint8_t {
+	glyph_blank,
+	glyph_one,
+	glyph_two,
+	glyph_three,
+	glyph_four,
+	glyph_five,
+	glyph_six,
+	glyph_seven,
+	glyph_eight,
+	glyph_mine_hit,
+	glyph_mine_reveal,
+	glyph_unshown,
+	glyph_flagged,
+	glyph_zero,				//scoreboard digit
+	glyph_nine,				//scoreboard digit
+	NUM_OF_GLYPHS
+};
+
+// an immutable tile mesh, one for every glyph is kept in the tile mesh library
+struct TileMesh {
+	std::vector<Geometry::Vertex> vertices;
+	std::vector<uint32_t> indices;
+};
+
+//builds the mesh of the tile geometry type passed as the template parameter
+template <class tile_type>
+TileMesh buildTileMesh() {
+	tile_type tile;
+	tile.initMesh();
+	TileMesh mesh;
+	mesh.vertices = tile.vertices;
+	mesh.indices = tile.indices;
+	return mesh;
+}
+
+/*
+* Function: getTileMesh
+*
+* Paramters: tile_glyph glyph
+*
+* Return Type: const TileMesh&
+*
+* Description: returns the mesh of the glyph from the tile mesh library. The library
+*				is generated the first time it is used (the circle meshes need sin and cos,
+*				so they can not be built at compile time) and never changes afterwards,
+*				so the lookup is only an array index and is safe to call from any thread.
+*
+*/
+inline const TileMesh& getTileMesh(tile_glyph glyph) {
+	static const TileMesh library[NUM_OF_GLYPHS] = {
+		buildTileMesh<blank_tile_geometry>(),			//glyph_blank
+		buildTileMesh<adjacent_one_tile_geometry>(),	//glyph_one
+		buildTileMesh<adjacent_two_tile_geometry>(),	//glyph_two
+		buildTileMesh<adjacent_three_tile_geometry>(),	//glyph_three
+		buildTileMesh<adjacent_four_tile_geometry>(),	//glyph_four
+		buildTileMesh<adjacent_five_tile_geometry>(),	//glyph_five
+		buildTileMesh<adjacent_six_tile_geometry>(),	//glyph_six
+		buildTileMesh<adjacent_seven_tile_geometry>(),	//glyph_seven
+		buildTileMesh<adjacent_eight_tile_geometry>(),	//glyph_eight
+		buildTileMesh<mine_hit_tile_geometry>(),		//glyph_mine_hit
+		buildTileMesh<mine_reveal_tile_geometry>(),		//glyph_mine_reveal
+		buildTileMesh<unshown_tile_geometry>(),			//glyph_unshown
+		buildTileMesh<flagged_tile_geometry>(),			//glyph_flagged
+		buildTileMesh<zero_tile_geometry>(),			//glyph_zero
+		buildTileMesh<nine_tile_geometry>()				//glyph_nine
+	};
+	return library[glyph < NUM_OF_GLYPHS ? glyph : glyph_unshown];
+}
+
+//returns the glyph that shows the digit (0 to 9) on the scoreboard
+inline tile_glyph getDigitGlyph(uint32_t digit) {
+	if (digit == 0) {
+		return glyph_zero;
+	}
+	else if (digit >= 9) {
+		return glyph_nine;
+	}
+	return static_cast<tile_glyph>(digit);
+}
\ No newline at end of file
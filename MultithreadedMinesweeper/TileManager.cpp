@@ -7,6 +7,24 @@
 */
 TileManager::TileManager() {
 	pGeometryManager = new Geometry::GeometryManager();
+	pBoardGrid = nullptr;
+	scoreboard_index = GAMEBOARD_ROWS * GAMEBOARD_COLUMNS;
+	setGenerationThreads(std::thread::hardware_concurrency());
+
+	//the grid is laid out like the uniform matrices in initGameboard(), the glyphs are
+	//	registered in the order of the tile_glyph enum so that the glyph ids match
+	if (INSTANCED_BOARD) {
+		pBoardGrid = new Geometry::InstancedGrid(GAMEBOARD_ROWS,
+												 GAMEBOARD_COLUMNS,
+												 glm::vec2{ 0.95f, 0.78f },
+												 glm::vec2{ -(TILE_SIZE + 0.005f), -(TILE_SIZE + 0.005f) },
+												 TILE_SIZE);
+		for (uint8_t glyph = 0; glyph < NUM_OF_GLYPHS; glyph++) {
+			const TileMesh &mesh = getTileMesh((tile_glyph)glyph);
+			pBoardGrid->addGlyph(mesh.vertices, mesh.indices);
+		}
+		scoreboard_index = 0;
+	}
 }
 /*
 *	Deconstructor
@@ -21,14 +39,86 @@ TileManager::~TileManager() {
 *
 * Return Type: void
 *
-* Description: Several of the multithreaded algorithms are featured in this method.
-*					This mehtod ensures that every member variable is initialized,
-*					then randomly generates the mine positions, clalculates the
-*					tiles values as either blank, adjacent to mines, or a mine. Then
-*					makes a function call to initGameboard() to initialize the geometry info.
+* Description: sets up a new board from a new random seed, see setupMines(uint64_t seed)
 *
 */
 void TileManager::setupMines() {
+	setupMines(RandomStream::randomSeed());
+}
+/*
+* Function: setupMines
+*
+* Paramters: uint64_t seed
+*
+* Return Type: void
+*
+* Description: This mehtod ensures that every member variable is initialized for a new
+*					game and sets up the geometry info of the unshown board and the scoreboard.
+*					The mines are not placed yet, the board is generated from the seed on a
+*					worker thread once the first tile is clicked (see generateBoard()), so
+*					resetting the game never waits for the board.
+*
+*/
+void TileManager::setupMines(uint64_t seed) {
+	resetGame(seed);
+	logInput(no_guess ? InputLog::input_new_no_guess_game : InputLog::input_new_game, static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32));
+}
+/*
+* Function: setupInfiniteBoard
+*
+* Paramters: uint64_t seed
+*
+* Return Type: void
+*
+* Description: starts a game on an endless ChunkedBoard of the seed. The grid shows a
+*					window of GAMEBOARD_ROWS x GAMEBOARD_COLUMNS of its tiles, which
+*					followCamera() keeps under the camera, and the clicks are played on
+*					the tiles of the window. The game is not logged, has no mine count
+*					and can not be won, it ends when a mine is revealed. setupMines() and
+*					loadSnapshot() go back to the normal board.
+*
+*/
+void TileManager::setupInfiniteBoard(uint64_t seed) {
+	resetGame(seed);
+	pInfiniteBoard = std::make_shared<ChunkedBoard>(seed, INFINITE_MINES_PER_CHUNK);
+	window_x = 0;
+	window_y = 0;
+}
+//returns true if the endless board of setupInfiniteBoard() is played
+bool TileManager::isInfinite() const {
+	return pInfiniteBoard != nullptr;
+}
+/*
+* Function: resetGame
+*
+* Paramters: uint64_t seed
+*
+* Return Type: void
+*
+* Description: resets every member variable and the geometry info for a new game of the
+*					seed, see setupMines(uint64_t seed)
+*
+*/
+void TileManager::resetGame(uint64_t seed) {
+	//a board of the previous game may still be generating, it is cancelled and left to
+	//	finish on its worker without waiting for it
+	if (generation.valid()) {
+		pending_job->cancelled = true;
+		cancelled_generations.push_back(generation);
+		generation = std::shared_future<void>();
+	}
+	pending_job.reset();
+	pInfiniteBoard.reset();
+	queued_clicks.clear();
+	dropCancelledGenerations();
+	board_status = board_empty;
+	board_seed = seed;
+	generation_report = { false, 0, 0, 0.0 };
+	game_start = std::chrono::steady_clock::now();
+	previous_time = 0;
+	num_of_revealed = 0;
+	is_mine_hit = false;
+
 	//init/re-init the class member variables
 	for (int i = 0; i < GAMEBOARD_ROWS; i++) {
 		for (int j = 0; j < GAMEBOARD_COLUMNS; j++) {
@@ -36,180 +126,493 @@ void TileManager::setupMines() {
 		}
 	}
 	gameboard_values.clear();
+	mine_positions.clear();
 	uniformMatrices.clear();
 	pGeometryManager->~GeometryManager();
 	pGeometryManager = new Geometry::GeometryManager();
+	geometryChanged = true;
+
+	//register the tile mesh library in glyph order so that a glyph is also its mesh id,
+	//	changing a tile afterwards only changes which mesh the tile's object draws
+	for (uint8_t glyph = 0; glyph < NUM_OF_GLYPHS; glyph++) {
+		const TileMesh &mesh = getTileMesh((tile_glyph)glyph);
+		pGeometryManager->addMesh(mesh.vertices, mesh.indices);
+	}
+
+	initGameboard();
+
+	//the following makes a call to a function that sets up the feedback info at the top of the screen
+	setupScoreboard();
+	num_of_flagged = NUM_OF_MINES;
+	updateScoreTiles();
+}
+/*
+* Function: collectBoard
+*
+* Paramters: bool &validClick
+*
+* Return Type: bool
+*
+* Description: To be called every frame. Once the board started by the first click has
+*					been generated it is swapped in as the current board, the first click
+*					is revealed and then the left clicks made while it was generating are
+*					played in order. validClick is set the same as in processLeftClick(),
+*					a queued click may hit a mine (see isLost()). Returns true if the
+*					board was collected this call, otherwise it returns false without
+*					waiting.
+*
+*/
+bool TileManager::collectBoard(bool &validClick) {
+	validClick = false;
+	dropCancelledGenerations();
+	if (board_status != board_generating || generation.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+		return false;
+	}
+	generation.get();
+	generation = std::shared_future<void>();
+	gameboard_values.swap(pending_job->values);
+	mine_positions.swap(pending_job->mines);
+	generation_report = pending_job->report;
+	pending_job.reset();
+	board_status = board_ready;
+	logInput(InputLog::input_board_ready, pending_row, pending_column);
+
+	revealClicked(pending_row, pending_column, validClick);
+
+	std::vector<uint32_t> clicks;
+	clicks.swap(queued_clicks);
+	for (uint32_t i = 0; i < clicks.size() && !is_mine_hit; i++) {
+		bool isValid = false;
+		processLeftClick(clicks[i] / GAMEBOARD_COLUMNS, clicks[i] % GAMEBOARD_COLUMNS, isValid);
+		validClick = validClick || isValid;
+	}
+	return true;
+}
+//releases the workers of cancelled games that have finished, without waiting for the others
+void TileManager::dropCancelledGenerations() {
+	cancelled_generations.erase(std::remove_if(cancelled_generations.begin(), cancelled_generations.end(),
+											   [](const std::shared_future<void> &worker) {
+		return worker.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+	}), cancelled_generations.end());
+}
+//returns true from the first click until collectBoard() has collected the board
+bool TileManager::isGenerating() const {
+	return board_status == board_generating;
+}
+/*
+* Function: generateBoard
+*
+* Paramters: std::shared_ptr<generation_job> job
+*
+* Return Type: void
+*
+* Description: It runs on a worker thread started by the first click and only reads and
+*					writes its job. It generates the board of the job's seed so that the
+*					clicked tile (safeRow, safeColumn) and its neighbors are never mines,
+*					see buildBoard().
+*				If isNoGuess is set the candidate boards of the attempt seeds are generated
+*					and checked by the BoardSolver on several threads instead. The lowest
+*					attempt that can be won without guessing is played, so the board of a
+*					seed does not depend on the number of threads. Once an attempt passes
+*					the threads stop taking attempts after it.
+*				A cancelled job returns without a board, nothing reads it after the reset.
+*
+*/
+void TileManager::generateBoard(std::shared_ptr<generation_job> job) {
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	uint32_t safeRow = job->safeRow;
+	uint32_t safeColumn = job->safeColumn;
+	job->report = { false, 1, 0, 0.0 };
+
+	if (job->isNoGuess) {
+		std::atomic<uint32_t> next_attempt(0);
+		std::atomic<uint32_t> attempts(0);
+		std::atomic<uint32_t> winner(MAX_GENERATION_ATTEMPTS);
+		const std::atomic<bool> &cancelled = job->cancelled;
+		uint64_t seed = job->seed;
 
-	//reseed the rand() function and init the local member variables
-	srand(time(NULL));
-	int mines_per_row[GAMEBOARD_ROWS] = { 0 };
-	int mine_count = 0;
-	int mine_limit = 4;
-	int row = 0;
-
-	//generates a buffer of random numbers to represent how many mines
-	// need to be assigned to each row and ensures that correct total number
-	// of mines are assigned each time.
-	while (mine_count != NUM_OF_MINES) {
-		if (NUM_OF_MINES - mine_count < mine_limit) {
-			mines_per_row[row] += NUM_OF_MINES - mine_count;
-			mine_count = NUM_OF_MINES;
+		//the following is a lambda used to define the search run on each thread, every
+		// thread builds its candidates into its own board so this is thread safe.
+		// The threads only share the attempt counters.
+		auto search = [&]() {
+			std::vector<std::vector<uint8_t>> values;
+			std::vector<uint32_t> mines;
+			std::vector<uint8_t> flat(GAMEBOARD_ROWS * GAMEBOARD_COLUMNS);
+			for (uint32_t attempt = next_attempt++; attempt < winner && !cancelled; attempt = next_attempt++) {
+				attempts++;
+				buildBoard(getAttemptSeed(seed, attempt), safeRow, safeColumn, 1, values, mines);
+				for (uint32_t row = 0; row < GAMEBOARD_ROWS; row++) {
+					std::copy(values[row].begin(), values[row].end(), flat.begin() + row * GAMEBOARD_COLUMNS);
+				}
+				if (BoardSolver::isNoGuess(GAMEBOARD_ROWS, GAMEBOARD_COLUMNS, NUM_OF_MINES, flat, safeColumn + safeRow * GAMEBOARD_COLUMNS)) {
+					//keeps the lowest attempt that passed
+					uint32_t best = winner;
+					while (attempt < best && !winner.compare_exchange_weak(best, attempt)) {}
+				}
+			}
+		};
+		// end of lambda function to be run concurrently
+
+		std::vector<std::thread> threads;
+		for (uint32_t i = 0; i < job->threads; i++) {
+			threads.push_back(std::thread(search));
 		}
-		else {
-			int random_number = rand() % mine_limit;
-			mines_per_row[row] += random_number;
-			mine_count += random_number;
+		for (uint32_t i = 0; i < threads.size(); i++) {
+			threads[i].join();
 		}
-		row++;
-		if (row == GAMEBOARD_ROWS) {
-			row = 0;
+		if (job->cancelled) {
+			return;
+		}
+
+		//if no board passed the first candidate is played as a normal board
+		job->report.attempts = attempts;
+		if (winner < MAX_GENERATION_ATTEMPTS) {
+			job->report.isNoGuess = true;
+			job->report.winningAttempt = winner;
 		}
 	}
 
-	//creates and runs the threads of the callable object defined in the class header file
-	// will randomly assign mine positions throughout the game board
-	//  NOTE THAT the threads run on a row by row basis so this is thread safe.
-	std::vector<std::thread> threads;
-	for (uint8_t i = 0; i < GAMEBOARD_ROWS; i++) {
-		row_assignment row = row_assignment();
-		std::thread t(row, mines_per_row[i], std::ref(gameboard_values));
-		threads.push_back(std::move(t));
+	//the winning board is built again with every thread rather than kept by the search
+	if (job->cancelled) {
+		return;
+	}
+	buildBoard(getAttemptSeed(job->seed, job->report.winningAttempt), safeRow, safeColumn, job->threads, job->values, job->mines);
+	job->report.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+/*
+* Function: buildBoard
+*
+* Paramters: uint64_t seed,
+*			 uint32_t safeRow,
+*			 uint32_t safeColumn,
+*			 uint32_t threads,
+*			 std::vector<std::vector<uint8_t>> &values,
+*			 std::vector<uint32_t> &mines
+*
+* Return Type: void
+*
+* Description: Several of the multithreaded algorithms are featured in this method.
+*					It generates the mine positions from the seed on the number of threads
+*					passed so that the tile (safeRow, safeColumn) and its neighbors are never
+*					mines, then clalculates the tiles values as either blank, adjacent to
+*					mines, or a mine. The board is written to values and the index of every
+*					mine to mines.
+*
+*/
+void TileManager::buildBoard(uint64_t seed, uint32_t safeRow, uint32_t safeColumn, uint32_t threads,
+							 std::vector<std::vector<uint8_t>> &values, std::vector<uint32_t> &mines) {
+	//counts the cells of each row that can have a mine, the rows next to the
+	// first click have up to three cells that are kept clear
+	uint32_t open_per_row[GAMEBOARD_ROWS];
+	uint32_t cells_left = 0;
+	for (uint32_t row = 0; row < GAMEBOARD_ROWS; row++) {
+		open_per_row[row] = GAMEBOARD_COLUMNS;
+		if (row + 1 >= safeRow && row <= safeRow + 1) {
+			for (uint32_t column = 0; column < GAMEBOARD_COLUMNS; column++) {
+				if (column + 1 >= safeColumn && column <= safeColumn + 1) {
+					open_per_row[row]--;
+				}
+			}
+		}
+		cells_left += open_per_row[row];
 	}
 
-	// since the initial geometric data for the starting board is constant, thus
-	// the data in initGameboard() is mutually exclusive to the running threads and
-	// is therefore thread safe
-	initGameboard();
+	//splits the mines between the rows with one hypergeometric draw per row from the
+	// seed's first stream, so every mine placement is equally likely and the total
+	// is always exactly NUM_OF_MINES
+	RandomStream rowStream(seed, 0);
+	uint32_t mines_per_row[GAMEBOARD_ROWS] = { 0 };
+	uint32_t mines_left = NUM_OF_MINES;
+	for (uint32_t row = 0; row < GAMEBOARD_ROWS; row++) {
+		mines_per_row[row] = rowStream.nextHypergeometric(cells_left, mines_left, open_per_row[row]);
+		cells_left -= open_per_row[row];
+		mines_left -= mines_per_row[row];
+	}
 
-	//ensure the threads are done running by this point
-	for (uint8_t i = 0; i < threads.size(); i++) {
-		if (threads[i].joinable()) {
-			threads[i].join();
+	//creates and runs the threads of the callable object defined in the class header file
+	// will place the mines of the rows throughout the game board
+	//  NOTE THAT the threads run on a row by row basis so this is thread safe.
+	//  With a single thread the rows are placed on the calling thread.
+	std::vector<std::vector<uint8_t>> mine_mask(GAMEBOARD_ROWS, std::vector<uint8_t>(GAMEBOARD_COLUMNS, 0));
+	std::vector<std::vector<uint32_t>> row_mines(GAMEBOARD_ROWS);
+	std::vector<std::thread> thread_list;
+	if (threads <= 1) {
+		row_assignment()(seed, 0, 1, safeRow, safeColumn, mines_per_row, mine_mask, row_mines);
+	}
+	else {
+		for (uint32_t i = 0; i < threads; i++) {
+			std::thread t(row_assignment(), seed, i, threads, safeRow, safeColumn, mines_per_row, std::ref(mine_mask), std::ref(row_mines));
+			thread_list.push_back(std::move(t));
 		}
+		for (uint32_t i = 0; i < thread_list.size(); i++) {
+			thread_list[i].join();
+		}
+		thread_list.clear();
+	}
+
+	//merges the mines logged by each row into the mine index once the threads are done
+	mines.clear();
+	mines.reserve(NUM_OF_MINES);
+	for (uint32_t row = 0; row < GAMEBOARD_ROWS; row++) {
+		mines.insert(mines.end(), row_mines[row].begin(), row_mines[row].end());
 	}
-	threads.clear();
 
 	//the following is a lambda used to define a the method to count adjacent
 	// mine tiles concurrently
-	// Note that this will be thread safe as well as it runs row by row, so 
-	// tiles will not be checked more than once per tile. and incrementing adjacent
-	// tiles by one is not dependent on order.
-	// Futhermore, if it is a mine for that tile the value will check for is
-	// greater than or equal to 10, not only equal to ten, thus we can increment
-	// all adjacent tiles to mines indiscreminately.
-	auto counter = [](int row, std::vector<std::vector<uint8_t>> &board) {
-		// go through the row tile-by-tile in this for loop
-		// the if checks if the tile is a mine tile
-		// the switch statement widdles down where on the board
-		// the tile is to ensure no read access errors and increments
-		// all adjacent tiles
-		for (uint8_t column = 0; column < GAMEBOARD_COLUMNS; column++) {
-			if (board[row][column] >= 10) {
-				switch (row) {
-				case 0:
-					switch (column) {
-						//upper left corner
-					case 0:
-						board[row + 1][column]++;
-						board[row + 1][column + 1]++;
-						board[row][column + 1]++;
-						break;
-						//upper right corner
-					case GAMEBOARD_COLUMNS - 1:
-						board[row + 1][column]++;
-						board[row + 1][column - 1]++;
-						board[row][column - 1]++;
-						break;
-						//upper row
-					default:
-						board[row + 1][column]++;
-						board[row + 1][column + 1]++;
-						board[row][column + 1]++;
-						board[row + 1][column - 1]++;
-						board[row][column - 1]++;
-						break;
-					}
-					break;
-				case GAMEBOARD_ROWS - 1:
-					switch (column) {
-						//bottom left corner
-					case 0:
-						board[row - 1][column]++;
-						board[row - 1][column + 1]++;
-						board[row][column + 1]++;
-						break;
-						//bottom right corner
-					case GAMEBOARD_COLUMNS - 1:
-						board[row - 1][column]++;
-						board[row - 1][column - 1]++;
-						board[row][column - 1]++;
-						break;
-						//bottom row
-					default:
-						board[row - 1][column - 1]++;
-						board[row - 1][column]++;
-						board[row - 1][column + 1]++;
-						board[row][column - 1]++;
-						board[row][column + 1]++;
-						break;
+	// Note that this is thread safe as each thread only writes the values of its
+	// own rows and only reads the mines, which do not change anymore.
+	// A mine's value is 10 plus the number of adjacent mines, so a mine is any
+	// value greater than or equal to 10.
+	auto counter = [](uint32_t firstRow, uint32_t rowStride, const std::vector<std::vector<uint8_t>> &mines, std::vector<std::vector<uint8_t>> &board) {
+		for (uint32_t row = firstRow; row < GAMEBOARD_ROWS; row += rowStride) {
+			uint32_t top = (row == 0) ? 0 : row - 1;
+			uint32_t bottom = std::min(row + 1, (uint32_t)GAMEBOARD_ROWS - 1);
+			for (uint32_t column = 0; column < GAMEBOARD_COLUMNS; column++) {
+				uint32_t left = (column == 0) ? 0 : column - 1;
+				uint32_t right = std::min(column + 1, (uint32_t)GAMEBOARD_COLUMNS - 1);
+				uint8_t value = mines[row][column];
+				for (uint32_t r = top; r <= bottom; r++) {
+					for (uint32_t c = left; c <= right; c++) {
+						if ((r != row || c != column) && mines[r][c] != 0) {
+							value++;
+						}
 					}
-					break;
-				default:
-					switch (column) {
-						//left column
-					case 0:
-						board[row - 1][column]++;
-						board[row - 1][column + 1]++;
-						board[row][column + 1]++;
-						board[row + 1][column + 1]++;
-						board[row + 1][column]++;
-						break;
-						//right column
-					case GAMEBOARD_COLUMNS - 1:
-						board[row - 1][column]++;
-						board[row - 1][column - 1]++;
-						board[row][column - 1]++;
-						board[row + 1][column - 1]++;
-						board[row + 1][column]++;
-						break;
-						//not on a side
-					default:
-						board[row - 1][column - 1]++;
-						board[row][column - 1]++;
-						board[row + 1][column - 1]++;
-						board[row - 1][column]++;
-						board[row + 1][column]++;
-						board[row - 1][column + 1]++;
-						board[row][column + 1]++;
-						board[row + 1][column + 1]++;
-						break;
-					}
-					break;
 				}
+				board[row][column] = value;
 			}
 		}
 	};
 	// end of lambda function to be run concurrently
 
-	//declares the threads of the previous lambda function and pushes them into the
-	// vector of threads to ensure later that they will have finished by a certain point
-	for (uint8_t i = 0; i < GAMEBOARD_ROWS; i++) {
-		std::thread t(counter, i, std::ref(gameboard_values));
-		threads.push_back(std::move(t));
+	values.assign(GAMEBOARD_ROWS, std::vector<uint8_t>(GAMEBOARD_COLUMNS, 0));
+	if (threads <= 1) {
+		counter(0, 1, mine_mask, values);
+		return;
+	}
+	for (uint32_t i = 0; i < threads; i++) {
+		std::thread t(counter, i, threads, std::cref(mine_mask), std::ref(values));
+		thread_list.push_back(std::move(t));
+	}
+	for (uint32_t i = 0; i < thread_list.size(); i++) {
+		thread_list[i].join();
+	}
+}
+/*
+* Function: getAttemptSeed
+*
+* Paramters: uint64_t seed,
+*			 uint32_t attempt
+*
+* Return Type: uint64_t
+*
+* Description: returns the seed of a candidate board of the no-guess search. Attempt 0
+*					is the seed itself, the others are taken from streams of the seed
+*					past the streams used by the rows.
+*
+*/
+uint64_t TileManager::getAttemptSeed(uint64_t seed, uint32_t attempt) {
+	if (attempt == 0) {
+		return seed;
+	}
+	RandomStream stream(seed, GAMEBOARD_ROWS + attempt);
+	return stream.next();
+}
+/*
+* Function: setGenerationThreads
+*
+* Paramters: uint32_t threads
+*
+* Return Type: void
+*
+* Description: sets how many threads generate the board and search for a no-guess
+*					board, clamped to between 1 and the number of rows. It does not change
+*					the board a seed generates.
+*
+*/
+void TileManager::setGenerationThreads(uint32_t threads) {
+	generation_threads = std::max(1u, std::min(threads, (uint32_t)GAMEBOARD_ROWS));
+}
+/*
+* Function: getSeed
+*
+* Paramters: none
+*
+* Return Type: uint64_t
+*
+* Description: returns the seed of the current board, passing it to setupMines
+*					and clicking the same first tile recreates the same board
+*
+*/
+uint64_t TileManager::getSeed() const {
+	return board_seed;
+}
+/*
+* Function: setNoGuess
+*
+* Paramters: bool isEnabled
+*
+* Return Type: void
+*
+* Description: sets if the boards generated after the next first click must be winnable
+*					without guessing, see generateBoard()
+*
+*/
+void TileManager::setNoGuess(bool isEnabled) {
+	no_guess = isEnabled;
+}
+/*
+* Function: getGenerationReport
+*
+* Paramters: none
+*
+* Return Type: TileManager::GenerationReport
+*
+* Description: returns how long the current board took to generate and how many candidate
+*					boards were tried, attempts is 0 until the board has been generated
+*
+*/
+TileManager::GenerationReport TileManager::getGenerationReport() const {
+	return generation_report;
+}
+/*
+* Function: takeSnapshot
+*
+* Paramters: none
+*
+* Return Type: BoardSnapshot
+*
+* Description: Returns a snapshot of the game, the mines, what the player sees, the
+*					scoreboard and the seed. A board that is still generating is saved
+*					as not generated.
+*
+*/
+BoardSnapshot TileManager::takeSnapshot() const {
+	BoardSnapshot snapshot(GAMEBOARD_ROWS, GAMEBOARD_COLUMNS, NUM_OF_MINES, board_seed);
+	BoardSnapshot::Header &header = snapshot.editHeader();
+	header.flagsLeft = num_of_flagged;
+	header.time = previous_time;
+	header.isGenerated = (board_status == board_ready) ? 1 : 0;
+	header.firstRow = pending_row;
+	header.firstColumn = pending_column;
+
+	if (board_status == board_ready) {
+		for (uint32_t mine : mine_positions) {
+			snapshot.setMine(mine, true);
+		}
 	}
+	for (uint32_t i = 0; i < GAMEBOARD_ROWS; i++) {
+		for (uint32_t j = 0; j < GAMEBOARD_COLUMNS; j++) {
+			snapshot.setVisibility(j + i * GAMEBOARD_COLUMNS, (BoardSnapshot::tile_visibility)gameboard_isShowing[i][j]);
+		}
+	}
+	return snapshot;
+}
+/*
+* Function: loadSnapshot
+*
+* Paramters: const BoardSnapshot &snapshot
+*
+* Return Type: void
+*
+* Description: Replaces the game with the one in the snapshot, the numbers of the tiles
+*					are counted from the mines and every tile the player saw is shown
+*					again. Throws an Exception if the snapshot is not of a board of the
+*					size and mines this game is built with. Loading a snapshot is not
+*					written to the input log.
+*
+*/
+void TileManager::loadSnapshot(const BoardSnapshot &snapshot) throw(Exception) {
+	try {
+		const BoardSnapshot::Header &header = snapshot.getHeader();
+		if (header.rows != GAMEBOARD_ROWS || header.columns != GAMEBOARD_COLUMNS || header.mines != NUM_OF_MINES) {
+			throw Exception("snapshot is not of a " + std::to_string(GAMEBOARD_ROWS) + "x" + std::to_string(GAMEBOARD_COLUMNS)
+							+ " board with " + std::to_string(NUM_OF_MINES) + " mines", "TileManager.cpp", "loadSnapshot");
+		}
+		resetGame(header.seed);
+		is_logging_game = false;
+		pending_row = header.firstRow;
+		pending_column = header.firstColumn;
 
-	//the following makes a call to a function that sets up the feedback info at the top of the screen
-	setupScoreboard();
-	num_of_flagged = NUM_OF_MINES;
-	updateScoreTiles();
+		if (header.isGenerated != 0) {
+			gameboard_values.assign(GAMEBOARD_ROWS, std::vector<uint8_t>(GAMEBOARD_COLUMNS, 0));
+			for (uint32_t i = 0; i < GAMEBOARD_ROWS; i++) {
+				for (uint32_t j = 0; j < GAMEBOARD_COLUMNS; j++) {
+					if (!snapshot.isMine(j + i * GAMEBOARD_COLUMNS)) {
+						continue;
+					}
+					mine_positions.push_back(j + i * GAMEBOARD_COLUMNS);
+					gameboard_values[i][j] += 10;
+					for (uint32_t r = (i == 0) ? 0 : i - 1; r <= i + 1 && r < GAMEBOARD_ROWS; r++) {
+						for (uint32_t c = (j == 0) ? 0 : j - 1; c <= j + 1 && c < GAMEBOARD_COLUMNS; c++) {
+							if (r != i || c != j) {
+								gameboard_values[r][c]++;
+							}
+						}
+					}
+				}
+			}
+			board_status = board_ready;
+		}
 
-	//ensures that the threads finish here (may not be necessary since it is the end of the file, but
-	//  adding it here in case something needs to be added after this later
-	for (uint8_t i = 0; i < GAMEBOARD_ROWS; i++) {
-		if (threads[i].joinable()) {
-			threads[i].join();
+		//only a generated board can have tiles showing, if a mine is showing the game
+		//	was lost and the other mines are revealed as well
+		std::vector<uint32_t> shown_mines;
+		for (uint32_t i = 0; i < GAMEBOARD_ROWS; i++) {
+			for (uint32_t j = 0; j < GAMEBOARD_COLUMNS; j++) {
+				BoardSnapshot::tile_visibility visibility = snapshot.getVisibility(j + i * GAMEBOARD_COLUMNS);
+				if (visibility == BoardSnapshot::tile_showing && board_status == board_ready) {
+					gameboard_isShowing[i][j] = 2;
+					if (gameboard_values[i][j] < 10) {
+						revealTile(i, j);
+					}
+					else {
+						shown_mines.push_back(j + i * GAMEBOARD_COLUMNS);
+					}
+				}
+				else if (visibility == BoardSnapshot::tile_flagged) {
+					gameboard_isShowing[i][j] = 1;
+					setTileGlyph(j + i * GAMEBOARD_COLUMNS, glyph_flagged);
+				}
+			}
+		}
+		if (!shown_mines.empty()) {
+			is_mine_hit = true;
+			revealMines();
+			setTileGlyphs(shown_mines, glyph_mine_hit);
 		}
+
+		num_of_flagged = static_cast<uint8_t>(std::min(header.flagsLeft, (uint32_t)NUM_OF_MINES));
+		updateScoreTiles();
+		updateTime(header.time);
+	}
+	catch (Exception &excpt) {
+		throw excpt;
+	}
+}
+/*
+* Function: startInputLog
+*
+* Paramters: const std::string &path
+*
+* Return Type: void
+*
+* Description: Starts appending the input to the log at path, beginning with the next
+*					game so that every game in the log can be replayed from its start.
+*					Throws an Exception if the log can not be opened.
+*
+*/
+void TileManager::startInputLog(const std::string &path) throw(Exception) {
+	try {
+		is_logging_game = false;
+		pInputLog = std::make_shared<InputLog>(path, GAMEBOARD_ROWS, GAMEBOARD_COLUMNS, NUM_OF_MINES);
 	}
+	catch (Exception &excpt) {
+		throw excpt;
+	}
+}
+//closes the input log
+void TileManager::stopInputLog() {
+	pInputLog.reset();
 }
 /*
 * Function: processRightClick
@@ -226,18 +629,30 @@ void TileManager::setupMines() {
 *
 */
 void TileManager::processRightClick(float x_coord, float y_coord) {
-	// the if ensures the click happened in the playable area
-	if (x_coord < 0.95f && y_coord < (0.78 + TILE_SIZE) && x_coord >(0.95f - (GAMEBOARD_COLUMNS + 1) * (TILE_SIZE + 0.005f)) && y_coord >(0.78f - GAMEBOARD_ROWS * (TILE_SIZE + 0.005f))) {
-		//the row and column variable as well as the following while loops determine
-		// the tile that was clicked
-		uint32_t row = 0;
-		uint32_t column = 0;
-		while (x_coord < 0.95f - (column + 1) * (TILE_SIZE + 0.005f)) {
-			column++;
-		}
-		while (y_coord < (0.78f + TILE_SIZE + 0.005f) - (row + 1) * (TILE_SIZE + 0.005f)) {
-			row++;
-		}
+	uint32_t row, column;
+	// the if ensures the click happened in the playable area and determines the tile that was clicked
+	if (pickTile(x_coord, y_coord, row, column)) {
+		processRightClick(row, column);
+	}
+}
+/*
+* Function: processRightClick
+*
+* Paramters: uint32_t row,
+*			 uint32_t column
+*
+* Return Type: void
+*
+* Description: the same as processRightClick() for the tile at row and column, used when
+*					the tile was already picked. A tile off the board is ignored
+*
+*/
+void TileManager::processRightClick(uint32_t row, uint32_t column) {
+	if (row < GAMEBOARD_ROWS && column < GAMEBOARD_COLUMNS && pInfiniteBoard) {
+		flagInfinite(row, column);
+	}
+	else if (row < GAMEBOARD_ROWS && column < GAMEBOARD_COLUMNS) {
+		logInput(InputLog::input_right_click, row, column);
 		//this if-else statement determines if the tile has been flagged or not and ignores already revealed tiles
 		// the inside code of each case is similar just whether to make the tile geometry have a flag or not and
 		// whether the mine score at the top of the screen should go down or not
@@ -247,10 +662,7 @@ void TileManager::processRightClick(float x_coord, float y_coord) {
 				updateScoreTiles();
 			}
 			gameboard_isShowing[row][column] = 0;
-
-			unshown_tile_geometry tile;
-			tile.initMesh();
-			pGeometryManager->updateObject((column + row * GAMEBOARD_COLUMNS), tile.vertices, tile.indices);
+			setTileGlyph(column + row * GAMEBOARD_COLUMNS, glyph_unshown);
 		}
 		else if (gameboard_isShowing[row][column] == 0) {
 			if (num_of_flagged > 0) {
@@ -258,10 +670,7 @@ void TileManager::processRightClick(float x_coord, float y_coord) {
 				updateScoreTiles();
 			}
 			gameboard_isShowing[row][column] = 1;
-
-			flagged_tile_geometry tile;
-			tile.initMesh();
-			pGeometryManager->updateObject((column + row * GAMEBOARD_COLUMNS), tile.vertices, tile.indices);
+			setTileGlyph(column + row * GAMEBOARD_COLUMNS, glyph_flagged);
 		}
 	}
 }
@@ -283,67 +692,424 @@ void TileManager::processRightClick(float x_coord, float y_coord) {
 */
 bool TileManager::processLeftClick(float x_coord, float y_coord, bool &validClick) {
 	validClick = false;
-	//this if determines if the click happened on the playbale area
-	if (x_coord < 0.95f && y_coord < (0.78 + TILE_SIZE) && x_coord >(0.95f - (GAMEBOARD_COLUMNS + 1) * (TILE_SIZE + 0.005f)) && y_coord >(0.78f - GAMEBOARD_ROWS * (TILE_SIZE + 0.005f))) {
-		//row and column and the two following while loops calculate the tile clicked
-		uint32_t row = 0;
-		uint32_t column = 0;
-		while (x_coord < 0.95f - (column + 1) * (TILE_SIZE + 0.005f)) {
-			column++;
+	uint32_t row, column;
+	//this if determines if the click happened on the playbale area and calculates the tile clicked
+	if (pickTile(x_coord, y_coord, row, column)) {
+		return processLeftClick(row, column, validClick);
+	}
+	return false;
+}
+/*
+* Function: processLeftClick
+*
+* Paramters: uint32_t row,
+*			 uint32_t column,
+*			 bool &validClick
+*
+* Return Type: bool
+*
+* Description: the same as processLeftClick() for the tile at row and column, used when
+*					the tile was already picked. A tile off the board is ignored
+*
+*/
+bool TileManager::processLeftClick(uint32_t row, uint32_t column, bool &validClick) {
+	validClick = false;
+	if (row < GAMEBOARD_ROWS && column < GAMEBOARD_COLUMNS && pInfiniteBoard) {
+		//the endless board is not generated up front, its chunks are made as they are needed
+		return revealInfinite(row, column, validClick);
+	}
+	if (row < GAMEBOARD_ROWS && column < GAMEBOARD_COLUMNS) {
+		//the first click on an unclicked tile starts generating the board on a worker thread,
+		//	the click is revealed by collectBoard() once the board is ready
+		if (board_status == board_empty && gameboard_isShowing[row][column] == 0) {
+			logInput(InputLog::input_left_click, row, column);
+			pending_row = row;
+			pending_column = column;
+			board_status = board_generating;
+
+			pending_job = std::make_shared<generation_job>();
+			pending_job->seed = board_seed;
+			pending_job->safeRow = row;
+			pending_job->safeColumn = column;
+			pending_job->threads = generation_threads;
+			pending_job->isNoGuess = no_guess;
+			pending_job->cancelled = false;
+			generation = std::async(std::launch::async, &TileManager::generateBoard, pending_job).share();
 		}
-		while (y_coord < (0.78f + TILE_SIZE + 0.005f) - (row + 1) * (TILE_SIZE + 0.005f)) {
-			row++;
+		else if (board_status == board_generating) {
+			//the click is played by collectBoard() once the board is ready, it is logged then
+			queued_clicks.push_back(column + row * GAMEBOARD_COLUMNS);
 		}
+		else if (board_status == board_ready) {
+			logInput(InputLog::input_left_click, row, column);
+			return revealClicked(row, column, validClick);
+		}
+	}
+	return false;
+}
+/*
+* Function: revealClicked
+*
+* Paramters: uint32_t row,
+*			 uint32_t column,
+*			 bool &validClick
+*
+* Return Type: bool
+*
+* Description: Reveals the tile that was left clicked. Returns true if the user lost
+*					and clicked on a mine, otherwise returns false. validClick will be
+*					true if the tile was unclicked, otherwise it will be false.
+*
+*/
+bool TileManager::revealClicked(uint32_t row, uint32_t column, bool &validClick) {
+	//checks if tile is unclicked
+	if (gameboard_isShowing[row][column] == 0) {
+		validClick = true;
+		// the if-else determines if the tile is unshown, a mine, or a blank space
+		if (gameboard_values[row][column] == 0) {
+			// collects all adjacent blank tiles and tiles adjacent to blank
+			// tiles to be revealed from this click. The set pieces will contain
+			// said pieces and will not have duplicates since it is of type std::set
+			std::set<int> pieces = checkBlankPieces(row, column);
+			std::set<int>::iterator it = pieces.begin();
+			//reveals all the tiles in pieces set
+			while (it != pieces.end()) {
+				int num = *it;
+				int r = num / GAMEBOARD_COLUMNS;
+				int c = num % GAMEBOARD_COLUMNS;
 
-		//checks if tile is unclicked
-		if (gameboard_isShowing[row][column] == 0) {
-			validClick = true;
-			// the if-else determines if the tile is unshown, a mine, or a blank space
-			if (gameboard_values[row][column] == 0) {
-				// collects all adjacent blank tiles and tiles adjacent to blank
-				// tiles to be revealed from this click. The set pieces will contain
-				// said pieces and will not have duplicates since it is of type std::set
-				std::set<int> pieces = checkBlankPieces(row, column);
-				std::set<int>::iterator it = pieces.begin();
-				//reveals all the tiles in pieces set
-				while (it != pieces.end()) {
-					int num = *it;
-					int r = num / GAMEBOARD_COLUMNS;
-					int c = num % GAMEBOARD_COLUMNS;
-
-					//calls revealTile if it is not showing to set the new geometric info
-					if (gameboard_isShowing[r][c] == 0) {
-						gameboard_isShowing[r][c] = 2;
-						revealTile(r, c);
-					}
-					it++;
+				//calls revealTile if it is not showing to set the new geometric info
+				if (gameboard_isShowing[r][c] == 0) {
+					gameboard_isShowing[r][c] = 2;
+					revealTile(r, c);
 				}
+				it++;
 			}
-			else if (gameboard_values[row][column] < 10) {
-				//reveals the one tile that is a number tile by calling revealTile()
-				gameboard_isShowing[row][column] = 2;
-				revealTile(row, column);
-			}
-			else {
-				//reveals all the mines by calling revealMines() and revealTile()
-				// returns true because user clicked a mine
-				revealMines();
-				gameboard_isShowing[row][column] = 2;
-				revealTile(row, column);
-				return true;
-			}
+		}
+		else if (gameboard_values[row][column] < 10) {
+			//reveals the one tile that is a number tile by calling revealTile()
+			gameboard_isShowing[row][column] = 2;
+			revealTile(row, column);
+		}
+		else {
+			//reveals all the mines by calling revealMines() and revealTile()
+			// returns true because user clicked a mine
+			is_mine_hit = true;
+			revealMines();
+			gameboard_isShowing[row][column] = 2;
+			revealTile(row, column);
+			return true;
 		}
 	}
 	return false;
 }
 /*
+* Function: revealInfinite
+*
+* Paramters: uint32_t row,
+*			 uint32_t column,
+*			 bool &validClick
+*
+* Return Type: bool
+*
+* Description: revealClicked() for the endless board, reveals the tile of the window at
+*					row and column and every blank tile connected to it, then draws the
+*					window again. Returns true if the tile was a mine
+*
+*/
+bool TileManager::revealInfinite(uint32_t row, uint32_t column, bool &validClick) {
+	int64_t x = window_x + column;
+	int64_t y = window_y + row;
+	if (pInfiniteBoard->getState(x, y) != ChunkedBoard::tile_unshown) {
+		return false;
+	}
+	validClick = true;
+
+	std::vector<ChunkedBoard::Tile> revealed;
+	bool isMine = pInfiniteBoard->reveal(x, y, revealed);
+	if (isMine) {
+		is_mine_hit = true;
+	}
+	drawInfiniteWindow();
+	return isMine;
+}
+/*
+* Function: flagInfinite
+*
+* Paramters: uint32_t row,
+*			 uint32_t column
+*
+* Return Type: void
+*
+* Description: processRightClick() for the endless board, flags or unflags the tile of
+*					the window at row and column. Showing tiles are ignored
+*
+*/
+void TileManager::flagInfinite(uint32_t row, uint32_t column) {
+	int64_t x = window_x + column;
+	int64_t y = window_y + row;
+	pInfiniteBoard->toggleFlag(x, y);
+	setTileGlyph(column + row * GAMEBOARD_COLUMNS, getInfiniteGlyph(x, y));
+}
+/*
+* Function: drawInfiniteWindow
+*
+* Paramters: none
+*
+* Return Type: void
+*
+* Description: sets every tile of the grid to the glyph of the tile of the endless board
+*					it shows, the tiles are batched by glyph for setTileGlyphs()
+*
+*/
+void TileManager::drawInfiniteWindow() {
+	std::vector<std::vector<uint32_t>> glyphTiles(NUM_OF_GLYPHS);
+	for (uint32_t i = 0; i < GAMEBOARD_ROWS; i++) {
+		for (uint32_t j = 0; j < GAMEBOARD_COLUMNS; j++) {
+			glyphTiles[getInfiniteGlyph(window_x + j, window_y + i)].push_back(j + i * GAMEBOARD_COLUMNS);
+		}
+	}
+	for (uint8_t glyph = 0; glyph < NUM_OF_GLYPHS; glyph++) {
+		setTileGlyphs(glyphTiles[glyph], (tile_glyph)glyph);
+	}
+}
+/*
+* Function: getInfiniteGlyph
+*
+* Paramters: int64_t x,
+*			 int64_t y
+*
+* Return Type: tile_glyph
+*
+* Description: returns the glyph of a tile of the endless board the same way revealTile()
+*					does for the normal board, only a showing tile needs its chunk
+*
+*/
+tile_glyph TileManager::getInfiniteGlyph(int64_t x, int64_t y) {
+	ChunkedBoard::tile_state state = pInfiniteBoard->getState(x, y);
+	if (state == ChunkedBoard::tile_unshown) {
+		return glyph_unshown;
+	}
+	else if (state == ChunkedBoard::tile_flagged) {
+		return glyph_flagged;
+	}
+	uint8_t value = pInfiniteBoard->getValue(x, y);
+	return (value < 10) ? (tile_glyph)value : glyph_mine_hit;
+}
+/*
+* Function: pickTile
+*
+* Paramters: float x_coord,
+*			 float y_coord,
+*			 uint32_t &row,
+*			 uint32_t &column
+*
+* Return Type: bool
+*
+* Description: Calculates the tile under the vulkan coordinates passed by inverting
+*					the tile layout used in initGameboard(), so it takes the same time
+*					for any size of board. A tile covers its own area and the gap to the
+*					next tile. Returns false if the coordinates are off the board,
+*					otherwise sets row and column and returns true.
+*
+*/
+bool TileManager::pickTile(float x_coord, float y_coord, uint32_t &row, uint32_t &column) const {
+	const float step = TILE_SIZE + 0.005f;
+	float columnPosition = std::floor((0.95f - x_coord) / step);
+	float rowPosition = std::floor((0.78f + step - y_coord) / step);
+
+	if (columnPosition < 0.0f || columnPosition >= GAMEBOARD_COLUMNS || rowPosition < 0.0f || rowPosition >= GAMEBOARD_ROWS) {
+		return false;
+	}
+	row = static_cast<uint32_t>(rowPosition);
+	column = static_cast<uint32_t>(columnPosition);
+	return true;
+}
+/*
+* Function: getTileCenter
+*
+* Paramters: uint32_t row,
+*			 uint32_t column
+*
+* Return Type: glm::vec2
+*
+* Description: returns the vulkan coordinates of the center of a tile, the inverse of
+*					pickTile(). Used to click a tile without a mouse.
+*
+*/
+glm::vec2 TileManager::getTileCenter(uint32_t row, uint32_t column) const {
+	const float step = TILE_SIZE + 0.005f;
+	return glm::vec2{ 0.95f - (column + 0.5f) * step, 0.78f + step - (row + 0.5f) * step };
+}
+/*
+* Function: followCamera
+*
+* Paramters: glm::vec2 lookAt,		the point of the board the camera looks at
+*			 glm::vec2 viewMin,		the corners of the part of the board on screen, see
+*			 glm::vec2 viewMax		Camera::Frustum::getPlaneBounds()
+*
+* Return Type: glm::vec2
+*
+* Description: For the endless board, moves the window by whole tiles once the tile the
+*					camera looks at is more than INFINITE_WINDOW_SLACK tiles from its center
+*					and returns how far the camera has to move so the same tiles stay on
+*					screen, zero if the window did not move. Then the chunks of the tiles
+*					on screen are generated and the chunks more than a chunk away from the
+*					window are made compact (see ChunkedBoard). Returns zero and does
+*					nothing on the normal board.
+*
+*/
+glm::vec2 TileManager::followCamera(glm::vec2 lookAt, glm::vec2 viewMin, glm::vec2 viewMax) {
+	glm::vec2 shift(0.0f, 0.0f);
+	if (!pInfiniteBoard) {
+		return shift;
+	}
+
+	//the same inverse of the tile layout as pickTile() without its bounds, clamped so a
+	//	point far off the grid does not overflow
+	const float step = TILE_SIZE + 0.005f;
+	auto toColumn = [step](float x) {
+		return static_cast<int64_t>(glm::clamp(std::floor((0.95f - x) / step), -1.0e9f, 1.0e9f));
+	};
+	auto toRow = [step](float y) {
+		return static_cast<int64_t>(glm::clamp(std::floor((0.78f + step - y) / step), -1.0e9f, 1.0e9f));
+	};
+
+	int64_t columnOffset = toColumn(lookAt.x) - GAMEBOARD_COLUMNS / 2;
+	int64_t rowOffset = toRow(lookAt.y) - GAMEBOARD_ROWS / 2;
+	if (std::abs(columnOffset) > INFINITE_WINDOW_SLACK || std::abs(rowOffset) > INFINITE_WINDOW_SLACK) {
+		//a tile moves columnOffset columns towards column 0, which is +x, and rowOffset rows towards row 0, which is +y
+		window_x += columnOffset;
+		window_y += rowOffset;
+		shift = glm::vec2(columnOffset * step, rowOffset * step);
+		drawInfiniteWindow();
+	}
+
+	//the tiles on screen once the camera moved, only the ones in the window are drawn
+	int64_t minColumn = std::max<int64_t>(toColumn(viewMax.x + shift.x), 0);
+	int64_t maxColumn = std::min<int64_t>(toColumn(viewMin.x + shift.x), GAMEBOARD_COLUMNS - 1);
+	int64_t minRow = std::max<int64_t>(toRow(viewMax.y + shift.y), 0);
+	int64_t maxRow = std::min<int64_t>(toRow(viewMin.y + shift.y), GAMEBOARD_ROWS - 1);
+	if (minColumn <= maxColumn && minRow <= maxRow) {
+		pInfiniteBoard->viewRegion(window_x + minColumn, window_y + minRow, window_x + maxColumn, window_y + maxRow);
+	}
+	pInfiniteBoard->evictOutside(window_x - ChunkedBoard::CHUNK_SIZE, window_y - ChunkedBoard::CHUNK_SIZE,
+								 window_x + GAMEBOARD_COLUMNS + ChunkedBoard::CHUNK_SIZE, window_y + GAMEBOARD_ROWS + ChunkedBoard::CHUNK_SIZE);
+	return shift;
+}
+/*
+* Function: isTileShowing
+*
+* Paramters: uint32_t row,
+*			 uint32_t column
+*
+* Return Type: bool
+*
+* Description: returns true if the tile has been revealed
+*
+*/
+bool TileManager::isTileShowing(uint32_t row, uint32_t column) const {
+	return gameboard_isShowing[row][column] == 2;
+}
+/*
+* The next two functions return how the game ended, won is true once every tile
+*		that is not a mine is showing, lost is true once a mine was revealed
+*
+*/
+bool TileManager::isWon() const {
+	return !pInfiniteBoard && num_of_revealed == (GAMEBOARD_ROWS * GAMEBOARD_COLUMNS) - NUM_OF_MINES;
+}
+
+bool TileManager::isLost() const {
+	return is_mine_hit;
+}
+/*
+* Function: getHint
+*
+* Paramters: none
+*
+* Return Type: BoardSolver::Hint
+*
+* Description: Runs the BoardSolver on the tiles the player can see and returns the
+*					move it suggests, found is false until the board has been generated.
+*					The cell of the hint is indexed as column + row * GAMEBOARD_COLUMNS.
+*
+*/
+BoardSolver::Hint TileManager::getHint() const {
+	BoardSolver::Hint hint = { false, 0, false, false, 1.0f };
+	if (board_status != board_ready) {
+		return hint;
+	}
+	BoardSolver solver(GAMEBOARD_ROWS, GAMEBOARD_COLUMNS, NUM_OF_MINES);
+	solver.setBoard(getVisibleBoard());
+	solver.solve();
+	return solver.getHint();
+}
+/*
+* Function: applyHint
+*
+* Paramters: bool &validClick
+*
+* Return Type: bool
+*
+* Description: Plays the move suggested by getHint(), a tile that is certainly a mine is
+*					flagged, any other tile is revealed as if it was left clicked. Returns
+*					true if the revealed tile was a mine, which can only happen on a guess.
+*					validClick is set the same as in processLeftClick().
+*
+*/
+bool TileManager::applyHint(bool &validClick) {
+	validClick = false;
+	BoardSolver::Hint hint = getHint();
+	if (!hint.found) {
+		return false;
+	}
+	logInput(InputLog::input_hint, 0, 0);
+	uint32_t row = hint.cell / GAMEBOARD_COLUMNS;
+	uint32_t column = hint.cell % GAMEBOARD_COLUMNS;
+	if (hint.isMine) {
+		if (num_of_flagged > 0) {
+			num_of_flagged--;
+			updateScoreTiles();
+		}
+		gameboard_isShowing[row][column] = 1;
+		setTileGlyph(hint.cell, glyph_flagged);
+		return false;
+	}
+	return revealClicked(row, column, validClick);
+}
+/*
+* Function: isNoGuessBoard
+*
+* Paramters: none
+*
+* Return Type: bool
+*
+* Description: Checks the quality of the current board, returns true if it can be won
+*					from the first click without guessing. Returns false until the board
+*					has been generated.
+*
+*/
+bool TileManager::isNoGuessBoard() const {
+	if (board_status != board_ready) {
+		return false;
+	}
+	std::vector<uint8_t> values;
+	values.reserve(GAMEBOARD_ROWS * GAMEBOARD_COLUMNS);
+	for (const std::vector<uint8_t> &row : gameboard_values) {
+		values.insert(values.end(), row.begin(), row.end());
+	}
+	return BoardSolver::isNoGuess(GAMEBOARD_ROWS, GAMEBOARD_COLUMNS, NUM_OF_MINES, values, pending_column + pending_row * GAMEBOARD_COLUMNS);
+}
+/*
 * Function: updateTime
 *
 * Paramters: int time
 *
 * Return Type: bool
 *
-* Description: Updates the timer in the top right of the screen if a second has passed.
+* Description: Updates the timer in the top right of the screen if the time changed since
+*					it was last shown, returns true if the tiles were updated.
 *					If the size of the board changes the indices passed to updateTile
 *					need to changed accordingly.
 *
@@ -358,11 +1124,12 @@ bool TileManager::updateTime(int time) {
 		hundreds_place /= 100;
 		tens_place /= 10;
 
-		//the indices in the GeometryManager are 579, 580, and 581 for the timer square
-		updateTile(hundreds_place, 579);
-		updateTile(tens_place, 580);
-		updateTile(ones_place, 581);
+		//the timer tiles are the last three scoreboard tiles in the GeometryManager
+		updateTile(hundreds_place, scoreboard_index + 3);
+		updateTile(tens_place, scoreboard_index + 4);
+		updateTile(ones_place, scoreboard_index + 5);
 
+		previous_time = time;
 		return true;
 	}
 	return false;
@@ -377,14 +1144,56 @@ Geometry::GeometryManager TileManager::getGeometryInfo() const {
 	return *pGeometryManager;
 }
 
+Geometry::InstancedGrid* TileManager::getBoardGrid() const {
+	return pBoardGrid;
+}
+
 std::vector<glm::mat4> TileManager::getUniformMatrices() const {
 	return uniformMatrices;
 }
 
+/*
+* The next two functions track if the GeometryManager changed since the
+*		vertex and index buffers were last updated in the window class
+*
+*/
+bool TileManager::isGeometryChanged() const {
+	return geometryChanged;
+}
+
+void TileManager::resetGeometryChanged() {
+	geometryChanged = false;
+}
+
 //************************************************
 //END OF PUBLIC METHODS, START OF PRIVATE METHODS*
 //************************************************
 
+/*
+* Function: logInput
+*
+* Paramters: InputLog::input_action action,
+*			 uint32_t row,
+*			 uint32_t column
+*
+* Return Type: void
+*
+* Description: appends the input to the log if one was started, the input of a game
+*					that began before the log was started is not logged
+*
+*/
+void TileManager::logInput(InputLog::input_action action, uint32_t row, uint32_t column) {
+	if (pInputLog == nullptr) {
+		return;
+	}
+	if (action == InputLog::input_new_game || action == InputLog::input_new_no_guess_game) {
+		is_logging_game = true;
+	}
+	if (is_logging_game) {
+		std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - game_start;
+		pInputLog->append(action, row, column, static_cast<uint32_t>(elapsed.count()));
+	}
+}
 /*
 * Function: initGameboard
 *
@@ -394,16 +1203,17 @@ std::vector<glm::mat4> TileManager::getUniformMatrices() const {
 *
 * Description: Initializes the gameboard tiles to have the unshown_tile_geometry
 *				and sets each corresponding uniform matrix to position each tile evenly
+*				If the board is instanced every tile's state is set to unshown instead
 *
 */
 void TileManager::initGameboard() {
+	if (pBoardGrid != nullptr) {
+		pBoardGrid->fill(glyph_unshown);
+		return;
+	}
 	for (uint32_t i = 0; i < GAMEBOARD_ROWS; i++) {
-		std::vector<uint8_t> row = gameboard_values[i];
 		for (uint32_t j = 0; j < GAMEBOARD_COLUMNS; j++) {
-			unshown_tile_geometry tile;
-			tile.initMesh();
-			pGeometryManager->addObject(tile.vertices, tile.indices);
-
+			pGeometryManager->addObject(glyph_unshown);
 
 			float xPos = 0.95f - j * (TILE_SIZE + 0.005f);
 			float yPos = 0.78f - i * (TILE_SIZE + 0.005f);
@@ -417,6 +1227,32 @@ void TileManager::initGameboard() {
 	}
 }
 /*
+* Function: getVisibleBoard
+*
+* Paramters: none
+*
+* Return Type: std::vector<uint8_t>
+*
+* Description: Returns the board as the player sees it in the format of
+*					BoardSolver::setBoard(), showing tiles are their number of adjacent
+*					mines and the other tiles are unknown or flagged
+*
+*/
+std::vector<uint8_t> TileManager::getVisibleBoard() const {
+	std::vector<uint8_t> board(GAMEBOARD_ROWS * GAMEBOARD_COLUMNS, BoardSolver::CELL_UNKNOWN);
+	for (uint32_t i = 0; i < GAMEBOARD_ROWS; i++) {
+		for (uint32_t j = 0; j < GAMEBOARD_COLUMNS; j++) {
+			if (gameboard_isShowing[i][j] == 2) {
+				board[j + i * GAMEBOARD_COLUMNS] = gameboard_values[i][j];
+			}
+			else if (gameboard_isShowing[i][j] == 1) {
+				board[j + i * GAMEBOARD_COLUMNS] = BoardSolver::CELL_FLAGGED;
+			}
+		}
+	}
+	return board;
+}
+/*
 * Function: revealTile
 *
 * Paramters: uint8_t row,
@@ -424,64 +1260,62 @@ void TileManager::initGameboard() {
 *
 * Return Type: void
 *
-* Description: Uses the parameters to calculate the position of the tile in the pGeometryManager
-*					and to find the correct type of tile to set this tile based on the current value
-*					in the gameboard_values matrix.
-*					Also, here is used an if-else instead of switch because the new geometry must be
-*					defined locally in each case to update the new tile geometry, which is not allowed
-*					in a switch statement.
+* Description: Uses the parameters to calculate the position of the tile on the board
+*					and sets the tile's glyph based on the current value in the
+*					gameboard_values matrix. Values below 10 are the number of adjacent
+*					mines and match the glyph, anything else is a mine.
 *
 */
 void TileManager::revealTile(uint8_t row, uint8_t column) {
-	if (gameboard_values[row][column] == 0) {
-		blank_tile_geometry tile;
-		tile.initMesh();
-		pGeometryManager->updateObject((column + row * GAMEBOARD_COLUMNS), tile.vertices, tile.indices);
-	}
-	else if (gameboard_values[row][column] == 1) {
-		adjacent_one_tile_geometry tile;
-		tile.initMesh();
-		pGeometryManager->updateObject((column + row * GAMEBOARD_COLUMNS), tile.vertices, tile.indices);
-	}
-	else if (gameboard_values[row][column] == 2) {
-		adjacent_two_tile_geometry tile;
-		tile.initMesh();
-		pGeometryManager->updateObject((column + row * GAMEBOARD_COLUMNS), tile.vertices, tile.indices);
-	}
-	else if (gameboard_values[row][column] == 3) {
-		adjacent_three_tile_geometry tile;
-		tile.initMesh();
-		pGeometryManager->updateObject((column + row * GAMEBOARD_COLUMNS), tile.vertices, tile.indices);
-	}
-	else if (gameboard_values[row][column] == 4) {
-		adjacent_four_tile_geometry tile;
-		tile.initMesh();
-		pGeometryManager->updateObject((column + row * GAMEBOARD_COLUMNS), tile.vertices, tile.indices);
-	}
-	else if (gameboard_values[row][column] == 5) {
-		adjacent_five_tile_geometry tile;
-		tile.initMesh();
-		pGeometryManager->updateObject((column + row * GAMEBOARD_COLUMNS), tile.vertices, tile.indices);
-	}
-	else if (gameboard_values[row][column] == 6) {
-		adjacent_six_tile_geometry tile;
-		tile.initMesh();
-		pGeometryManager->updateObject((column + row * GAMEBOARD_COLUMNS), tile.vertices, tile.indices);
-	}
-	else if (gameboard_values[row][column] == 7) {
-		adjacent_seven_tile_geometry tile;
-		tile.initMesh();
-		pGeometryManager->updateObject((column + row * GAMEBOARD_COLUMNS), tile.vertices, tile.indices);
-	}
-	else if (gameboard_values[row][column] == 8) {
-		adjacent_eight_tile_geometry tile;
-		tile.initMesh();
-		pGeometryManager->updateObject((column + row * GAMEBOARD_COLUMNS), tile.vertices, tile.indices);
+	uint8_t value = gameboard_values[row][column];
+	if (value < 10) {
+		num_of_revealed++;
+	}
+	setTileGlyph(column + row * GAMEBOARD_COLUMNS, (value < 10) ? (tile_glyph)value : glyph_mine_hit);
+}
+/*
+* Function: setTileGlyph
+*
+* Paramters: uint32_t index,
+*			 tile_glyph glyph
+*
+* Return Type: void
+*
+* Description: Changes the tile at index (column + row * GAMEBOARD_COLUMNS) to show the glyph.
+*					For the instanced board this only writes the tile's state byte, otherwise
+*					the tile's object in the pGeometryManager is pointed at the glyph's mesh.
+*
+*/
+void TileManager::setTileGlyph(uint32_t index, tile_glyph glyph) {
+	if (pBoardGrid != nullptr) {
+		pBoardGrid->setState(index, glyph);
 	}
 	else {
-		mine_hit_tile_geometry tile;
-		tile.initMesh();
-		pGeometryManager->updateObject((column + row * GAMEBOARD_COLUMNS), tile.vertices, tile.indices);
+		pGeometryManager->updateObject(index, glyph);
+		geometryChanged = true;
+	}
+}
+/*
+* Function: setTileGlyphs
+*
+* Paramters: const std::vector<uint32_t> &indices,
+*			 tile_glyph glyph
+*
+* Return Type: void
+*
+* Description: Changes every tile in indices to show the glyph as one batched update,
+*					the offsets in the pGeometryManager are only recalculated once.
+*
+*/
+void TileManager::setTileGlyphs(const std::vector<uint32_t> &indices, tile_glyph glyph) {
+	if (pBoardGrid != nullptr) {
+		for (uint32_t index : indices) {
+			pBoardGrid->setState(index, glyph);
+		}
+	}
+	else if (!indices.empty()) {
+		pGeometryManager->updateObjects(indices, glyph);
+		geometryChanged = true;
 	}
 }
 /*
@@ -574,24 +1408,13 @@ std::set<int> TileManager::checkBlankPieces(uint8_t row, uint8_t column) {
 *
 */
 void TileManager::setupScoreboard() {
-	adjacent_one_tile_geometry one_tile;
-	one_tile.initMesh();
-	adjacent_two_tile_geometry two_tile;
-	two_tile.initMesh();
-	adjacent_five_tile_geometry five_tile;
-	five_tile.initMesh();
-
-	zero_tile_geometry zero_tile;
-	zero_tile.initMesh();
+	pGeometryManager->addObject(glyph_one);		//index == scoreboard_index
+	pGeometryManager->addObject(glyph_two);		//index == scoreboard_index + 1
+	pGeometryManager->addObject(glyph_five);	//index == scoreboard_index + 2
 
-
-	pGeometryManager->addObject(one_tile.vertices, one_tile.indices);		//index == 576
-	pGeometryManager->addObject(two_tile.vertices, two_tile.indices);		//index == 577
-	pGeometryManager->addObject(five_tile.vertices, five_tile.indices);		//index == 578
-
-	pGeometryManager->addObject(zero_tile.vertices, zero_tile.indices);		//index == 579
-	pGeometryManager->addObject(zero_tile.vertices, zero_tile.indices);		//index == 580
-	pGeometryManager->addObject(zero_tile.vertices, zero_tile.indices);		//index == 581
+	pGeometryManager->addObject(glyph_zero);	//index == scoreboard_index + 3
+	pGeometryManager->addObject(glyph_zero);	//index == scoreboard_index + 4
+	pGeometryManager->addObject(glyph_zero);	//index == scoreboard_index + 5
 
 	float xPosition = 0.85f;
 	float yPosition = 0.90f;
@@ -649,44 +1472,13 @@ void TileManager::setupScoreboard() {
 *
 * Return Type: void
 *
-* Description: Searches the gameboard for all the mines and displays the mines with
-*					gray backgrounds.
-*				Declares and defines the lambda reveal that searches the board row by
-*					row and logs the mines found into a std::deque object. This lambda
-*					will be the threaded function to search the gameboard row by row.
-*					Since the board's rows do not overlap, this will be thread safe.
+* Description: Displays all the mines with gray backgrounds. The mines are not searched
+*					for, their positions are logged in mine_positions when the board is
+*					generated, so all of them are changed in one batched update.
 *
 */
 void TileManager::revealMines() {
-	//defines the lambda as described in the function's description
-	auto reveal = [](std::deque<int> &pieces, int row, std::vector<std::vector<uint8_t>> board) {
-		for (int column = 0; column < GAMEBOARD_COLUMNS; column++) {
-			if (board[row][column] > 9) {
-				pieces.push_back(column + row * GAMEBOARD_COLUMNS);
-			}
-		}
-	};
-	//pieces will be used to log all the mine tiles to be revealed
-	std::deque<int> pieces;
-
-	// the following creates, runs and ensures the threads using the reveal lambda have finished
-	//   before the final while loop goes through each tile in the deque to reveal the found mines
-	std::vector<std::thread> threads;
-	for (uint8_t row = 0; row < GAMEBOARD_ROWS; row++) {
-		std::thread t(reveal, std::ref(pieces), row, gameboard_values);
-		threads.push_back(std::move(t));
-	}
-	for (uint8_t i = 0; i < GAMEBOARD_ROWS; i++) {
-		if (threads[i].joinable()) {
-			threads[i].join();
-		}
-	}
-	while (!pieces.empty()) {
-		mine_reveal_tile_geometry tile;
-		tile.initMesh();
-		pGeometryManager->updateObject(pieces.front(), tile.vertices, tile.indices);
-		pieces.pop_front();
-	}
+	setTileGlyphs(mine_positions, glyph_mine_reveal);
 }
 /*
 * Function: updateScoreTiles
@@ -705,24 +1497,20 @@ void TileManager::revealMines() {
 void TileManager::updateScoreTiles() {
 	int flagged = num_of_flagged;
 
-	//mine tracking tiles are indexed 576, 577, and 578 in the geometry manager
+	//mine tracking tiles are the first three scoreboard tiles in the geometry manager
 	if (flagged >= 100) {
-		adjacent_one_tile_geometry tile;
-		tile.initMesh();
-		pGeometryManager->updateObject(576, tile.vertices, tile.indices);
+		updateTile(1, scoreboard_index);
 		flagged -= 100;
 	}
 	else {
-		zero_tile_geometry tile;
-		tile.initMesh();
-		pGeometryManager->updateObject(576, tile.vertices, tile.indices);
+		updateTile(0, scoreboard_index);
 	}
 	int ones_place = flagged % 10;
 	int tens_place = flagged - ones_place;
 	tens_place /= 10;
 
-	updateTile(tens_place, 577);
-	updateTile(ones_place, 578);
+	updateTile(tens_place, scoreboard_index + 1);
+	updateTile(ones_place, scoreboard_index + 2);
 }
 /*
 * Function: updateTile
@@ -739,54 +1527,8 @@ void TileManager::updateScoreTiles() {
 *
 */
 void TileManager::updateTile(int test_num, int index) {
-	if (test_num == 0) {
-		zero_tile_geometry tile;
-		tile.initMesh();
-		pGeometryManager->updateObject(index, tile.vertices, tile.indices);
-	}
-	else if (test_num == 1) {
-		adjacent_one_tile_geometry tile;
-		tile.initMesh();
-		pGeometryManager->updateObject(index, tile.vertices, tile.indices);
-	}
-	else if (test_num == 2) {
-		adjacent_two_tile_geometry tile;
-		tile.initMesh();
-		pGeometryManager->updateObject(index, tile.vertices, tile.indices);
-	}
-	else if (test_num == 3) {
-		adjacent_three_tile_geometry tile;
-		tile.initMesh();
-		pGeometryManager->updateObject(index, tile.vertices, tile.indices);
-	}
-	else if (test_num == 4) {
-		adjacent_four_tile_geometry tile;
-		tile.initMesh();
-		pGeometryManager->updateObject(index, tile.vertices, tile.indices);
-	}
-	else if (test_num == 5) {
-		adjacent_five_tile_geometry tile;
-		tile.initMesh();
-		pGeometryManager->updateObject(index, tile.vertices, tile.indices);
-	}
-	else if (test_num == 6) {
-		adjacent_six_tile_geometry tile;
-		tile.initMesh();
-		pGeometryManager->updateObject(index, tile.vertices, tile.indices);
-	}
-	else if (test_num == 7) {
-		adjacent_seven_tile_geometry tile;
-		tile.initMesh();
-		pGeometryManager->updateObject(index, tile.vertices, tile.indices);
-	}
-	else if (test_num == 8) {
-		adjacent_eight_tile_geometry tile;
-		tile.initMesh();
-		pGeometryManager->updateObject(index, tile.vertices, tile.indices);
-	}
-	else if (test_num == 9) {
-		nine_tile_geometry tile;
-		tile.initMesh();
-		pGeometryManager->updateObject(index, tile.vertices, tile.indices);
+	if (test_num >= 0 && test_num <= 9) {
+		pGeometryManager->updateObject(index, getDigitGlyph(test_num));
+		geometryChanged = true;
 	}
 }
\ No newline at end of file
@@ -11,6 +11,15 @@
 #pragma once
 #include "stdafx.h"
 #include "TileGeometry.h"
+#include "InstancedGrid.h"
+#include "RandomStream.h"
+#include "BoardSolver.h"
+#include "BoardSnapshot.h"
+#include "ChunkedBoard.h"
+#include "InputLog.h"
+#include <future>
+#include <atomic>
+#include <memory>
 
 #define GAMEBOARD_ROWS 24
 #define GAMEBOARD_COLUMNS 24
@@ -18,40 +27,182 @@
 
 #define NUM_OF_MINES 120
 
+// when true the gameboard tiles are drawn as one InstancedGrid with a state byte
+//	per tile, otherwise every tile is a separate object in the GeometryManager
+#define INSTANCED_BOARD true
+
+// when true only boards that can be won from the first click without guessing are
+//	played, candidate boards are generated and checked by the BoardSolver in parallel
+//	until one passes or MAX_GENERATION_ATTEMPTS boards have been tried
+#define NO_GUESS_BOARD true
+#define MAX_GENERATION_ATTEMPTS 10000
+
+// the endless board started by setupInfiniteBoard() is a ChunkedBoard with this many mines
+//	in every chunk, the grid shows a window of GAMEBOARD_ROWS x GAMEBOARD_COLUMNS of its tiles
+//	that moves once the camera is more than INFINITE_WINDOW_SLACK tiles from its center
+#define INFINITE_MINES_PER_CHUNK (ChunkedBoard::CHUNK_CELLS / 5)
+#define INFINITE_WINDOW_SLACK 2
+
 class TileManager {
 public:
+	// how the current board was generated, see getGenerationReport()
+	struct GenerationReport {
+		bool isNoGuess;				//true if the board was checked to be winnable without guessing
+		uint32_t attempts;			//the number of candidate boards generated, in every thread
+		uint32_t winningAttempt;	//the index of the candidate that was played
+		double milliseconds;		//the time from the first click until the board was ready
+	};
+
 	TileManager();
 	~TileManager();
 
 	void setupMines();
+	void setupMines(uint64_t seed);
+	void setupInfiniteBoard(uint64_t seed);
+	bool isInfinite() const;
+	glm::vec2 followCamera(glm::vec2 lookAt, glm::vec2 viewMin, glm::vec2 viewMax);
+	void setGenerationThreads(uint32_t threads);
+	void setNoGuess(bool isEnabled);
+	uint64_t getSeed() const;
+	GenerationReport getGenerationReport() const;
+
+	BoardSnapshot takeSnapshot() const;
+	void loadSnapshot(const BoardSnapshot &snapshot) throw(Exception);
+	void startInputLog(const std::string &path) throw(Exception);
+	void stopInputLog();
 
 	void processRightClick(float x_coord, float y_coord);
+	void processRightClick(uint32_t row, uint32_t column);
 
 	bool processLeftClick(float x_coord, float y_coord, bool &validClick);
+	bool processLeftClick(uint32_t row, uint32_t column, bool &validClick);
+	bool collectBoard(bool &validClick);
+	bool isGenerating() const;
+	bool pickTile(float x_coord, float y_coord, uint32_t &row, uint32_t &column) const;
+	glm::vec2 getTileCenter(uint32_t row, uint32_t column) const;
+	bool isTileShowing(uint32_t row, uint32_t column) const;
+	bool isWon() const;
+	bool isLost() const;
+	BoardSolver::Hint getHint() const;
+	bool applyHint(bool &validClick);
+	bool isNoGuessBoard() const;
 	bool updateTime(int time);
 
 	Geometry::GeometryManager getGeometryInfo() const;
+	Geometry::InstancedGrid* getBoardGrid() const;
 	std::vector<glm::mat4> getUniformMatrices() const;
 
+	bool isGeometryChanged() const;
+	void resetGeometryChanged();
+
 private:
 	//if entry is >= 10 then it is a mine, 
 	//	otherwise it is equal to the number of adjacent tiles
 	std::vector<std::vector<uint8_t>> gameboard_values;
 
+	// the board is generated after the first click into a generation_job on a worker
+	//	thread, collectBoard() swaps it with gameboard_values once it is done
+	enum generation_status {
+		board_empty,
+		board_generating,
+		board_ready
+	};
+	generation_status board_status = board_empty;
+
+	// the index (column + row * GAMEBOARD_COLUMNS) of every mine, in row order
+	std::vector<uint32_t> mine_positions;
+	uint32_t pending_row = 0;
+	uint32_t pending_column = 0;
+
+	// everything a worker reads and writes while it generates a board. Every generation
+	//	has its own job, so a reset only sets cancelled and moves on: the worker of a
+	//	cancelled job finishes on its own and never writes to the board of the next game
+	struct generation_job {
+		uint64_t seed;
+		uint32_t safeRow;
+		uint32_t safeColumn;
+		uint32_t threads;
+		bool isNoGuess;
+		std::atomic<bool> cancelled;
+		std::vector<std::vector<uint8_t>> values;
+		std::vector<uint32_t> mines;
+		GenerationReport report;
+	};
+	// the job and worker of the current game, the job is shared so the TileManager stays copyable
+	std::shared_ptr<generation_job> pending_job;
+	std::shared_future<void> generation;
+	// the workers of cancelled games that are still running, dropped once they finish
+	//	since releasing the last future of a running worker would wait for it
+	std::vector<std::shared_future<void>> cancelled_generations;
+	// the tiles (column + row * GAMEBOARD_COLUMNS) left clicked while the board was
+	//	generating, they are played in order once it is collected
+	std::vector<uint32_t> queued_clicks;
+
+	bool no_guess = NO_GUESS_BOARD;
+	GenerationReport generation_report = { false, 0, 0, 0.0 };
+
+	// the log of the input, nullptr unless startInputLog() was called. It is shared
+	//	for the same reason as pending_job
+	std::shared_ptr<InputLog> pInputLog;
+
+	// the endless board, nullptr unless setupInfiniteBoard() was called. The tile at row 0
+	//	and column 0 of the grid is the tile (window_x, window_y) of the endless board. It
+	//	is shared for the same reason as pending_job
+	std::shared_ptr<ChunkedBoard> pInfiniteBoard;
+	int64_t window_x = 0;
+	int64_t window_y = 0;
+	std::chrono::steady_clock::time_point game_start;
+	bool is_logging_game = false;
+
 	// entry == 0 for unshown, 
 	//		 == 1 for flagged, 
 	//		 == 2 for showing
 	uint8_t gameboard_isShowing[GAMEBOARD_ROWS][GAMEBOARD_COLUMNS] = { 0 };
 
 	uint8_t num_of_flagged;
+
+	// the number of tiles showing that are not mines, the game is won once every
+	//	tile that is not a mine is showing
+	uint32_t num_of_revealed = 0;
+	bool is_mine_hit = false;
+
+	// the seed of the current board and the number of threads that place the mines,
+	//	the same seed gives the same board for any number of threads
+	uint64_t board_seed = 0;
+	uint32_t generation_threads = 1;
 	int previous_time = 0;
 
 	Geometry::GeometryManager * pGeometryManager;
 	std::vector<glm::mat4> uniformMatrices;
 
+	// only used if INSTANCED_BOARD is true, otherwise it is nullptr
+	Geometry::InstancedGrid * pBoardGrid;
+
+	// the index of the first scoreboard tile in the pGeometryManager, the board tiles
+	//	come before it unless the board is instanced
+	uint32_t scoreboard_index;
+
+	// true when the pGeometryManager has changed and the vertex buffers need to be updated
+	bool geometryChanged = true;
 
+
+	void resetGame(uint64_t seed);
+	void logInput(InputLog::input_action action, uint32_t row, uint32_t column);
 	void initGameboard();
+	std::vector<uint8_t> getVisibleBoard() const;
+	void dropCancelledGenerations();
+	static void generateBoard(std::shared_ptr<generation_job> job);
+	static void buildBoard(uint64_t seed, uint32_t safeRow, uint32_t safeColumn, uint32_t threads,
+						   std::vector<std::vector<uint8_t>> &values, std::vector<uint32_t> &mines);
+	static uint64_t getAttemptSeed(uint64_t seed, uint32_t attempt);
+	bool revealClicked(uint32_t row, uint32_t column, bool &validClick);
+	bool revealInfinite(uint32_t row, uint32_t column, bool &validClick);
+	void flagInfinite(uint32_t row, uint32_t column);
+	void drawInfiniteWindow();
+	tile_glyph getInfiniteGlyph(int64_t x, int64_t y);
 	void revealTile(uint8_t row, uint8_t column);
+	void setTileGlyph(uint32_t index, tile_glyph glyph);
+	void setTileGlyphs(const std::vector<uint32_t> &indices, tile_glyph glyph);
 	std::set<int> checkBlankPieces(uint8_t row, uint8_t column);
 	void setupScoreboard();
 	void revealMines();
@@ -59,57 +210,40 @@ private:
 	void updateTile(int test_num, int index);
 
 	// the following struct row_assignment is the callable object used
-	//  for multithreading purposes in the TileManager::setupMines() function
-	//  because rand() is not thread safe each thread should have its own
-	//  buffer of random numbers. this object will generate a row of values
-	//  of type uint8_t that will be pushed into the gameboard_values 
-	//	class member variable.
+	//  for multithreading purposes in the TileManager::setupMines() function.
+	//  Each thread places the mines of the rows firstRow, firstRow + rowStride, ...
+	//  Every row picks its mine columns with a partial Fisher-Yates shuffle on its
+	//  own RandomStream, so a row is the same no matter which thread places it.
+	//  The tile at (safeRow, safeColumn) and its neighbors are never picked.
+	//  The index of each mine placed is also logged in the row's entry of rowMines.
 	struct row_assignment {
-		int random_nums[100];
-		std::vector<uint8_t> local_row;
-
-		//the constructor init's the row vector with zeros and generates the
-		//	buffer of random int's
-		row_assignment() {
-			for (uint8_t j = 0; j < 100; j++) {
-				random_nums[j] = rand() % 100;
-			}
-			for (uint8_t j = 0; j < GAMEBOARD_COLUMNS; j++) {
-				local_row.push_back(0);
-			}
-		}
-
-		//this function takes in the number of mines for this row and randomly
-		//	generates the mine positions in this row before pushing it into the
-		//  board object which is passed by reference
-
-		//	Note that since everything is randomly generated and the rows do 
-		//  not overlap this is thread-safe
-		void operator()(int numMines, std::vector<std::vector<uint8_t>> &board) {
-			int mines_assigned = 0;
-			int column = 0;
-			int buffer_count = 0;
-
-			//go until all mines have been assigned
-			while (mines_assigned != numMines) {
-				if (local_row[column] != 10) {
-					//85 can be changed, it is the bottom limit to determine
-					// likelyhood of mine placement
-					if (random_nums[buffer_count] > 85) {
-						local_row[column] = 10;
-						mines_assigned++;
-					}
-					buffer_count++;
-					if (buffer_count == 100) {
-						buffer_count = 0;
+		//Note that every thread writes to different rows of the board and rowMines, which
+		//	are sized before the threads start, so this is thread-safe
+		void operator()(uint64_t seed, uint32_t firstRow, uint32_t rowStride, uint32_t safeRow, uint32_t safeColumn,
+						const uint32_t *minesPerRow, std::vector<std::vector<uint8_t>> &board,
+						std::vector<std::vector<uint32_t>> &rowMines) {
+			for (uint32_t row = firstRow; row < GAMEBOARD_ROWS; row += rowStride) {
+				//stream 0 of the seed splits the mines between the rows, so row n uses stream n + 1
+				RandomStream stream(seed, row + 1);
+				bool isSafeRow = (row + 1 >= safeRow && row <= safeRow + 1);
+				uint32_t columns[GAMEBOARD_COLUMNS];
+				uint32_t open = 0;
+				for (uint32_t j = 0; j < GAMEBOARD_COLUMNS; j++) {
+					if (!isSafeRow || j + 1 < safeColumn || j > safeColumn + 1) {
+						columns[open++] = j;
 					}
 				}
-				column++;
-				if (column == GAMEBOARD_COLUMNS) {
-					column = 0;
+				for (uint32_t i = 0; i < minesPerRow[row]; i++) {
+					uint32_t pick = i + stream.nextBelow(open - i);
+					std::swap(columns[i], columns[pick]);
+					board[row][columns[i]] = 10;
+				}
+				rowMines[row].assign(columns, columns + minesPerRow[row]);
+				std::sort(rowMines[row].begin(), rowMines[row].end());
+				for (uint32_t &column : rowMines[row]) {
+					column += row * GAMEBOARD_COLUMNS;
 				}
 			}
-			board.push_back(local_row);
 		}
 	};
 };
\ No newline at end of file
@@ -8,13 +8,15 @@
 // (in this instance these variables need to be static as they 
 //  will be called in the callback functions)
 Clock Window::timer = Clock();
+FrameScheduler Window::scheduler = FrameScheduler();
+InputQueue Window::input_queue;
 int Window::user_id = -1;
 double Window::xPosition = 0.0;
 double Window::yPosition = 0.0;
-bool Window::isMouseDown = false;
-bool Window::isLeftClick = true;
+bool Window::isCameraReset = false;
+double Window::scrollOffset = 0.0;
 gameState Window::state = ready;
-clock_t Window::game_time = 0.0f;
+std::chrono::steady_clock::time_point Window::game_time = std::chrono::steady_clock::now();
 
 /*
 * Constructor
@@ -39,6 +41,9 @@ Window::Window() throw(Exception) {
 		glfwSetCursorPosCallback(pWindow, mouse_position_callback);
 		glfwSetInputMode(pWindow, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
 		glfwSetMouseButtonCallback(pWindow, mouse_click_callback);
+		glfwSetScrollCallback(pWindow, scroll_callback);
+		glfwSetWindowRefreshCallback(pWindow, window_refresh_callback);
+		glfwSetFramebufferSizeCallback(pWindow, framebuffer_size_callback);
 	}
 	catch (Exception &excpt) {
 		throw excpt;
@@ -59,92 +64,208 @@ Window::~Window() {
 *
 * Return Type: void
 *
-* Description: runs the main game loop
+* Description: runs the main game loop. The loop sleeps in the FrameScheduler until
+*				something happens and a frame is only drawn if something that is
+*				drawn changed, so an idle board uses no cpu or gpu time. The
+*				scoreboard clock is a timer of the TimerService that wakes the
+*				loop on every whole second of the game. The input that arrived
+*				while the loop slept is drained from the InputQueue and handled
+*				in order, every click is played
 *
 */
 void Window::runGame() throw(Exception) {
 	try {
 		GameBoard = TileManager();
+		GameBoard.startInputLog(INPUT_LOG_PATH);
 		GameBoard.setupMines();
 
 		Geometry::GeometryManager offsets = GameBoard.getGeometryInfo();
-		renderer.initVulkan(pWindow, offsets);
+		renderer.initVulkan(pWindow, offsets, GameBoard.getBoardGrid());
+		GameBoard.resetGeometryChanged();
 
 		initCamera();
 		Camera::UniformBufferObject ubo;
 		ubo.proj = pEyeOfTheBeholder->getPerspectiveMatrix();
 		ubo.view = pEyeOfTheBeholder->getLookAtMatrix();
 
-		int frameCount = 0;	//used to ensure that the timer per game clock() object is called 
-							//twice a second, which will drastically increase performance
-		int nonMineClicks = 0;	//will be used to check if a game has been won
+		scheduler.setFrameCap(FRAME_RATE_CAP);
+		scheduler.requestFrame();
+		std::chrono::steady_clock::time_point lastLoop = std::chrono::steady_clock::now();
 
+		TimerService timers;
+		uint32_t gameTimer = TimerService::NO_TIMER;
+		std::vector<InputEvent> inputBatch;
+		inputBatch.reserve(InputQueue::CAPACITY);
+
+		bool updateVectors = false;	//will only be true if vector information has changed to ensure that
+									//the vector information will only be sent to the gpu once per loop-cycle
 		while (!glfwWindowShouldClose(pWindow)) {
-			bool updateVectors = false;	//will only be true if vector information has changed to ensure that
-										//the vector information will only be sent to the gpu once per loop-cycle
+			updateVectors = false;
 
-			timer.startTimer();
-			glfwPollEvents();
+			scheduler.waitForEvents();
+			std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
 
-			//this if statement checks if the clock needs to be updated will a game is being played
-			if (state == playing && frameCount == 0) {
-				clock_t temp_time = clock() - game_time;
-				if (GameBoard.updateTime((((float)temp_time) / CLOCKS_PER_SEC))) {
-					updateVectors = true;
-				}
-			}
+			timers.runDue(now);
 
-			//the first if checks to see if the game needs initializing for a new game or otherwise
-			//	the else if checks to see if a mouse click has happened and needs to be processed
-			if (state == reset) {
-				nonMineClicks = 0;
-				GameBoard.setupMines();
+			//the board is generated on a worker thread after the first click, once it is
+			//	ready the first click and the clicks made while it was generating are revealed
+			bool firstClick = false;
+			if (GameBoard.collectBoard(firstClick)) {
 				updateVectors = true;
-				state = ready;
+				if (GameBoard.isLost()) {
+					state = lost;
+				}
 			}
-			else if (isMouseDown) {
-				//the first if is for left clicks, the else is for right clicks
-				if (isLeftClick) {
-					bool dataChanged = false;
-					//if checks if a mine was hit
-					if (GameBoard.processLeftClick(PICKER->getVulkanCoordinates().x, PICKER->getVulkanCoordinates().y, dataChanged)) {
-						state = lost;
-						updateVectors = true;
+
+			//handles every input that arrived since the last loop in the order it arrived,
+			//	a click is converted with the camera as it was before this loop moves it
+			inputBatch.clear();
+			input_queue.drain(inputBatch);
+			for (const InputEvent &event : inputBatch) {
+				if (event.type == InputEvent::input_mouse_button && event.action == GLFW_PRESS && state != lost) {
+					//the first click starts the game and its clock
+					if (state != playing) {
+						state = playing;
+						game_time = event.time;
+					}
+					uint32_t row, column;
+
+					//the first if is for left clicks, the else is for right clicks
+					if (event.code == GLFW_MOUSE_BUTTON_LEFT && pickTile(event, row, column)) {
+						bool dataChanged = false;
+						//if checks if a mine was hit
+						if (GameBoard.processLeftClick(row, column, dataChanged)) {
+							state = lost;
+							updateVectors = true;
+						}
+						else if (dataChanged) {
+							updateVectors = true;
+						}
 					}
-					else if (dataChanged) {
+					else if (event.code == GLFW_MOUSE_BUTTON_RIGHT && pickTile(event, row, column)) {
+						GameBoard.processRightClick(row, column);
 						updateVectors = true;
-						nonMineClicks++;
 					}
 				}
-				else {
-					GameBoard.processRightClick(PICKER->getVulkanCoordinates().x, PICKER->getVulkanCoordinates().y);
-					updateVectors = true;
+				else if (event.type == InputEvent::input_scroll) {
+					scrollOffset += event.y;
+				}
+				else if (event.type == InputEvent::input_key && event.action == GLFW_PRESS) {
+					if (event.code == GLFW_KEY_ESCAPE) {
+						glfwSetWindowShouldClose(pWindow, GLFW_TRUE);
+					}
+					else if (event.code == GLFW_KEY_SPACE) {
+						GameBoard.setupMines();
+						updateVectors = true;
+						state = ready;
+					}
+					else if (event.code == GLFW_KEY_I) {
+						//an endless board, played through a window of the grid that follows the camera
+						GameBoard.setupInfiniteBoard(RandomStream::randomSeed());
+						updateVectors = true;
+						state = ready;
+					}
+					else if (event.code == GLFW_KEY_H && state == playing) {
+						//plays the move the solver suggests, the same as a click on that tile
+						bool dataChanged = false;
+						if (GameBoard.applyHint(dataChanged)) {
+							state = lost;
+						}
+						updateVectors = true;
+					}
+					else if (event.code == GLFW_KEY_F5 && !GameBoard.isInfinite()) {
+						GameBoard.takeSnapshot().save(SNAPSHOT_PATH);
+					}
+					else if (event.code == GLFW_KEY_F9) {
+						//the game continues from the snapshot, the clock is set back to its time.
+						//	A missing or broken snapshot leaves the game as it is
+						try {
+							BoardSnapshot snapshot = BoardSnapshot::load(SNAPSHOT_PATH);
+							GameBoard.loadSnapshot(snapshot);
+							game_time = std::chrono::steady_clock::now() - std::chrono::seconds(snapshot.getHeader().time);
+							timers.cancel(gameTimer);
+							state = (GameBoard.isLost() || GameBoard.isWon()) ? lost : playing;
+							updateVectors = true;
+						}
+						catch (Exception &excpt) {
+							std::cout << excpt.what() << std::endl;
+						}
+					}
+					else if (event.code == GLFW_KEY_HOME) {
+						isCameraReset = true;
+					}
 				}
-				isMouseDown = false; // reset to false to ensure one click per cycle is processed
+				recordInputLatency(event);
 			}
 
-			//updates the geometry info to the gpu
-			if (updateVectors) {
-				offsets = GameBoard.getGeometryInfo();
-				renderer.updateGeometryBuffers(offsets);
-			}
+			//moves the camera with the held keys and the scroll wheel, the render engine
+			//	culls what the new view can not see when the uniform buffer is updated.
+			//	The step is capped so a key pressed after a long sleep does not jump
+			bool isCameraMoved = updateCamera(std::min(std::chrono::duration<float>(now - lastLoop).count(), 0.1f));
 
-			//passes the uniform matrices and renders the frame
-			renderer.updateUniformBuffer(ubo, GameBoard.getUniformMatrices());
-			renderer.drawFrame();
+			//the window of the endless board follows the camera, the camera is moved back with
+			//	it so the same tiles stay on screen
+			if (GameBoard.isInfinite() && (isCameraMoved || updateVectors) && followBoard()) {
+				isCameraMoved = true;
+				updateVectors = true;
+			}
+			if (isCameraMoved) {
+				ubo.proj = pEyeOfTheBeholder->getPerspectiveMatrix();
+				ubo.view = pEyeOfTheBeholder->getLookAtMatrix();
+				scheduler.requestFrame();
+			}
+			lastLoop = now;
 
 			//checks if a game has been won
-			if (nonMineClicks == (GAMEBOARD_ROWS * GAMEBOARD_ROWS) - NUM_OF_MINES) {
+			if (GameBoard.isWon()) {
 				state = lost;
 			}
 
-			frameCount++;
-			if (frameCount == 500) {
-				frameCount = 0;
+			//the scoreboard clock ticks on every whole second from the first click, the tick is
+			//	the time the timer was due so the seconds shown do not depend on when the loop woke
+			if (state == playing && !timers.isScheduled(gameTimer)) {
+				gameTimer = timers.scheduleEvery(game_time + std::chrono::seconds(1), std::chrono::seconds(1), [&](TimerService::time_point tick) {
+					int seconds = static_cast<int>(std::chrono::duration_cast<std::chrono::seconds>(tick - game_time).count());
+					if (GameBoard.updateTime(std::min(seconds, 999))) {
+						updateVectors = true;
+					}
+				});
+			}
+			else if (state != playing) {
+				timers.cancel(gameTimer);
+			}
+
+			//updates the geometry info to the gpu, the tiles of an instanced board only need
+			//	their state bytes copied, the vertex buffers are only rebuilt if the geometry changed
+			if (updateVectors) {
+				renderer.updateGridStates();
+				if (GameBoard.isGeometryChanged()) {
+					offsets = GameBoard.getGeometryInfo();
+					renderer.updateGeometryBuffers(offsets);
+					GameBoard.resetGeometryChanged();
+				}
+				scheduler.requestFrame();
+			}
+
+			//the worker thread generating the board does not wake the loop, so it is polled
+			if (GameBoard.isGenerating()) {
+				scheduler.scheduleWake(now + std::chrono::milliseconds(GENERATION_POLL_MS));
 			}
+			timers.scheduleWake(scheduler);
+
+			//passes the uniform matrices and renders the frame if anything changed
+			if (scheduler.beginFrame()) {
+				timer.startTimer();
+				renderer.updateUniformBuffer(ubo, GameBoard.getUniformMatrices());
+				renderer.drawFrame();
+				timer.calcFrameStats();
+				displayFrameStats();
 
-			timer.calcFrameStats();
-			displayFrameStats();
+				//a held key moves the camera every frame, so the next frame does not wait for an event
+				if (isCameraMoved) {
+					scheduler.requestFrame();
+				}
+			}
 		}
 
 		renderer.cleanup();
@@ -155,6 +276,33 @@ void Window::runGame() throw(Exception) {
 }
 
 
+/*
+* Function: pushInput
+*
+* Paramters: InputEvent::input_type type,
+*			 int code,
+*			 int action,
+*			 int mods,
+*			 double x,
+*			 double y
+*
+* Return Type: void
+*
+* Description: timestamps the input and adds it to the input queue, the callbacks
+*				only record the input and the game loop handles it
+*
+*/
+void Window::pushInput(InputEvent::input_type type, int code, int action, int mods, double x, double y) {
+	InputEvent event;
+	event.type = type;
+	event.code = code;
+	event.action = action;
+	event.mods = mods;
+	event.x = x;
+	event.y = y;
+	event.time = std::chrono::steady_clock::now();
+	input_queue.push(event);
+}
 /*
 * Function: keyCallback
 *
@@ -165,12 +313,7 @@ void Window::runGame() throw(Exception) {
 *
 */
 void Window::keyCallback(GLFWwindow *pW, int key, int scancode, int action, int mods) {
-	if (key == GLFW_KEY_ESCAPE) {
-		glfwSetWindowShouldClose(pW, GLFW_TRUE);
-	}
-	if (key == GLFW_KEY_SPACE) {
-		state = reset;
-	}
+	pushInput(InputEvent::input_key, key, action, mods, xPosition, yPosition);
 }
 /*
 * Function: mouse_position_callback
@@ -191,29 +334,52 @@ void Window::mouse_position_callback(GLFWwindow *pW, double x_pos, double y_pos)
 * Paramters: standard parameters for the call back function
 *
 *
-* Description: records cursor position when a click occurs in PICKER object, which is of
-*				type static MouseClickReader*
+* Description: records the click with the cursor position it happened at, the game loop
+*				finds the tile under it with pickTile()
 *
 */
 void Window::mouse_click_callback(GLFWwindow *pW, int button, int action, int mods) {
-	if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS && state != lost) {
-		if (state != playing) {
-			state = playing;
-			game_time = clock();
-		}
-		isMouseDown = true;
-		isLeftClick = true;
-		PICKER->setClick((float)xPosition, (float)yPosition);
-	}
-	if (button == GLFW_MOUSE_BUTTON_RIGHT && action == GLFW_PRESS && state != lost) {
-		if (state != playing) {
-			state = playing;
-			game_time = clock();
-		}
-		isMouseDown = true;
-		isLeftClick = false;
-		PICKER->setClick((float)xPosition, (float)yPosition);
-	}
+	pushInput(InputEvent::input_mouse_button, button, action, mods, xPosition, yPosition);
+}
+
+
+/*
+* Function: scroll_callback
+*
+* Paramters: standard parameters for the call back function
+*
+*
+* Description: records the notches of the scroll wheel, the game loop adds them up
+*				until the camera is updated
+*
+*/
+void Window::scroll_callback(GLFWwindow *pW, double x_offset, double y_offset) {
+	pushInput(InputEvent::input_scroll, 0, 0, 0, x_offset, y_offset);
+}
+/*
+* Function: window_refresh_callback
+*
+* Paramters: standard parameters for the call back function
+*
+*
+* Description: draws a frame when the window was uncovered or needs to be drawn again
+*
+*/
+void Window::window_refresh_callback(GLFWwindow *pW) {
+	scheduler.requestFrame();
+}
+/*
+* Function: framebuffer_size_callback
+*
+* Paramters: standard parameters for the call back function
+*
+*
+* Description: draws a frame when the window is resized, the swapchain is recreated
+*				by the render engine when it draws
+*
+*/
+void Window::framebuffer_size_callback(GLFWwindow *pW, int width, int height) {
+	scheduler.requestFrame();
 }
 
 
@@ -225,7 +391,8 @@ void Window::mouse_click_callback(GLFWwindow *pW, int button, int action, int mo
 * Return Type: void
 *
 * Description: initializes the values for the camera object used for
-*				the non dynamic portion of the uniform buffer
+*				the non dynamic portion of the uniform buffer, and passes
+*				the camera to the PICKER to convert the clicks
 *
 */
 void Window::initCamera() {
@@ -239,6 +406,121 @@ void Window::initCamera() {
 	pEyeOfTheBeholder->ratio = width / ((float)height);
 	pEyeOfTheBeholder->nearPerspective = 0.1f;
 	pEyeOfTheBeholder->farPerspective = 10.0f;
+
+	PICKER->setView(*pEyeOfTheBeholder, (float)width, (float)height);
+}
+/*
+* Function: updateCamera
+*
+* Paramters: float seconds,		the time since the last update
+*
+* Return Type: bool
+*
+* Description: pans the camera with the arrow keys that are held and zooms it with the
+*				scroll wheel, the pan is scaled by the distance of the camera so it
+*				crosses the same part of the view at any zoom. Passes the camera to the
+*				PICKER and returns true if it moved
+*
+*/
+bool Window::updateCamera(float seconds) {
+	if (isCameraReset) {
+		isCameraReset = false;
+		scrollOffset = 0.0;
+		initCamera();
+		return true;
+	}
+
+	glm::vec2 direction(0.0f, 0.0f);
+	direction.x += (glfwGetKey(pWindow, GLFW_KEY_RIGHT) == GLFW_PRESS) ? 1.0f : 0.0f;
+	direction.x -= (glfwGetKey(pWindow, GLFW_KEY_LEFT) == GLFW_PRESS) ? 1.0f : 0.0f;
+	//the up vector of the camera points down on the screen
+	direction.y += (glfwGetKey(pWindow, GLFW_KEY_DOWN) == GLFW_PRESS) ? 1.0f : 0.0f;
+	direction.y -= (glfwGetKey(pWindow, GLFW_KEY_UP) == GLFW_PRESS) ? 1.0f : 0.0f;
+	if (direction.x == 0.0f && direction.y == 0.0f && scrollOffset == 0.0) {
+		return false;
+	}
+
+	pEyeOfTheBeholder->pan(direction * (CAMERA_PAN_SPEED * seconds * pEyeOfTheBeholder->getDistance()));
+	if (scrollOffset != 0.0) {
+		pEyeOfTheBeholder->zoom(std::pow(CAMERA_ZOOM_STEP, static_cast<float>(-scrollOffset)), CAMERA_MIN_DISTANCE, CAMERA_MAX_DISTANCE);
+		scrollOffset = 0.0;
+	}
+
+	int width, height;
+	glfwGetWindowSize(pWindow, &width, &height);
+	PICKER->setView(*pEyeOfTheBeholder, (float)width, (float)height);
+	return true;
+}
+/*
+* Function: followBoard
+*
+* Paramters: none
+*
+* Return Type: bool
+*
+* Description: passes the camera and the part of the board it can see to the endless
+*				board, see TileManager::followCamera(). If the window of the board moved
+*				the camera is moved by the same distance and passed to the PICKER,
+*				returns true if it moved
+*
+*/
+bool Window::followBoard() {
+	glm::vec2 lookAt(pEyeOfTheBeholder->at);
+	glm::vec2 viewMin, viewMax;
+	if (!pEyeOfTheBeholder->getFrustum().getPlaneBounds(0.0f, viewMin, viewMax)) {
+		viewMin = lookAt;
+		viewMax = lookAt;
+	}
+
+	glm::vec2 shift = GameBoard.followCamera(lookAt, viewMin, viewMax);
+	if (shift.x == 0.0f && shift.y == 0.0f) {
+		return false;
+	}
+	pEyeOfTheBeholder->eye += glm::vec3(shift, 0.0f);
+	pEyeOfTheBeholder->at += glm::vec3(shift, 0.0f);
+
+	int width, height;
+	glfwGetWindowSize(pWindow, &width, &height);
+	PICKER->setView(*pEyeOfTheBeholder, (float)width, (float)height);
+	return true;
+}
+/*
+* Function: pickTile
+*
+* Paramters: const InputEvent &event,
+*			 uint32_t &row,
+*			 uint32_t &column
+*
+* Return Type: bool
+*
+* Description: finds the tile under the cursor of a click. The click is converted with
+*				the camera by the PICKER, which has the camera as it is now even if the
+*				frame showing it was held back, and the tile is found from where it hits
+*				the board. The pick image of the render engine is not read, that waits
+*				for the gpu and is only for meshes that are not on a grid. Returns false
+*				if the click was off the board
+*
+*/
+bool Window::pickTile(const InputEvent &event, uint32_t &row, uint32_t &column) {
+	PICKER->setClick((float)event.x, (float)event.y);
+	return GameBoard.pickTile(PICKER->getVulkanCoordinates().x, PICKER->getVulkanCoordinates().y, row, column);
+}
+/*
+* Function: recordInputLatency
+*
+* Paramters: const InputEvent &event
+*
+* Return Type: void
+*
+* Description: adds the time since the callback received the event to the latency stats,
+*				to be called once the event has been handled
+*
+*/
+void Window::recordInputLatency(const InputEvent &event) {
+	double latency = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - event.time).count();
+	input_latency_total += latency;
+	input_latency_max = std::max(input_latency_max, latency);
+	num_of_inputs++;
 }
 /*
 * Function: displayFrameStats
@@ -247,7 +529,8 @@ void Window::initCamera() {
 *
 * Return Type: void
 *
-* Description: displays the calculated frame stats from the clock object
+* Description: displays the calculated frame stats from the clock object and the
+*				generation report of the current board
 *				note that for accurate results calcFrameStats must be called before this
 *				method that is a member function for the clock object
 *
@@ -259,5 +542,30 @@ void Window::displayFrameStats() {
 	updatedTitle += std::to_string(timer.getFPS());
 	updatedTitle += "  avg. mspf: ";
 	updatedTitle += std::to_string(timer.getMSPF());
+
+	//reports how the current board was generated once it is ready
+	TileManager::GenerationReport report = GameBoard.getGenerationReport();
+	if (report.attempts > 0) {
+		updatedTitle += "  board: ";
+		updatedTitle += std::to_string(report.milliseconds);
+		updatedTitle += " ms, ";
+		updatedTitle += std::to_string(report.attempts);
+		updatedTitle += (report.isNoGuess) ? " attempts, no-guess" : " attempts";
+	}
+	updatedTitle += "  drawn tiles: ";
+	updatedTitle += std::to_string(renderer.getNumOfDrawnCells());
+
+	//how long input waits to be handled, and any that did not fit in the queue
+	if (num_of_inputs > 0) {
+		updatedTitle += "  input latency avg: ";
+		updatedTitle += std::to_string(input_latency_total / num_of_inputs);
+		updatedTitle += " ms, max: ";
+		updatedTitle += std::to_string(input_latency_max);
+		updatedTitle += " ms";
+	}
+	if (input_queue.getNumOfDropped() > 0) {
+		updatedTitle += "  dropped input: ";
+		updatedTitle += std::to_string(input_queue.getNumOfDropped());
+	}
 	glfwSetWindowTitle(pWindow, updatedTitle.c_str());
 }
\ No newline at end of file
@@ -16,9 +16,28 @@
 #pragma once
 #include "stdafx.h"
 #include "Clock.h"
+#include "FrameScheduler.h"
+#include "TimerService.h"
+#include "InputQueue.h"
 #include "RenderEngine.h"
 #include "TileManager.h"
 
+// every game is appended to the input log, F5 saves a snapshot of the game and F9 loads it
+#define INPUT_LOG_PATH "minesweeper.log"
+#define SNAPSHOT_PATH "minesweeper.snapshot"
+
+// the arrow keys pan the camera, the scroll wheel zooms and home puts the camera back
+#define CAMERA_PAN_SPEED 1.0f		//the part of the view crossed per second
+#define CAMERA_ZOOM_STEP 1.1f		//the change in distance per notch of the scroll wheel
+#define CAMERA_MIN_DISTANCE 0.5f
+#define CAMERA_MAX_DISTANCE 25.0f
+
+// the loop sleeps until input, a timer tick or a change to the board, frames are drawn at most
+//	FRAME_RATE_CAP times a second (0 for no cap). The board generator is checked every
+//	GENERATION_POLL_MS milliseconds while it runs
+#define FRAME_RATE_CAP 60.0
+#define GENERATION_POLL_MS 2
+
 // gameState will be used to track the game's state
 enum gameState {
 	lost,
@@ -37,6 +56,9 @@ public:
 	static void keyCallback(GLFWwindow *pW, int key, int scancode, int action, int mods);
 	static void mouse_position_callback(GLFWwindow *pW, double x_pos, double y_pos);
 	static void mouse_click_callback(GLFWwindow *pW, int button, int action, int mods);
+	static void scroll_callback(GLFWwindow *pW, double x_offset, double y_offset);
+	static void window_refresh_callback(GLFWwindow *pW);
+	static void framebuffer_size_callback(GLFWwindow *pW, int width, int height);
 
 private:
 	GLFWwindow * pWindow;
@@ -46,15 +68,27 @@ private:
 
 	RenderEngine renderer;
 
-	static clock_t game_time;
+	static std::chrono::steady_clock::time_point game_time;
 	static gameState state;
 	static double xPosition;
 	static double yPosition;
-	static bool isMouseDown;
-	static bool isLeftClick;
+	static bool isCameraReset;
+	static double scrollOffset;
 	static int user_id;
 	static Clock timer;
+	static FrameScheduler scheduler;
+	static InputQueue input_queue;
+
+	//the time from an input's callback until the loop has handled it
+	double input_latency_total = 0.0;
+	double input_latency_max = 0.0;
+	uint64_t num_of_inputs = 0;
 
 	void initCamera();
+	bool updateCamera(float seconds);
+	bool followBoard();
+	bool pickTile(const InputEvent &event, uint32_t &row, uint32_t &column);
+	void recordInputLatency(const InputEvent &event);
+	static void pushInput(InputEvent::input_type type, int code, int action, int mods, double x, double y);
 	void displayFrameStats();
 };
\ No newline at end of file
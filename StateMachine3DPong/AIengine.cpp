@@ -11,23 +11,14 @@
 
 #include "stdafx.h"
 #include "AIengine.h"
+#include "PhysicsCalculator.h"
 
 
-/*
-* Function: instance
-*
-* 
-* Description: Retruns a static instance of the class
-*
-*/
-AIengine* AIengine::instance() {
-	static AIengine inst;
-	return &inst;
-}
 /*
 * Function: calcTargetPosition
 *
-* Paramters: float collisionPosition, 
+* Paramters: glm::vec3 location,
+*			 float radius,
 *			 float degrees, 
 *			 float speed
 *
@@ -37,37 +28,99 @@ AIengine* AIengine::instance() {
 *				stores the calculation in the member variable, targetPosition
 *
 */
-void AIengine::calcTargetPosition(float collisionPosition, float degrees, float speed) {
-	targetPosition = collisionPosition;
+void AIengine::calcTargetPosition(glm::vec3 location, float radius, float degrees, float speed) {
+	targetPosition.store(predictIntercept(location.x, location.z, radius, degrees, speed), std::memory_order_relaxed);
+}
+/*
+* Function: getTargetPosition
+*
+*
+* Description: simple getter method
+*
+*/
+float AIengine::getTargetPosition() const {
+	return targetPosition.load(std::memory_order_relaxed);
+}
 
-	if (degrees == 0.0f) {
-		return;
+/*
+* Function: predictIntercept
+*
+* Paramters: float x,
+*			 float z,
+*			 float radius,
+*			 float degrees,
+*			 float speed
+*
+* Return Type: float
+*
+* Description: returns where a ball of radius at (x, z) will be when it touches the
+*				lane at AI_TARGET_X, where the ball sends its collision check from (see
+*				State_BallTowardsComputer). The check is swept, so this is where the
+*				center crosses AI_TARGET_X - radius and not where a tick ends. Without
+*				the walls the ball would move in a straight line, the walls only
+*				mirror that line (see foldIntoField). A ball that does not move
+*				towards AI_TARGET_X keeps its position
+*
+*/
+float AIengine::predictIntercept(float x, float z, float radius, float degrees, float speed) {
+	float x_delta = speed * cos(glm::radians(degrees));
+	float y_delta = speed * sin(glm::radians(degrees));
+	if (!(x_delta > 0.0f)) {
+		return z;
 	}
 
-	bool hasHitWall = false;
-	float x_position = -0.9;
-	while (x_position < 0.9) {
-		float x_delta, y_delta;
-		x_delta = speed * cos(glm::radians(degrees));
-		y_delta = speed * sin(glm::radians(degrees));
-		if (hasHitWall) {
-			y_delta = -y_delta;
-		}
-		x_position += x_delta;
-		targetPosition += y_delta;
-
-		if (targetPosition <= -0.8 || targetPosition >= 0.8) {
-			hasHitWall = !hasHitWall;
-		}
+	float numOfTicks = std::max(0.0f, (AI_TARGET_X - radius - x) / x_delta);
+	return foldIntoField(z + numOfTicks * y_delta, FIELD_WALL - radius);
+}
+/*
+* Function: predictIntercepts
+*
+* Paramters: const float *xs,
+*			 const float *zs,
+*			 float radius,
+*			 const float *degrees,
+*			 const float *speeds,
+*			 float *intercepts,
+*			 uint32_t count
+*
+* Return Type: void
+*
+* Description: predicts count balls of the same radius at once, intercepts[i] is the
+*				prediction of the ith entry of the other arrays (see predictIntercept).
+*				The arrays are read in order and no entry depends on another, so the
+*				compiler is free to vectorize the loop
+*
+*/
+void AIengine::predictIntercepts(const float *xs, const float *zs, float radius, const float *degrees,
+	const float *speeds, float *intercepts, uint32_t count) {
+	for (uint32_t i = 0; i < count; i++) {
+		intercepts[i] = predictIntercept(xs[i], zs[i], radius, degrees[i], speeds[i]);
 	}
 }
+
 /*
-* Function: getTargetPosition
+* Function: foldIntoField
 *
+* Paramters: float position,
+*			 float limit
 *
-* Description: simple getter method
+* Return Type: float
+*
+* Description: returns the position a ball that moved to position in a field without
+*				walls has in the field between -limit and limit, the farthest the
+*				center of the ball gets from the middle before it bounces. Each wall
+*				mirrors the path, so it repeats every four limits and is mirrored back
+*				in the second half of that period
 *
 */
-float AIengine::getTargetPosition() const {
-	return targetPosition;
+float AIengine::foldIntoField(float position, float limit) {
+	const float period = 4.0f * limit;
+	float folded = std::fmod(position + limit, period);
+	if (folded < 0.0f) {
+		folded += period;
+	}
+	if (folded > 2.0f * limit) {
+		folded = period - folded;
+	}
+	return folded - limit;
 }
\ No newline at end of file
@@ -3,28 +3,38 @@
 * BY:		Eric Hollas																	*
 *																						*
 * FILE:		AIengine.h																	*
-* DETAILS:	This file defines the ai engine. At the end of the file AI_ENGINE is		*
-*				defined using a macro. This will serve as the instance throughout		*
-*				the rest of the program. The class stores a target point that can		*
-*				be returned and has another function that calculates a future point		*
-*				to be used for the computer controlled paddle.							*
+* DETAILS:	This file defines the ai engine, each Match has its own. The class stores	*
+*				a target point that can be returned and has another function that		*
+*				calculates a future point to be used for the computer controlled		*
+*				paddle.																	*
+*				The ball's path is folded between the walls instead of stepped, so a	*
+*				prediction takes the same time at any speed and many balls can be		*
+*				predicted at once from arrays.											*
 *																						*
 *****************************************************************************************/
 
 
 #pragma once
 #include "stdafx.h"
+#include <atomic>
+
+//the ball is predicted from where it left the user's paddle to the lane of the computer's
+//	paddle, it bounces between the walls at FIELD_WALL (see PhysicsCalculator::integrate)
+#define AI_TARGET_X 0.9f
 
 class AIengine {
 public:
-	static AIengine* instance();
-
-	void calcTargetPosition(float collisionPosition, float degrees, float speed);
+	void calcTargetPosition(glm::vec3 location, float radius, float degrees, float speed);
 
 	float getTargetPosition() const;
 
+	static float predictIntercept(float x, float z, float radius, float degrees, float speed);
+	static void predictIntercepts(const float *xs, const float *zs, float radius, const float *degrees,
+		const float *speeds, float *intercepts, uint32_t count);
+
 private:
-	float targetPosition = 0.0f;
-};
+	//written by the ball and read by the computer paddle, which may run on different threads
+	std::atomic<float> targetPosition{ 0.0f };
 
-#define AI_ENGINE AIengine::instance()
\ No newline at end of file
+	static float foldIntoField(float position, float limit);
+};
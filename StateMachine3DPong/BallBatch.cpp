@@ -0,0 +1,164 @@
+/****************************************************************************************
+* TITLE:	2D-Pong in 3D																*
+* BY:		Eric Hollas																	*
+*																						*
+* FILE:		BallBatch.cpp																*
+*																						*
+* Correponds to BallBatch.h (see for overall description)								*
+*																						*
+*****************************************************************************************/
+
+
+#include "stdafx.h"
+#include "BallBatch.h"
+
+/*
+* Constructor
+*/
+BallBatch::BallBatch() {
+}
+/*
+* Deconstructor
+*/
+BallBatch::~BallBatch() {
+}
+
+/*
+* Function: add
+*
+* Paramters: glm::vec3 location,
+*			 glm::vec3 velocity,
+*			 float radius
+*
+* Return Type: uint32_t
+*
+* Description: adds a ball at the end of the arrays with no spin and returns its index,
+*				the y of the velocity is ignored since the balls stay on the field
+*
+*/
+uint32_t BallBatch::add(glm::vec3 location, glm::vec3 velocity, float radius) {
+	x.push_back(location.x);
+	y.push_back(location.y);
+	z.push_back(location.z);
+	velocity_x.push_back(velocity.x);
+	velocity_z.push_back(velocity.z);
+	radii.push_back(radius);
+	spin_x.push_back(0.0f);
+	spin_y.push_back(0.0f);
+	spin_z.push_back(0.0f);
+	spin_w.push_back(1.0f);
+	return (uint32_t)x.size() - 1;
+}
+/*
+* Function: clear
+*
+* Paramters: none
+*
+* Return Type: void
+*
+* Description: removes every ball
+*
+*/
+void BallBatch::clear() {
+	x.clear();
+	y.clear();
+	z.clear();
+	velocity_x.clear();
+	velocity_z.clear();
+	radii.clear();
+	spin_x.clear();
+	spin_y.clear();
+	spin_z.clear();
+	spin_w.clear();
+}
+
+/*
+* Function: getMatrix
+*
+* Paramters: uint32_t index
+*
+* Return Type: glm::mat4
+*
+* Description: returns the uniform matrix of the ball, the rotation of its spin followed
+*				by the translation to its location. The spin is normalized here, so the
+*				small errors the steps add to its length never reach the matrix
+*
+*/
+glm::mat4 BallBatch::getMatrix(uint32_t index) const {
+	float qx = spin_x[index], qy = spin_y[index], qz = spin_z[index], qw = spin_w[index];
+	float s = 2.0f / (qx * qx + qy * qy + qz * qz + qw * qw);
+
+	glm::mat4 matrix(1.0f);
+	matrix[0][0] = 1.0f - s * (qy * qy + qz * qz);
+	matrix[0][1] = s * (qx * qy + qw * qz);
+	matrix[0][2] = s * (qx * qz - qw * qy);
+	matrix[1][0] = s * (qx * qy - qw * qz);
+	matrix[1][1] = 1.0f - s * (qx * qx + qz * qz);
+	matrix[1][2] = s * (qy * qz + qw * qx);
+	matrix[2][0] = s * (qx * qz + qw * qy);
+	matrix[2][1] = s * (qy * qz - qw * qx);
+	matrix[2][2] = 1.0f - s * (qx * qx + qy * qy);
+	matrix[3][0] = x[index];
+	matrix[3][1] = y[index];
+	matrix[3][2] = z[index];
+	return matrix;
+}
+/*
+* Function: writeMatrices
+*
+* Paramters: glm::mat4 * matrices,
+*			 uint32_t first,
+*			 uint32_t last
+*
+* Return Type: void
+*
+* Description: writes the uniform matrices of the balls from index first up to but not
+*				including last to matrices, starting at matrices[0]
+*
+*/
+void BallBatch::writeMatrices(glm::mat4 * matrices, uint32_t first, uint32_t last) const {
+	for (uint32_t i = first; i < last; i++) {
+		matrices[i - first] = getMatrix(i);
+	}
+}
+
+//getter method
+uint32_t BallBatch::size() const {
+	return (uint32_t)x.size();
+}
+//getter method
+float * BallBatch::getX() {
+	return x.data();
+}
+//getter method
+float * BallBatch::getZ() {
+	return z.data();
+}
+//getter method
+float * BallBatch::getVelocityX() {
+	return velocity_x.data();
+}
+//getter method
+float * BallBatch::getVelocityZ() {
+	return velocity_z.data();
+}
+//getter method
+float * BallBatch::getRadii() {
+	return radii.data();
+}
+//getter method
+float * BallBatch::getSpinX() {
+	return spin_x.data();
+}
+//getter method
+float * BallBatch::getSpinY() {
+	return spin_y.data();
+}
+//getter method
+float * BallBatch::getSpinZ() {
+	return spin_z.data();
+}
+//getter method
+float * BallBatch::getSpinW() {
+	return spin_w.data();
+}
@@ -0,0 +1,57 @@
+/****************************************************************************************
+* TITLE:	2D-Pong in 3D																*
+* BY:		Eric Hollas																	*
+*																						*
+* FILE:		BallBatch.h																	*
+* DETAILS:	This file defines a batch of balls kept as a structure of plain float		*
+*				arrays, one array for each coordinate, for games with many balls such	*
+*				as a server running many matches. PhysicsCalculator::stepBalls and		*
+*				testPaddle update the arrays four balls at a time with SSE.				*
+*			The field is flat, so a ball has a fixed height and moves and spins only	*
+*				in the plane of the field. The spin is kept as a quaternion instead of	*
+*				a matrix, so rolling a ball does not need glm::rotate and its trig. The	*
+*				uniform matrices are only built from the arrays when they are drawn.	*
+*																						*
+*****************************************************************************************/
+
+
+#pragma once
+#include "stdafx.h"
+
+class BallBatch {
+public:
+	BallBatch();
+	~BallBatch();
+
+	uint32_t add(glm::vec3 location, glm::vec3 velocity, float radius);
+	void clear();
+
+	uint32_t size() const;
+
+	glm::mat4 getMatrix(uint32_t index) const;
+	void writeMatrices(glm::mat4 * matrices, uint32_t first, uint32_t last) const;
+
+	//the components, indexed from 0 to size() - 1
+	float * getX();
+	float * getZ();
+	float * getVelocityX();
+	float * getVelocityZ();
+	float * getRadii();
+	//the spin of each ball, the quaternion (x, y, z, w)
+	float * getSpinX();
+	float * getSpinY();
+	float * getSpinZ();
+	float * getSpinW();
+
+private:
+	std::vector<float> x;
+	std::vector<float> y;
+	std::vector<float> z;
+	std::vector<float> velocity_x;
+	std::vector<float> velocity_z;
+	std::vector<float> radii;
+	std::vector<float> spin_x;
+	std::vector<float> spin_y;
+	std::vector<float> spin_z;
+	std::vector<float> spin_w;
+};
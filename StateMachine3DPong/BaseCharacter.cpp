@@ -11,32 +11,49 @@
 
 #include "stdafx.h"
 #include "BaseCharacter.h"
-
-//used to calculate the character's id
-int BaseCharacter::next_available_id = 0;
+#include "Match.h"
 
 /*
 * Constructor
 * parameters are passed to the base class
+*
+* adds the character to the entities of the match, the slot of its handle is the character's id
+*
 */
-BaseCharacter::BaseCharacter(float rad, glm::vec3 initLocation) {
-	id = next_available_id++;
-
-	radius = rad;
-	currLocation = initLocation;
-	uniformMatrix = glm::mat4(1.0f);
+BaseCharacter::BaseCharacter(Match &match, float rad, glm::vec3 initLocation) {
+	p_match = &match;
+	p_entities = &match.getCharacters().getEntities();
+	handle = p_entities->add(this, initLocation, rad);
+	id = (int)handle.slot;
+	getDispatch().openMailbox(id);
 }
+/*
+* DeConstructor
+*
+* the slot of the handle becomes the id of the next character created, so the mail
+* still waiting for this character is thrown away before it is removed
+*
+*/
 BaseCharacter::~BaseCharacter() {
-	next_available_id--;
+	mailSpan mail = getMail();
+	while (mail.size > 0) {
+		readMessages(mail);
+		mail = getMail();
+	}
+	p_entities->remove(handle);
 }
 
 //setter function
 void BaseCharacter::setUniformMatrix(glm::mat4 newMatrix) {
-	uniformMatrix = newMatrix;
+	p_entities->getMatrices()[p_entities->find(handle)] = newMatrix;
 }
 //setter function
 void BaseCharacter::setLocation(glm::vec3 newLocation) {
-	currLocation = newLocation;
+	p_entities->getLocations()[p_entities->find(handle)] = newLocation;
+}
+//setter function, the distance the character moves every cycle
+void BaseCharacter::setVelocity(glm::vec3 newVelocity) {
+	p_entities->getVelocities()[p_entities->find(handle)] = newVelocity;
 }
 //setter function
 void BaseCharacter::setGeometry(std::vector<Geometry::Vertex> verts, std::vector<uint32_t> inds) {
@@ -50,26 +67,26 @@ void BaseCharacter::setGeometry(std::vector<Geometry::Vertex> verts, std::vector
 *
 * Return Type: bool
 *
-* Description: gets all the messages from DISPATCH, the messanger instance, 
-*				and returns true if there was a message received
+* Description: returns true if there is a message waiting in this character's mailbox
+*				in the messanger of its match
 *
 */
 bool BaseCharacter::mailReceived() {
-	return DISPATCH->distribute(id, mailbox);
+	return getDispatch().hasMail(id);
 }
 /*
 * Function: readMessages
 *
-* Paramters: none
+* Paramters: const mailSpan &mail
 *
 * Return Type: void
 *
-* Description: clears the mailbox deque of received messages
+* Description: removes the messages of the span returned by getMail from the mailbox
 *				only call this function after the messages have been processed
 *
 */
-void BaseCharacter::readMessages() {
-	mailbox.clear();
+void BaseCharacter::readMessages(const mailSpan &mail) {
+	getDispatch().release(id, mail.size);
 }
 
 /*
@@ -78,8 +95,15 @@ void BaseCharacter::readMessages() {
 int BaseCharacter::getID() const {
 	return id;
 }
+//returns -1 if the peer was removed, the messanger drops messages to -1
+int BaseCharacter::getPeerID(EntityHandle peer) const {
+	if (!p_entities->isValid(peer)) {
+		return -1;
+	}
+	return (int)peer.slot;
+}
 float BaseCharacter::getRadius() const {
-	return radius;
+	return p_entities->getRadii()[p_entities->find(handle)];
 }
 std::vector<Geometry::Vertex> BaseCharacter::getVertices() const {
 	return vertices;
@@ -88,11 +112,26 @@ std::vector<uint32_t> BaseCharacter::getIndices() const {
 	return indices;
 }
 glm::vec3 BaseCharacter::getLocation() const {
-	return currLocation;
+	return p_entities->getLocations()[p_entities->find(handle)];
+}
+glm::vec3 BaseCharacter::getVelocity() const {
+	return p_entities->getVelocities()[p_entities->find(handle)];
 }
 glm::mat4 BaseCharacter::getUniformMatrix() const {
-	return uniformMatrix;
+	return p_entities->getMatrices()[p_entities->find(handle)];
+}
+EntityHandle BaseCharacter::getHandle() const {
+	return handle;
+}
+mailSpan BaseCharacter::getMail() const {
+	return getDispatch().getMail(id);
+}
+Messanger & BaseCharacter::getDispatch() const {
+	return p_match->getDispatch();
+}
+PhysicsCalculator & BaseCharacter::getPhysics() const {
+	return p_match->getPhysics();
 }
-std::deque<message> BaseCharacter::getMail() const {
-	return mailbox;
+AIengine & BaseCharacter::getAI() const {
+	return p_match->getAI();
 }
\ No newline at end of file
@@ -4,10 +4,17 @@
 *																						*
 * FILE:		BaseCharacter.h																*
 * DETAILS:	This file defines the base class for the characters to inherit and build	*
-*				off. This class essentially handles messages from the DISPATCH			*
-*				defined in the Messanger.h, it also defines the getters and setters		*
-*				for the various class memebers, and it declares the pure virtual		*
-*				functions, which are initMesh, runCycle, and handleMessages.			*
+*				off. This class essentially handles messages from the messanger of		*
+*				its match, it also defines the getters and setters for the various		*
+*				class memebers, and it declares the pure virtual functions, which are	*
+*				initMesh, runCycle, and handleMessages.									*
+*			A character is created in a Match and uses that match's messanger, physics	*
+*				and ai, so the characters of different matches never share anything.	*
+*				The location, radius, velocity and uniform matrix of a character are	*
+*				kept in the EntityStore of its match, the character holds its handle.	*
+*			The characters send messages to each other by id, a character keeps the		*
+*				handles of the ones it talks to and gets their ids with getPeerID, so	*
+*				a removed character is not sent the mail of the one in its slot now.	*
 *																						*
 *****************************************************************************************/
 
@@ -17,10 +24,14 @@
 #include "../../VulkanRenderEngine/RenderEngine/GeometryManager.h"
 #include "Messanger.h"
 #include "AIengine.h"
+#include "PhysicsCalculator.h"
+#include "EntityStore.h"
+
+class Match;
 
 class BaseCharacter {
 public:
-	BaseCharacter(float rad, glm::vec3 initLocation);
+	BaseCharacter(Match &match, float rad, glm::vec3 initLocation);
 	virtual ~BaseCharacter();
 
 	virtual void initMesh(Constants::color shade) = 0;
@@ -29,33 +40,36 @@ public:
 
 	void setUniformMatrix(glm::mat4 newMatrix);
 	void setLocation(glm::vec3 newLocation);
+	void setVelocity(glm::vec3 newVelocity);
 	void setGeometry(std::vector<Geometry::Vertex> verts, std::vector<uint32_t> inds);
 
 	bool mailReceived();
 
-	void readMessages();
+	void readMessages(const mailSpan &mail);
 
 	int getID() const;
+	int getPeerID(EntityHandle peer) const;
 	float getRadius() const;
 	std::vector<Geometry::Vertex> getVertices() const;
 	std::vector<uint32_t> getIndices() const;
 	glm::vec3 getLocation() const;
+	glm::vec3 getVelocity() const;
 	glm::mat4 getUniformMatrix() const;
-	std::deque<message> getMail() const;
+	EntityHandle getHandle() const;
+	mailSpan getMail() const;
+
+	//the services of the match the character was created in
+	Messanger & getDispatch() const;
+	PhysicsCalculator & getPhysics() const;
+	AIengine & getAI() const;
 
 private:
-	static int next_available_id;
+	Match * p_match;
+	EntityStore * p_entities;
+	EntityHandle handle;
 
 	int id;
 
-	float radius;
-
 	std::vector<Geometry::Vertex> vertices;
 	std::vector<uint32_t> indices;
-
-	glm::vec3 currLocation;
-
-	glm::mat4 uniformMatrix;
-
-	std::deque<message> mailbox;
 };
\ No newline at end of file
@@ -0,0 +1,342 @@
+/****************************************************************************************
+* TITLE:	2D-Pong in 3D																*
+* BY:		Eric Hollas																	*
+*																						*
+* FILE:		Benchmark.cpp																*
+*																						*
+* Correponds to Benchmark.h (see for overall description)								*
+*																						*
+*****************************************************************************************/
+
+
+#include "stdafx.h"
+#include "Benchmark.h"
+#include "StateMachine.h"
+#include "StaticStateMachine.h"
+#include "PhysicsCalculator.h"
+#include "EntityStore.h"
+#include "BallBatch.h"
+#include <iomanip>
+
+/*
+* The states of the benchmark characters. A character moves until it passes the
+*	edge, turns around in one tick and then waits a few ticks before moving again.
+*	The states are templates so the same states run in both machines.
+*/
+template <class character_type>
+class benchMoving : public state<character_type> {
+public:
+	void execute(character_type * p_character) override {
+		p_character->position += p_character->velocity;
+		if (p_character->position > 1.0f || p_character->position < -1.0f) {
+			p_character->turn();
+		}
+	}
+	void onMessage(character_type * p_character, message &msg) override {
+		if (msg.letter == move_up) {
+			p_character->velocity = -p_character->velocity;
+		}
+	}
+
+	static benchMoving* instance() {
+		static benchMoving inst;
+		return &inst;
+	}
+};
+
+template <class character_type>
+class benchTurning : public state<character_type> {
+public:
+	void execute(character_type * p_character) override {
+		p_character->velocity = -p_character->velocity;
+		p_character->counter = 3;
+		p_character->wait();
+	}
+	void onMessage(character_type * p_character, message &msg) override {
+		//do nothing
+	}
+
+	static benchTurning* instance() {
+		static benchTurning inst;
+		return &inst;
+	}
+};
+
+template <class character_type>
+class benchWaiting : public state<character_type> {
+public:
+	void execute(character_type * p_character) override {
+		p_character->counter--;
+		if (p_character->counter == 0) {
+			p_character->move();
+		}
+	}
+	void onMessage(character_type * p_character, message &msg) override {
+		if (msg.letter == move_up) {
+			p_character->move();
+		}
+	}
+
+	static benchWaiting* instance() {
+		static benchWaiting inst;
+		return &inst;
+	}
+};
+
+/*
+* The benchmark characters, one for each machine. They are constructed in place in
+*	their vector since the machines point to their owners.
+*/
+struct benchVirtualCharacter {
+	float position;
+	float velocity;
+	uint32_t counter;
+	StateMachine<benchVirtualCharacter> machine;
+
+	benchVirtualCharacter() : position(0.0f), velocity(0.0f), counter(0), machine(this) {
+		machine.setCurrentState(benchMoving<benchVirtualCharacter>::instance());
+	}
+	void move() {
+		machine.setCurrentState(benchMoving<benchVirtualCharacter>::instance());
+	}
+	void turn() {
+		machine.setCurrentState(benchTurning<benchVirtualCharacter>::instance());
+	}
+	void wait() {
+		machine.setCurrentState(benchWaiting<benchVirtualCharacter>::instance());
+	}
+};
+
+struct benchStaticCharacter {
+	float position;
+	float velocity;
+	uint32_t counter;
+	StaticStateMachine<benchStaticCharacter,
+					   benchMoving<benchStaticCharacter>,
+					   benchTurning<benchStaticCharacter>,
+					   benchWaiting<benchStaticCharacter>> machine;
+
+	benchStaticCharacter() : position(0.0f), velocity(0.0f), counter(0), machine(this) {}
+	void move() {
+		machine.setCurrentState<benchMoving<benchStaticCharacter>>();
+	}
+	void turn() {
+		machine.setCurrentState<benchTurning<benchStaticCharacter>>();
+	}
+	void wait() {
+		machine.setCurrentState<benchWaiting<benchStaticCharacter>>();
+	}
+};
+
+/*
+* Function: runCharacters
+*
+* Paramters: std::vector<character_type> &characters,
+*			 uint32_t numOfTicks
+*
+* Return Type: double
+*
+* Description: gives the characters different speeds so they change states at different
+*				times, runs their machines for the ticks and sends every character a
+*				message every 8 ticks. Returns the seconds it took
+*
+*/
+template <class character_type>
+double runCharacters(std::vector<character_type> &characters, uint32_t numOfTicks) {
+	for (uint32_t i = 0; i < characters.size(); i++) {
+		characters[i].velocity = 0.01f + 0.001f * (float)(i % 97);
+	}
+
+	message msg;
+	msg.letter = move_up;
+	msg.sender_id = -1;
+	msg.reciever_id = -1;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (uint32_t tick = 0; tick < numOfTicks; tick++) {
+		for (character_type &character : characters) {
+			character.machine.runSM();
+		}
+		if (tick % 8 == 7) {
+			for (character_type &character : characters) {
+				character.machine.handleMessage(msg);
+			}
+		}
+	}
+	std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+	return elapsed.count();
+}
+/*
+* Function: getChecksum
+*
+* Paramters: const std::vector<character_type> &characters
+*
+* Return Type: double
+*
+* Description: adds the positions, the two machines must give the same sum
+*
+*/
+template <class character_type>
+double getChecksum(const std::vector<character_type> &characters) {
+	double sum = 0.0;
+	for (const character_type &character : characters) {
+		sum += character.position;
+	}
+	return sum;
+}
+
+/*
+* Function: getBallStart
+*
+* Paramters: uint32_t index,
+*			 glm::vec3 &location,
+*			 glm::vec3 &velocity
+*
+* Return Type: void
+*
+* Description: spreads the balls across the field with the speeds and angles a ball
+*				can have after hitting a paddle
+*
+*/
+static void getBallStart(uint32_t index, glm::vec3 &location, glm::vec3 &velocity) {
+	float speed = 0.0002f + 0.0001f * (float)(index % 10);
+	float angle = glm::radians(7.5f * (float)((int)(index % 11) - 5));
+	location = glm::vec3{ -0.85f + 1.7f * (float)(index % 89) / 88.0f, 0.035f, -0.7f + 1.4f * (float)(index % 101) / 100.0f };
+	velocity = glm::vec3{ speed * cos(angle), 0.0f, speed * sin(angle) };
+}
+
+/*
+* Constructor
+*/
+Benchmark::Benchmark() {
+}
+
+/*
+* Function: run
+*
+* Paramters: uint32_t numOfEntities,
+*			 std::ostream &out
+*
+* Return Type: void
+*
+* Description: runs every benchmark with numOfEntities characters and writes the results to out
+*
+*/
+void Benchmark::run(uint32_t numOfEntities, std::ostream &out) {
+	runStateMachines(numOfEntities, 100, out);
+	runBalls(numOfEntities, 100, out);
+}
+/*
+* Function: runStateMachines
+*
+* Paramters: uint32_t numOfEntities,
+*			 uint32_t numOfTicks,
+*			 std::ostream &out
+*
+* Return Type: void
+*
+* Description: runs numOfEntities characters with the virtual StateMachine and then with
+*				the StaticStateMachine for numOfTicks and writes the nanoseconds per update
+*				of a character, the size of each machine and how much faster the static
+*				machine was to out. The checksums show both ran the same game
+*
+*/
+void Benchmark::runStateMachines(uint32_t numOfEntities, uint32_t numOfTicks, std::ostream &out) {
+	double updates = (double)numOfEntities * (double)numOfTicks;
+	double virtualSeconds, staticSeconds, virtualSum, staticSum;
+	{
+		std::vector<benchVirtualCharacter> characters(numOfEntities);
+		virtualSeconds = runCharacters(characters, numOfTicks);
+		virtualSum = getChecksum(characters);
+	}
+	{
+		std::vector<benchStaticCharacter> characters(numOfEntities);
+		staticSeconds = runCharacters(characters, numOfTicks);
+		staticSum = getChecksum(characters);
+	}
+
+	out << "state machines  " << numOfEntities << " characters, " << numOfTicks << " ticks" << std::endl;
+	out << std::fixed << std::setprecision(2);
+	out << "virtual  ns/update " << std::setw(7) << virtualSeconds * 1e9 / updates
+		<< "  machine bytes " << sizeof(StateMachine<benchVirtualCharacter>)
+		<< "  checksum " << virtualSum << std::endl;
+	out << "static   ns/update " << std::setw(7) << staticSeconds * 1e9 / updates
+		<< "  machine bytes " << sizeof(benchStaticCharacter::machine)
+		<< "  checksum " << staticSum << std::endl;
+	out << "static speedup " << virtualSeconds / std::max(staticSeconds, 1e-9) << "x" << std::endl;
+}
+/*
+* Function: runBalls
+*
+* Paramters: uint32_t numOfBalls,
+*			 uint32_t numOfTicks,
+*			 std::ostream &out
+*
+* Return Type: void
+*
+* Description: moves numOfBalls balls for numOfTicks with PhysicsCalculator::integrate over
+*				an EntityStore and then with the batch kernels over a BallBatch, testing the
+*				batch against both paddles every tick, and writes the nanoseconds per ball
+*				and tick of each to out. The checksums of the positions show both moved the
+*				balls the same
+*
+*/
+void Benchmark::runBalls(uint32_t numOfBalls, uint32_t numOfTicks, std::ostream &out) {
+	PhysicsCalculator physics;
+	double updates = (double)numOfBalls * (double)numOfTicks;
+	double entitySeconds, stepSeconds, paddleSeconds, entitySum = 0.0, batchSum = 0.0;
+	uint64_t numOfHits = 0;
+	{
+		EntityStore entities;
+		for (uint32_t i = 0; i < numOfBalls; i++) {
+			glm::vec3 location, velocity;
+			getBallStart(i, location, velocity);
+			entities.add(NULL, location, 0.035f);
+			entities.getVelocities()[i] = velocity;
+		}
+
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (uint32_t tick = 0; tick < numOfTicks; tick++) {
+			physics.integrate(entities, 0, numOfBalls);
+		}
+		entitySeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		for (uint32_t i = 0; i < numOfBalls; i++) {
+			entitySum += entities.getLocations()[i].x + entities.getLocations()[i].z;
+		}
+	}
+	{
+		BallBatch balls;
+		for (uint32_t i = 0; i < numOfBalls; i++) {
+			glm::vec3 location, velocity;
+			getBallStart(i, location, velocity);
+			balls.add(location, velocity, 0.035f);
+		}
+		std::vector<uint8_t> hits(numOfBalls);
+		std::vector<float> distances(numOfBalls);
+
+		stepSeconds = 0.0;
+		paddleSeconds = 0.0;
+		for (uint32_t tick = 0; tick < numOfTicks; tick++) {
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			numOfHits += physics.testPaddle(balls, 0, numOfBalls, glm::vec3{ -0.9f, 0.0f, 0.0f }, 0.125f, 1.0f, hits.data(), distances.data());
+			numOfHits += physics.testPaddle(balls, 0, numOfBalls, glm::vec3{ 0.9f, 0.0f, 0.0f }, 0.125f, -1.0f, hits.data(), distances.data());
+			std::chrono::steady_clock::time_point stepStart = std::chrono::steady_clock::now();
+			physics.stepBalls(balls, 0, numOfBalls);
+			std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+			paddleSeconds += std::chrono::duration<double>(stepStart - start).count();
+			stepSeconds += std::chrono::duration<double>(end - stepStart).count();
+		}
+
+		for (uint32_t i = 0; i < numOfBalls; i++) {
+			batchSum += balls.getX()[i] + balls.getZ()[i];
+		}
+	}
+
+	out << "balls  " << numOfBalls << " balls, " << numOfTicks << " ticks, sse " << (PHYSICS_SSE ? "on" : "off") << std::endl;
+	out << std::fixed << std::setprecision(2);
+	out << "integrate     ns/ball " << std::setw(7) << entitySeconds * 1e9 / updates << "  checksum " << entitySum << std::endl;
+	out << "batch step    ns/ball " << std::setw(7) << stepSeconds * 1e9 / updates << "  checksum " << batchSum << std::endl;
+	out << "batch paddles ns/ball " << std::setw(7) << paddleSeconds * 1e9 / updates << "  hits " << numOfHits << std::endl;
+	out << "batch speedup " << entitySeconds / std::max(stepSeconds, 1e-9) << "x" << std::endl;
+}
@@ -0,0 +1,32 @@
+/****************************************************************************************
+* TITLE:	2D-Pong in 3D																*
+* BY:		Eric Hollas																	*
+*																						*
+* FILE:		Benchmark.h																	*
+* DETAILS:	This file defines the benchmarks that run without a window or render		*
+*				engine. They are run with the --benchmark argument, see main.cpp.		*
+*			runStateMachines compares the virtual StateMachine with the					*
+*				StaticStateMachine. Millions of small characters, each with its own		*
+*				machine of three states, are run for a number of ticks with each of		*
+*				the two and the time of an update and the size of a machine are			*
+*				written out. The states and characters are the same for both, only		*
+*				the machine differs.													*
+*			runBalls compares moving balls one at a time in the EntityStore with		*
+*				PhysicsCalculator::integrate to moving them in a BallBatch with the		*
+*				batch kernels, for the same balls on the same field.					*
+*																						*
+*****************************************************************************************/
+
+
+#pragma once
+#include "stdafx.h"
+
+class Benchmark {
+public:
+	Benchmark();
+
+	void run(uint32_t numOfEntities, std::ostream &out);
+
+	void runStateMachines(uint32_t numOfEntities, uint32_t numOfTicks, std::ostream &out);
+	void runBalls(uint32_t numOfBalls, uint32_t numOfTicks, std::ostream &out);
+};
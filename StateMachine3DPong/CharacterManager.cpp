@@ -13,11 +13,24 @@
 #include "ScenicObjects.h"
 #include "Character_Ball.h"
 #include "Character_Paddle.h"
+#include "PhysicsCalculator.h"
 
 /*
 * Constructor
+*
+* Parameters: Messanger &dispatch,
+*			  PhysicsCalculator &physics,
+*			  uint32_t numOfWorkers
+*
+* the thread that calls runFSMs takes tasks too, so a manager that has the hardware
+*	threads to itself uses one less worker than the hardware threads and a manager
+*	that shares them with other managers uses none
+*
 */
-CharacterManager::CharacterManager() {
+CharacterManager::CharacterManager(Messanger &dispatch, PhysicsCalculator &physics, uint32_t numOfWorkers)
+	: workers(numOfWorkers) {
+	p_dispatch = &dispatch;
+	p_physics = &physics;
 	//scenic objects are defined in GeometryManager()
 	p_Offsets = new Geometry::GeometryManager();
 	initScenicCharacters();
@@ -30,8 +43,7 @@ CharacterManager::CharacterManager() {
 * DeConstructor
 */
 CharacterManager::~CharacterManager() {
-	uniformMatrices.~vector();
-	p_Offsets->~GeometryManager();
+	delete p_Offsets;
 }
 
 /*
@@ -42,13 +54,14 @@ CharacterManager::~CharacterManager() {
 * Return Type: void
 *
 * Description: takes the parameter and adds its vertex and index info
-*				to the p_Offsets member variable, adds its uniform matrix
-*				to the uniformMatrices, and adds the character to the MasterList
+*				to the p_Offsets member variable and adds its uniform matrix
+*				to the uniformMatrices. The character must have been created
+*				with the entities of this manager (see getEntities), the
+*				characters are added in the order they were created
 *
 */
 void CharacterManager::AddCharacter(BaseCharacter * newCharacter) {
 	p_Offsets->addObject(newCharacter->getVertices(), newCharacter->getIndices());
-	MasterList.insert({ newCharacter->getID(), newCharacter });
 	uniformMatrices.push_back(newCharacter->getUniformMatrix());
 }
 /*
@@ -58,13 +71,11 @@ void CharacterManager::AddCharacter(BaseCharacter * newCharacter) {
 *
 * Return Type: void
 *
-* Description: uses the parameter to delete that character from the list with a matching id
-*				note that id's should be unique
+* Description: deletes the character, which removes it from the entities
 *
 */
 void CharacterManager::DeleteCharacter(BaseCharacter * character) {
-	MasterList.erase(character->getID());
-	character->~BaseCharacter();
+	delete character;
 }
 
 /*
@@ -74,8 +85,8 @@ void CharacterManager::DeleteCharacter(BaseCharacter * character) {
 *
 * Return Type: void
 *
-* Description: The score characters will be the last characters in the MasterList
-*				this needs to be ensured in the initCharacters function in the Window class.
+* Description: The score characters will be the last characters in the entities
+*				this needs to be ensured in the initCharacters function in the Match class.
 *				The score characters vertex and index info will change, so this function 
 *				deletes from p_Offsets and updates p_Offsets with the new vertex and index info.
 *
@@ -84,10 +95,10 @@ void CharacterManager::updateOffsets() {
 	p_Offsets->deleteLast();
 	p_Offsets->deleteLast();
 
-	int index = MasterList.size();
+	uint32_t index = entities.size();
 
-	p_Offsets->addObject(MasterList[index - 2]->getVertices(), MasterList[index - 2]->getIndices());
-	p_Offsets->addObject(MasterList[index - 1]->getVertices(), MasterList[index - 1]->getIndices());
+	p_Offsets->addObject(entities.getOwner(index - 2)->getVertices(), entities.getOwner(index - 2)->getIndices());
+	p_Offsets->addObject(entities.getOwner(index - 1)->getVertices(), entities.getOwner(index - 1)->getIndices());
 }
 /*
 * Function: runFSMs
@@ -97,19 +108,56 @@ void CharacterManager::updateOffsets() {
 * Return Type: void
 *
 * Description: This function will run the states via the runCycle functions of all the characters in
-*				the MasterList. It also determines if the score characters vertex and index info changed
+*				the entities. It also determines if the score characters vertex and index info changed
 *				and updates them accordingly. The function finishes with updating the uniformMatrices
 *				after all the events have been calculated this cycle.
+*				The characters run in parallel and only read their own data and their mail.
+*				Once all of them ran, and so every paddle moved, each shard moves its
+*				characters along their velocities. The messages sent are committed after
+*				that, in the order of the characters and then of the shards (see
+*				CharacterManager.h).
 *
 */
 bool CharacterManager::runFSMs() {
+	uint32_t numOfCharacters = entities.size();
+	uint32_t numOfShards = (numOfCharacters + FSM_SHARD_SIZE - 1) / FSM_SHARD_SIZE;
+	outboxes.resize(numOfCharacters);
+	cycleResults.resize(numOfCharacters);
+	physicsOutboxes.resize(numOfShards);
+
+	//the first phase, the messages sent on each thread go to the outbox of the character it runs
+	workers.run(numOfShards, [this, numOfCharacters](uint32_t shard) {
+		uint32_t first = shard * FSM_SHARD_SIZE;
+		uint32_t last = std::min(numOfCharacters, first + FSM_SHARD_SIZE);
+		for (uint32_t i = first; i < last; i++) {
+			outboxes[i].clear();
+			Messanger::deferTo(&outboxes[i]);
+			cycleResults[i] = entities.getOwner(i)->runCycle();
+		}
+		Messanger::deferTo(NULL);
+	});
+
+	//the physics of a shard reads the paddles of the other shards, so it waits until all of them ran
+	workers.run(numOfShards, [this, numOfCharacters](uint32_t shard) {
+		uint32_t first = shard * FSM_SHARD_SIZE;
+		uint32_t last = std::min(numOfCharacters, first + FSM_SHARD_SIZE);
+		physicsOutboxes[shard].clear();
+		Messanger::deferTo(&physicsOutboxes[shard]);
+		p_physics->integrate(entities, first, last);
+		Messanger::deferTo(NULL);
+	});
+
+	//the second phase
 	bool updateOffsets = false;
-	for (uint32_t i = 0; i < MasterList.size(); i++) {
-		bool flag = MasterList[i]->runCycle();
-		if (!flag) {
+	for (uint32_t i = 0; i < numOfCharacters; i++) {
+		p_dispatch->commit(outboxes[i]);
+		if (!cycleResults[i]) {
 			updateOffsets = true;
 		}
 	}
+	for (uint32_t shard = 0; shard < numOfShards; shard++) {
+		p_dispatch->commit(physicsOutboxes[shard]);
+	}
 	updateMatrices();
 
 	return updateOffsets;
@@ -124,16 +172,16 @@ bool CharacterManager::runFSMs() {
 * Return Type: void
 *
 * Description: processes the user input from the window class and sends 
-*				a message via DISPATCH, the messanger instance, to the
+*				a message via the messanger of the match to the
 *				user controlled paddle
 *
 */
 void CharacterManager::userInput(bool up, bool down, int user_id) {
 	if (up) {
-		DISPATCH->collect(move_up, user_id, -1);
+		p_dispatch->collect(move_up, user_id, -1);
 	}
 	if (down) {
-		DISPATCH->collect(move_down, user_id, -1);
+		p_dispatch->collect(move_down, user_id, -1);
 	}
 }
 
@@ -141,10 +189,37 @@ void CharacterManager::userInput(bool up, bool down, int user_id) {
 std::vector<glm::mat4> CharacterManager::getUniformMatrices() const {
 	return uniformMatrices;
 }
+/*
+* Function: getInterpolatedMatrices
+*
+* Paramters: float alpha
+*
+* Return Type: std::vector<glm::mat4>
+*
+* Description: returns the uniform matrices between the last two ticks, alpha 0 is the
+*				tick before the last and 1 is the last. Only the positions are blended,
+*				the rotations are those of the last tick. If a character was added since
+*				the tick before the last the last tick's matrices are returned
+*
+*/
+std::vector<glm::mat4> CharacterManager::getInterpolatedMatrices(float alpha) const {
+	if (previousMatrices.size() != uniformMatrices.size()) {
+		return uniformMatrices;
+	}
+	std::vector<glm::mat4> matrices(uniformMatrices);
+	for (size_t i = 0; i < matrices.size(); i++) {
+		matrices[i][3] = previousMatrices[i][3] + (uniformMatrices[i][3] - previousMatrices[i][3]) * alpha;
+	}
+	return matrices;
+}
 //getter method
 Geometry::GeometryManager* CharacterManager::getOffsets() const {
 	return p_Offsets;
 }
+//getter method, the characters of this manager are created with these entities
+EntityStore & CharacterManager::getEntities() {
+	return entities;
+}
 
 
 /*
@@ -183,17 +258,18 @@ void CharacterManager::initScenicCharacters() {
 *
 * Description: Gets the updated matrices from the characters after the cycle has run.
 *				Make sure to call this before returning the uniformMatrices class
-*				member or the matrices could be out of date
+*				member or the matrices could be out of date. The matrices of the
+*				tick before are kept for getInterpolatedMatrices
 *
 */
 void CharacterManager::updateMatrices() {
+	previousMatrices.swap(uniformMatrices);
 	uniformMatrices.clear();
 	//this first while loop is for the scenic objects uniform matrices
-	for (uint32_t i = 0; i < (p_Offsets->getNumOfObjects() - MasterList.size()); i++) {
+	for (uint32_t i = 0; i < (p_Offsets->getNumOfObjects() - entities.size()); i++) {
 		uniformMatrices.push_back(glm::mat4(1.0f));
 	}
-	for (uint32_t i = 0; i < MasterList.size(); i++) {
-		uniformMatrices.push_back(MasterList[i]->getUniformMatrix());
-		
-	}
+	//the matrices of the characters are contiguous in the entities
+	const glm::mat4 * matrices = entities.getMatrices();
+	uniformMatrices.insert(uniformMatrices.end(), matrices, matrices + entities.size());
 }
\ No newline at end of file
@@ -4,9 +4,21 @@
 *																						*
 * FILE:		CharacterManager.h															*
 * DETAILS:	This file defines the class that will work as the overall manager of all	*
-*				the states, the physics, the ai, the messanger, and all of the			*
-*				characters. This, in the window class, will interface with the render	*
-*				engine to form the game.												*
+*				the states and all of the characters of a Match, using the match's		*
+*				physics and messanger. This, in the window class, will interface with	*
+*				the render engine to form the game.										*
+*			The characters are updated in two phases every tick. First every character	*
+*				handles the mail of the last tick and runs its state, in parallel on	*
+*				the WorkerPool in shards of FSM_SHARD_SIZE characters, and the messages	*
+*				it sends are kept in its own outbox. Once all of them ran the shards	*
+*				are moved by the physics, which sees every paddle where it is this		*
+*				tick, and the hits it finds are kept in the outbox of the shard. Then	*
+*				the outboxes are committed in the order of the characters and then of	*
+*				the shards, so the messages of a tick are read the next tick and the	*
+*				game is the same however the characters are sharded.					*
+*			The characters are created in the EntityStore of the manager, which keeps	*
+*				their locations, velocities, radii and uniform matrices in contiguous	*
+*				arrays and the characters in the order they were created.				*
 *																						*
 *****************************************************************************************/
 
@@ -14,11 +26,17 @@
 #pragma once
 #include "stdafx.h"
 #include "BaseCharacter.h"
+#include "WorkerPool.h"
+#include "Messanger.h"
+#include "PhysicsCalculator.h"
 #include "../../VulkanRenderEngine/RenderEngine/GeometryManager.h"
 
+//the characters one task of the worker pool runs each tick, fewer characters run on the main thread
+#define FSM_SHARD_SIZE 256
+
 class CharacterManager {
 public:
-	CharacterManager();
+	CharacterManager(Messanger &dispatch, PhysicsCalculator &physics, uint32_t numOfWorkers);
 	~CharacterManager();
 
 	void AddCharacter(BaseCharacter * newCharacter);
@@ -31,16 +49,29 @@ public:
 	void userInput(bool up, bool down, int user_id);
 	
 	std::vector<glm::mat4> getUniformMatrices() const;
+	std::vector<glm::mat4> getInterpolatedMatrices(float alpha) const;
 	Geometry::GeometryManager* getOffsets() const;
+	EntityStore & getEntities();
 
 private:
-	typedef std::map<int, BaseCharacter*> characterMap;
+	Messanger * p_dispatch;
+	PhysicsCalculator * p_physics;
+
+	EntityStore entities;
+
+	//the outbox and the result of runCycle of each character for the current tick
+	std::vector<std::vector<message>> outboxes;
+	std::vector<uint8_t> cycleResults;
+	//the outbox of the physics of each shard for the current tick
+	std::vector<std::vector<message>> physicsOutboxes;
 
-	characterMap MasterList;
+	WorkerPool workers;
 
 	Geometry::GeometryManager * p_Offsets;
 
+	//the matrices after the last tick and after the tick before it
 	std::vector<glm::mat4> uniformMatrices;
+	std::vector<glm::mat4> previousMatrices;
 
 	void initScenicCharacters();
 	void updateMatrices();
@@ -16,16 +16,21 @@
 /*
 * Constructor
 *
-* Parameters: float radius
+* Parameters: Match &match
+*			  float radius
 *			  glm::vec3 initPosition
 *
 * parameters are passed to BaseCharacter class and initializes the member vectors
 *
 */
-Character_Ball::Character_Ball(float radius, glm::vec3 initPosition)
-			  : BaseCharacter(radius, initPosition) {
-	p_StateMachine = new StateMachine<Character_Ball>(this);
-	p_StateMachine->setCurrentState(State_BallTowardsPlayer::instance());
+Character_Ball::Character_Ball(Match &match, float radius, glm::vec3 initPosition)
+			  : BaseCharacter(match, radius, initPosition) {
+	//the ball has no peers until setPeers is called
+	EntityHandle none = { UINT32_MAX, 0 };
+	setPeers(none, none, none, none);
+
+	p_StateMachine = new ballMachine(this);
+	p_StateMachine->setCurrentState<State_BallTowardsPlayer>();
 	initMesh();
 	resetBall();
 }
@@ -33,7 +38,7 @@ Character_Ball::Character_Ball(float radius, glm::vec3 initPosition)
 * Deconstructor
 */
 Character_Ball::~Character_Ball() {
-	//p_StateMachine->~StateMachine();
+	delete p_StateMachine;
 }
 
 /*
@@ -182,52 +187,52 @@ bool Character_Ball::runCycle() {
 *
 */
 void Character_Ball::handleMessages() {
-	std::deque<message> mail = getMail();
-	while (!(mail.empty())) {
-		p_StateMachine->handleMessage(mail.front());
-		mail.pop_front();
+	mailSpan mail = getMail();
+	for (message &letter : mail) {
+		p_StateMachine->handleMessage(letter);
 	}
-	readMessages();
+	readMessages(mail);
 }
 /*
-* Function: reflect
+* Function: aimAtComputer
 *
 * Paramters: none
 *
 * Return Type: void
 *
-* Description: changes the member functions to reflect the trajectory
+* Description: changes the state of the ball to BallTowardsComputerState
 *
 */
-void Character_Ball::reflect() {
-	setUniformMatrix(glm::translate(glm::mat4(1.0f), getLocation()));
-	heading.isReflecting = !heading.isReflecting;
+void Character_Ball::aimAtComputer() {
+	p_StateMachine->setCurrentState<State_BallTowardsComputer>();
 }
 /*
-* Function: aimAtComputer
+* Function: aimAtUser
 *
 * Paramters: none
 *
 * Return Type: void
 *
-* Description: changes the state of the ball to BallTowardsComputerState
+* Description: changes the state of the ball to BallTowardsPlayerState
 *
 */
-void Character_Ball::aimAtComputer() {
-	p_StateMachine->setCurrentState(State_BallTowardsComputer::instance());
+void Character_Ball::aimAtUser() {
+	p_StateMachine->setCurrentState<State_BallTowardsPlayer>();
 }
 /*
-* Function: aimAtUser
+* Function: followVelocity
 *
 * Paramters: none
 *
 * Return Type: void
 *
-* Description: changes the state of the ball to BallTowardsPlayerState
+* Description: sets the trajectory info to the velocity the physics calculator gave the
+*				ball, after it was sent off by a paddle (see PhysicsCalculator::integrate)
 *
 */
-void Character_Ball::aimAtUser() {
-	p_StateMachine->setCurrentState(State_BallTowardsPlayer::instance());
+void Character_Ball::followVelocity() {
+	glm::vec3 velocity = getVelocity();
+	setTrajectoryInfo(glm::length(velocity), glm::degrees(std::atan2(velocity.z, velocity.x)));
 }
 /*
 * Function: setTrajectoryInfo
@@ -237,16 +242,39 @@ void Character_Ball::aimAtUser() {
 *
 * Return Type: void
 *
-* Description: initializes the trajectory info, used to calculate the uniform matrix
+* Description: initializes the trajectory info and the velocity the ball rolls
+*				with, see PhysicsCalculator::integrate
 *
 */
 void Character_Ball::setTrajectoryInfo(float speed, float degrees) {
 	heading.speed = speed;
 	heading.degrees = degrees;
-	heading.isReflecting = false;
 
 	float axis = glm::radians(heading.degrees - 90.0f);
 	heading.rotation_axis = glm::vec3{ cos(axis), 0.0f, sin(axis) };
+
+	float angle = glm::radians(heading.degrees);
+	setVelocity(glm::vec3{ speed * cos(angle), 0.0f, speed * sin(angle) });
+}
+/*
+* Function: setPeers
+*
+* Paramters: EntityHandle userPaddle,
+*			 EntityHandle computerPaddle,
+*			 EntityHandle homeScore,
+*			 EntityHandle awayScore
+*
+* Return Type: void
+*
+* Description: stores the handles of the characters the ball sends messages to, and
+*				that send it the collisions. Called in Match::initCharacters
+*
+*/
+void Character_Ball::setPeers(EntityHandle userPaddle, EntityHandle computerPaddle, EntityHandle homeScore, EntityHandle awayScore) {
+	others.user_paddle = userPaddle;
+	others.computer_paddle = computerPaddle;
+	others.home_score = homeScore;
+	others.away_score = awayScore;
 }
 /*
 * Function: resetBall
@@ -262,16 +290,14 @@ void Character_Ball::setTrajectoryInfo(float speed, float degrees) {
 void Character_Ball::resetBall() {
 	setLocation(glm::vec3{ 0.0f, getRadius(), 0.0f });
 	setUniformMatrix(glm::translate(glm::mat4(1.0f), getLocation()));
-	heading.rotation_axis = glm::vec3{ 0.0f, 0.0f, 1.0f };
-	heading.speed = 0.0002f;
-	heading.degrees = 180.0f;
-	heading.isReflecting = false;
-	p_StateMachine->setCurrentState(State_BallTowardsPlayer::instance());
+	setTrajectoryInfo(0.0002f, 180.0f);
+	aimAtUser();
 }
 
 /*
 * 
-* The last three functions in this file are getter methods
+* The rest of the functions in this file are getter methods, the ids of the peers
+* are -1 once the peer was removed
 *
 */
 float Character_Ball::getTrajectorySpeed() const {
@@ -282,4 +308,16 @@ float Character_Ball::getTrajectoryAngle() const {
 }
 glm::vec3 Character_Ball::getRoationAxis() const {
 	return heading.rotation_axis;
+}
+int Character_Ball::getUserPaddleID() const {
+	return getPeerID(others.user_paddle);
+}
+int Character_Ball::getComputerPaddleID() const {
+	return getPeerID(others.computer_paddle);
+}
+int Character_Ball::getHomeScoreID() const {
+	return getPeerID(others.home_score);
+}
+int Character_Ball::getAwayScoreID() const {
+	return getPeerID(others.away_score);
 }
\ No newline at end of file
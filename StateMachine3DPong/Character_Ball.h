@@ -3,50 +3,69 @@
 * BY:		Eric Hollas																	*
 *																						*
 * FILE:		BallCharacter.h																*
-* DETAILS:	This file defines the ball object which inherits from the BaseCharacter 	*
+* DETAILS:	This file defines the ball object which inherits from the BaseCharacter		*
 *				class in the Geometry file. Note that initMesh() must be called for		*
 *				for the vertices and indices to have any values.						*
+*			The ball sends its messages to the paddles and scores set with setPeers,	*
+*				it knows them by their handles (see BaseCharacter::getPeerID).			*
 *																						*
 *****************************************************************************************/
 
 #pragma once
 #include "stdafx.h"
 #include "BaseCharacter.h"
-#include "StateMachine.h"
+#include "StaticStateMachine.h"
+
+class State_BallTowardsPlayer;
+class State_BallTowardsComputer;
 
 class Character_Ball : public BaseCharacter {
 public:
-	Character_Ball(float radius, glm::vec3 initPosition);
+	Character_Ball(Match &match, float radius, glm::vec3 initPosition);
 	~Character_Ball();
 
 	void initMesh(Constants::color shade = Constants::black) override;
 	bool runCycle() override;
 	void handleMessages() override;
 
-	void reflect();
 	void aimAtComputer();
 	void aimAtUser();
+	void followVelocity();
 
 	void setTrajectoryInfo(float speed, float degrees);
+	void setPeers(EntityHandle userPaddle, EntityHandle computerPaddle, EntityHandle homeScore, EntityHandle awayScore);
 	void resetBall();
 
 	float getTrajectorySpeed() const;
 	float getTrajectoryAngle() const;
 	glm::vec3 getRoationAxis() const;
 
-	bool isReflecting() const {
-		return heading.isReflecting;
-	}
+	int getUserPaddleID() const;
+	int getComputerPaddleID() const;
+	int getHomeScoreID() const;
+	int getAwayScoreID() const;
 
 private:
+	struct peers {
+		EntityHandle user_paddle;
+		EntityHandle computer_paddle;
+		EntityHandle home_score;
+		EntityHandle away_score;
+	};
+
+	peers others;
+
 	struct trajectory {
 		glm::vec3 rotation_axis;
 		float speed;
 		float degrees;
-		bool isReflecting;
 	};
 
 	trajectory heading;
 
-	StateMachine<Character_Ball> * p_StateMachine;
+	typedef StaticStateMachine<Character_Ball,
+							   State_BallTowardsPlayer,
+							   State_BallTowardsComputer> ballMachine;
+
+	ballMachine * p_StateMachine;
 };
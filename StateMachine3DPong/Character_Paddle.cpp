@@ -18,22 +18,24 @@
 /*
 * Constructor
 *
-* Parameters: std::string title
+* Parameters: Match &match
 *			  float radius
 *			  glm::vec3 initPosition
 *
 * parameters are passed to BaseCharacter class
 *
 */
-Character_Paddle::Character_Paddle(float radius, glm::vec3 initPosition)
-				: BaseCharacter(radius, initPosition) {
-	p_StateMachine = new StateMachine<Character_Paddle>(this);
-	p_StateMachine->setCurrentState(State_PaddleStagnent::instance());
+Character_Paddle::Character_Paddle(Match &match, float radius, glm::vec3 initPosition)
+				: BaseCharacter(match, radius, initPosition) {
+	p_StateMachine = new paddleMachine(this);
+	p_StateMachine->setCurrentState<State_PaddleStagnent>();
 }
 /*
 * Deconstructor
 */
-Character_Paddle::~Character_Paddle() {}
+Character_Paddle::~Character_Paddle() {
+	delete p_StateMachine;
+}
 
 /*
 * Function: initMesh
@@ -129,12 +131,11 @@ bool Character_Paddle::runCycle() {
 *
 */
 void Character_Paddle::handleMessages() {
-	std::deque<message> mail = getMail();
-	while (!(mail.empty())) {
-		p_StateMachine->handleMessage(mail.front());
-		mail.pop_front();
+	mailSpan mail = getMail();
+	for (message &letter : mail) {
+		p_StateMachine->handleMessage(letter);
 	}
-	readMessages();
+	readMessages(mail);
 }
 
 /*
@@ -142,14 +143,14 @@ void Character_Paddle::handleMessages() {
 *     to the various other states.
 */
 void Character_Paddle::stopMoving() {
-	p_StateMachine->setCurrentState(State_PaddleStagnent::instance());
+	p_StateMachine->setCurrentState<State_PaddleStagnent>();
 }
 void Character_Paddle::moveUp() {
-	p_StateMachine->setCurrentState(State_PaddleMoveNegative::instance());
+	p_StateMachine->setCurrentState<State_PaddleMoveNegative>();
 }
 void Character_Paddle::moveDown() {
-	p_StateMachine->setCurrentState(State_PaddleMovePositive::instance());
+	p_StateMachine->setCurrentState<State_PaddleMovePositive>();
 }
 void Character_Paddle::getSmart() {
-	p_StateMachine->setCurrentState(State_PaddleSmartMove::instance());
+	p_StateMachine->setCurrentState<State_PaddleSmartMove>();
 }
\ No newline at end of file
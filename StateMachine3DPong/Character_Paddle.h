@@ -12,12 +12,17 @@
 #pragma once
 #include "stdafx.h"
 #include "BaseCharacter.h"
-#include "StateMachine.h"
+#include "StaticStateMachine.h"
+
+class State_PaddleStagnent;
+class State_PaddleMoveNegative;
+class State_PaddleMovePositive;
+class State_PaddleSmartMove;
 
 //supported colors are red, green, or blue
 class Character_Paddle : public BaseCharacter {
 public:
-	Character_Paddle(float radius, glm::vec3 initPosition);
+	Character_Paddle(Match &match, float radius, glm::vec3 initPosition);
 	~Character_Paddle();
 
 	void initMesh(Constants::color shade) override;
@@ -30,5 +35,11 @@ public:
 	void getSmart();
 
 private:
-	StateMachine<Character_Paddle> * p_StateMachine;
+	typedef StaticStateMachine<Character_Paddle,
+							   State_PaddleStagnent,
+							   State_PaddleMoveNegative,
+							   State_PaddleMovePositive,
+							   State_PaddleSmartMove> paddleMachine;
+
+	paddleMachine * p_StateMachine;
 };
\ No newline at end of file
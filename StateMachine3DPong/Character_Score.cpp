@@ -162,17 +162,21 @@ bool Character_Score::score::inc() {
 /*
 * Constructor
 *
-* Parameters: glm::vec3 initPosition
+* Parameters: Match &match
+*			  glm::vec3 initPosition
 *
 * there is no radius, so just pass 0.0f for the radius
 *
 */
-Character_Score::Character_Score(glm::vec3 initLocation)
-			   : BaseCharacter(0.0f, initLocation) {
-	p_StateMachine = new StateMachine<Character_Score>(this);
-	p_StateMachine->setCurrentState(State_Score::instance());
+Character_Score::Character_Score(Match &match, glm::vec3 initLocation)
+			   : BaseCharacter(match, 0.0f, initLocation) {
+	p_StateMachine = new StaticStateMachine<Character_Score, State_Score>(this);
 
 	p_points = new score();
+	num_of_points = 0;
+	//no opponent until setOpponent is called
+	opponent.slot = UINT32_MAX;
+	opponent.generation = 0;
 
 	//determines if this is user or computer score
 	if (initLocation.x > 1.0f) {
@@ -189,6 +193,8 @@ Character_Score::Character_Score(glm::vec3 initLocation)
 * Deconstructor
 */
 Character_Score::~Character_Score() {
+	delete p_StateMachine;
+	delete p_points;
 }
 
 /*
@@ -240,12 +246,11 @@ bool Character_Score::runCycle() {
 *
 */
 void Character_Score::handleMessages() {
-	std::deque<message> mail = getMail();
-	while (!(mail.empty())) {
-		p_StateMachine->handleMessage(mail.front());
-		mail.pop_front();
+	mailSpan mail = getMail();
+	for (message &letter : mail) {
+		p_StateMachine->handleMessage(letter);
 	}
-	readMessages();
+	readMessages(mail);
 }
 
 /*
@@ -275,9 +280,32 @@ void Character_Score::ScoreReset() {
 *
 */
 bool Character_Score::ScorePoint() {
+	num_of_points++;
 	bool needsReset = p_points->inc();
 
 	initMesh();
 
 	return needsReset;
-}
\ No newline at end of file
+}
+/*
+* Function: setOpponent
+*
+* Paramters: EntityHandle otherScore
+*
+* Return Type: void
+*
+* Description: stores the handle of the other score, it is sent game_over when this
+*				score wins the game. Called in Match::initCharacters
+*
+*/
+void Character_Score::setOpponent(EntityHandle otherScore) {
+	opponent = otherScore;
+}
+//getter method, the points scored since the character was created
+uint32_t Character_Score::getNumOfPoints() const {
+	return num_of_points;
+}
+//getter method, -1 once the other score was removed
+int Character_Score::getOpponentID() const {
+	return getPeerID(opponent);
+}
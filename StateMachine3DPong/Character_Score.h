@@ -3,9 +3,10 @@
 * BY:		Eric Hollas																	*
 *																						*
 * FILE:		ScoreCharacter.h															*
-* DETAILS:	This file defines the ScoreCharacter inherits from the BaseCharacter class. *
+* DETAILS:	This file defines the ScoreCharacter inherits from the BaseCharacter class.	*
 *				This character will be the score that is posted. One for the user and	*
-*				another for the computer.												*
+*				another for the computer. Each score knows the other one by its			*
+*				handle, set with setOpponent.											*
 *																						*
 *****************************************************************************************/
 
@@ -14,11 +15,13 @@
 #include "stdafx.h"
 #include "Numbers.h"
 #include "BaseCharacter.h"
-#include "StateMachine.h"
+#include "StaticStateMachine.h"
+
+class State_Score;
 
 class Character_Score : public BaseCharacter {
 public:
-	Character_Score(glm::vec3 initLocation);
+	Character_Score(Match &match, glm::vec3 initLocation);
 	~Character_Score();
 
 	void initMesh(Constants::color shade = Constants::gray) override;
@@ -29,6 +32,11 @@ public:
 
 	bool ScorePoint();
 
+	void setOpponent(EntityHandle otherScore);
+
+	uint32_t getNumOfPoints() const;
+	int getOpponentID() const;
+
 private:
 	struct score {
 		uint8_t value;
@@ -44,5 +52,8 @@ private:
 	};
 
 	score * p_points;
-	StateMachine<Character_Score> * p_StateMachine;
+	//every point scored, the score shown is reset after each game but this is not
+	uint32_t num_of_points;
+	EntityHandle opponent;
+	StaticStateMachine<Character_Score, State_Score> * p_StateMachine;
 };
\ No newline at end of file
@@ -0,0 +1,144 @@
+/****************************************************************************************
+* TITLE:	2D-Pong in 3D																*
+* BY:		Eric Hollas																	*
+*																						*
+* FILE:		EntityStore.cpp																*
+*																						*
+* Correponds to EntityStore.h (see for overall description)								*
+*																						*
+*****************************************************************************************/
+
+
+#include "stdafx.h"
+#include "EntityStore.h"
+
+/*
+* Constructor
+*/
+EntityStore::EntityStore() {
+}
+/*
+* Deconstructor
+*/
+EntityStore::~EntityStore() {
+}
+
+/*
+* Function: add
+*
+* Paramters: BaseCharacter * owner,
+*			 glm::vec3 location,
+*			 float radius
+*
+* Return Type: EntityHandle
+*
+* Description: adds an entity at the end of the arrays with no velocity and a uniform
+*				matrix of identity, and returns its handle. A slot freed by remove is
+*				used again before a new slot is added, so the slots stay small numbers
+*
+*/
+EntityHandle EntityStore::add(BaseCharacter * owner, glm::vec3 location, float radius) {
+	EntityHandle handle;
+	if (free_slots.empty()) {
+		slot temp = { 0, 0 };
+		handle.slot = (uint32_t)slots.size();
+		slots.push_back(temp);
+	}
+	else {
+		handle.slot = free_slots.back();
+		free_slots.pop_back();
+	}
+	handle.generation = slots[handle.slot].generation;
+	slots[handle.slot].index = (uint32_t)owners.size();
+
+	locations.push_back(location);
+	velocities.push_back(glm::vec3{ 0.0f, 0.0f, 0.0f });
+	radii.push_back(radius);
+	matrices.push_back(glm::mat4(1.0f));
+	owners.push_back(owner);
+	owner_slots.push_back(handle.slot);
+
+	return handle;
+}
+/*
+* Function: remove
+*
+* Paramters: EntityHandle handle
+*
+* Return Type: void
+*
+* Description: removes the entity, the entities after it move down one place so the
+*				arrays keep the order they were added in (see EntityStore.h),
+*				a handle that is not valid is ignored
+*
+*/
+void EntityStore::remove(EntityHandle handle) {
+	if (!isValid(handle)) {
+		return;
+	}
+
+	uint32_t index = slots[handle.slot].index;
+
+	locations.erase(locations.begin() + index);
+	velocities.erase(velocities.begin() + index);
+	radii.erase(radii.begin() + index);
+	matrices.erase(matrices.begin() + index);
+	owners.erase(owners.begin() + index);
+	owner_slots.erase(owner_slots.begin() + index);
+	for (uint32_t i = index; i < (uint32_t)owner_slots.size(); i++) {
+		slots[owner_slots[i]].index = i;
+	}
+
+	slots[handle.slot].generation++;
+	free_slots.push_back(handle.slot);
+}
+
+/*
+* Function: isValid
+*
+* Paramters: EntityHandle handle
+*
+* Return Type: bool
+*
+* Description: returns true if the entity of the handle has not been removed
+*
+*/
+bool EntityStore::isValid(EntityHandle handle) const {
+	return handle.slot < slots.size() && slots[handle.slot].generation == handle.generation;
+}
+/*
+* Function: find
+*
+* Paramters: EntityHandle handle
+*
+* Return Type: uint32_t
+*
+* Description: returns the index of the entity in the arrays, the handle must be valid.
+*				The index changes when another entity is removed, the handle does not
+*
+*/
+uint32_t EntityStore::find(EntityHandle handle) const {
+	return slots[handle.slot].index;
+}
+
+/*
+* The rest of the functions in this file are getter functions
+*/
+uint32_t EntityStore::size() const {
+	return (uint32_t)owners.size();
+}
+glm::vec3 * EntityStore::getLocations() {
+	return locations.data();
+}
+glm::vec3 * EntityStore::getVelocities() {
+	return velocities.data();
+}
+float * EntityStore::getRadii() {
+	return radii.data();
+}
+glm::mat4 * EntityStore::getMatrices() {
+	return matrices.data();
+}
+BaseCharacter * EntityStore::getOwner(uint32_t index) const {
+	return owners[index];
+}
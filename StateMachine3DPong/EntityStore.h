@@ -0,0 +1,67 @@
+/****************************************************************************************
+* TITLE:	2D-Pong in 3D																*
+* BY:		Eric Hollas																	*
+*																						*
+* FILE:		EntityStore.h																*
+* DETAILS:	This file defines the store of the data every character has, kept as a		*
+*				structure of arrays. The locations, velocities, radii and uniform		*
+*				matrices of all the characters are each one contiguous array, so the	*
+*				loops that update them, the physics and the uniform matrices, run over	*
+*				contiguous memory instead of calling each character.					*
+*			A character is referred to by an EntityHandle. The arrays stay dense and in	*
+*				the order the characters were added when one is removed, the ones		*
+*				after it move down. That order is the order of the meshes in the		*
+*				GeometryManager, so the uniform matrices still match them. The handle	*
+*				goes through a slot that follows the moves so it stays valid.			*
+*				The slot of a handle is also the character's id, and the generation		*
+*				of the slot tells a handle of a removed character from the next one.	*
+*																						*
+*****************************************************************************************/
+
+
+#pragma once
+#include "stdafx.h"
+
+class BaseCharacter;
+
+struct EntityHandle {
+	uint32_t slot;
+	uint32_t generation;
+};
+
+class EntityStore {
+public:
+	EntityStore();
+	~EntityStore();
+
+	EntityHandle add(BaseCharacter * owner, glm::vec3 location, float radius);
+	void remove(EntityHandle handle);
+
+	bool isValid(EntityHandle handle) const;
+	uint32_t find(EntityHandle handle) const;
+
+	uint32_t size() const;
+
+	//the components, indexed from 0 to size() - 1, see find for the index of a handle
+	glm::vec3 * getLocations();
+	glm::vec3 * getVelocities();
+	float * getRadii();
+	glm::mat4 * getMatrices();
+	BaseCharacter * getOwner(uint32_t index) const;
+
+private:
+	std::vector<glm::vec3> locations;
+	std::vector<glm::vec3> velocities;
+	std::vector<float> radii;
+	std::vector<glm::mat4> matrices;
+	std::vector<BaseCharacter*> owners;
+	std::vector<uint32_t> owner_slots;
+
+	struct slot {
+		uint32_t index;			//where the entity of the slot is in the arrays
+		uint32_t generation;	//incremented every time the entity of the slot is removed
+	};
+
+	std::vector<slot> slots;
+	std::vector<uint32_t> free_slots;
+};
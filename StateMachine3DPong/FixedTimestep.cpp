@@ -0,0 +1,99 @@
+/****************************************************************************************
+* TITLE:	2D-Pong in 3D																*
+* BY:		Eric Hollas																	*
+*																						*
+* FILE:		FixedTimestep.cpp															*
+*																						*
+* Correponds to FixedTimestep.h (see for overall description)							*
+*																						*
+*****************************************************************************************/
+
+
+#include "stdafx.h"
+#include "FixedTimestep.h"
+
+/*
+* Constructor
+*
+* Parameters: double ticksPerSecond,
+*			  uint32_t maxTicksPerAdvance
+*
+* the clock starts on the first call to advance
+*
+*/
+FixedTimestep::FixedTimestep(double ticksPerSecond, uint32_t maxTicksPerAdvance) {
+	step = std::chrono::duration_cast<duration>(std::chrono::duration<double>(1.0 / ticksPerSecond));
+	max_ticks = std::max(1u, maxTicksPerAdvance);
+	isStarted = false;
+	num_of_ticks = 0;
+	num_of_dropped = 0;
+}
+
+/*
+* Function: advance
+*
+* Paramters: time_point now
+*
+* Return Type: uint32_t
+*
+* Description: adds the time since the last call to the accumulator and returns
+*				the number of ticks the caller has to run to catch up to now, at
+*				most maxTicksPerAdvance. The first call only starts the clock
+*
+*/
+uint32_t FixedTimestep::advance(time_point now) {
+	if (!isStarted) {
+		last_tick = now;
+		isStarted = true;
+		return 0;
+	}
+	if (now < last_tick) {
+		return 0;
+	}
+
+	uint64_t due = (now - last_tick) / step;
+	if (due > max_ticks) {
+		//the time that can not be caught up is dropped instead of carried into the next frames
+		num_of_dropped += due - max_ticks;
+		last_tick = now - step * max_ticks;
+		due = max_ticks;
+	}
+	last_tick += step * due;
+	num_of_ticks += due;
+
+	return static_cast<uint32_t>(due);
+}
+/*
+* Function: getAlpha
+*
+* Paramters: time_point now
+*
+* Return Type: float
+*
+* Description: returns how far now is between the last tick and the next, from 0 to 1
+*
+*/
+float FixedTimestep::getAlpha(time_point now) const {
+	if (!isStarted || now <= last_tick) {
+		return 0.0f;
+	}
+	double alpha = std::chrono::duration<double>(now - last_tick).count() / std::chrono::duration<double>(step).count();
+	return static_cast<float>(std::min(alpha, 1.0));
+}
+
+//getter method, the length of one tick
+FixedTimestep::duration FixedTimestep::getStep() const {
+	return step;
+}
+//getter method, the time the next tick is due
+FixedTimestep::time_point FixedTimestep::getNextTick() const {
+	return last_tick + step;
+}
+//getter method, the ticks run since the clock started
+uint64_t FixedTimestep::getNumOfTicks() const {
+	return num_of_ticks;
+}
+//getter method, the ticks dropped because the game fell behind
+uint64_t FixedTimestep::getNumOfDropped() const {
+	return num_of_dropped;
+}
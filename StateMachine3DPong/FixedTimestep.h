@@ -0,0 +1,47 @@
+/****************************************************************************************
+* TITLE:	2D-Pong in 3D																*
+* BY:		Eric Hollas																	*
+*																						*
+* FILE:		FixedTimestep.h																*
+* DETAILS:	This file defines the clock of the simulation. The characters move a fixed	*
+*				distance each tick, so the ticks run at a fixed rate however fast the	*
+*				frames are drawn. The time since the last tick is the accumulator, each	*
+*				call to advance returns how many whole ticks fit in it and keeps the	*
+*				remainder for the next call. The fraction of a tick that is left is the	*
+*				alpha the renderer blends the last two ticks with. If the game falls	*
+*				too far behind the ticks past the catch up limit are dropped, so a		*
+*				slow frame does not make the next frame slower.							*
+*																						*
+*****************************************************************************************/
+
+
+#pragma once
+#include "stdafx.h"
+#include <chrono>
+
+class FixedTimestep {
+public:
+	typedef std::chrono::steady_clock::time_point time_point;
+	typedef std::chrono::steady_clock::duration duration;
+
+	FixedTimestep(double ticksPerSecond, uint32_t maxTicksPerAdvance);
+
+	uint32_t advance(time_point now);
+	float getAlpha(time_point now) const;
+
+	duration getStep() const;
+	time_point getNextTick() const;
+	uint64_t getNumOfTicks() const;
+	uint64_t getNumOfDropped() const;
+
+private:
+	duration step;
+	uint32_t max_ticks;
+
+	//the time the last tick ran up to, now - last_tick is the accumulator
+	time_point last_tick;
+	bool isStarted;
+
+	uint64_t num_of_ticks;
+	uint64_t num_of_dropped;
+};
@@ -3,15 +3,37 @@
 * BY:		Eric Hollas																	*
 *																						*
 * FILE:		main.cpp																	*
-* DETAILS:	This file creates and calls the object to run the game						*
+* DETAILS:	This file creates and calls the object to run the game, or with the			*
+*				--benchmark argument runs the benchmarks in Benchmark.h instead.		*
+*				With the --server argument it runs many matches without a window on		*
+*				the MatchServer instead, and with --check it checks that a centered		*
+*				paddle returns the ball (see MatchServer::checkReturn).					*
 *																						*
 *****************************************************************************************/
 
 #include "stdafx.h"
 #include "Window.h"
+#include "Benchmark.h"
+#include "MatchServer.h"
 
-int main() {
+int main(int argc, char *argv[]) {
 	try {
+		//the optional second argument is the number of characters of the benchmarks
+		if (argc > 1 && std::string(argv[1]) == "--benchmark") {
+			Benchmark bench;
+			bench.run((argc > 2) ? std::max(1, std::atoi(argv[2])) : 1000000, std::cout);
+			return EXIT_SUCCESS;
+		}
+		//the optional arguments are the number of matches and of ticks
+		if (argc > 1 && std::string(argv[1]) == "--server") {
+			MatchServer server((argc > 2) ? std::max(1, std::atoi(argv[2])) : 1000);
+			server.run((argc > 3) ? std::max(1, std::atoi(argv[3])) : 30000, std::cout);
+			return EXIT_SUCCESS;
+		}
+		//the optional argument is the number of ticks, the ball takes about 4000 to reach a paddle
+		if (argc > 1 && std::string(argv[1]) == "--check") {
+			return MatchServer::checkReturn((argc > 2) ? std::max(1, std::atoi(argv[2])) : 30000, std::cout) ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
 		Window app;
 		app.runGame();
 	}
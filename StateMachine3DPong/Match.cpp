@@ -0,0 +1,156 @@
+/****************************************************************************************
+* TITLE:	2D-Pong in 3D																*
+* BY:		Eric Hollas																	*
+*																						*
+* FILE:		Match.cpp																	*
+*																						*
+* Correponds to Match.h (see for overall description)									*
+*																						*
+*****************************************************************************************/
+
+
+#include "stdafx.h"
+#include "Match.h"
+#include "Character_Paddle.h"
+#include "Character_Ball.h"
+#include "Character_Score.h"
+
+/*
+* Constructor
+*
+* Parameters: uint32_t numOfWorkers
+*
+* creates the characters, numOfWorkers is the number of threads the characters of
+*	this match are run on besides the thread that calls step (see WorkerPool.h)
+*
+*/
+Match::Match(uint32_t numOfWorkers)
+	: physics(dispatch), characters(dispatch, physics, numOfWorkers) {
+	num_of_ticks = 0;
+	initCharacters();
+}
+/*
+* Deconstructor
+*
+* deletes the characters while the entities they are in still exist
+*
+*/
+Match::~Match() {
+	characters.DeleteCharacter(p_awayScore);
+	characters.DeleteCharacter(p_homeScore);
+	characters.DeleteCharacter(p_ball);
+	characters.DeleteCharacter(p_computer);
+	characters.DeleteCharacter(p_user);
+}
+
+/*
+* Function: step
+*
+* Paramters: none
+*
+* Return Type: bool
+*
+* Description: runs one tick of the game, returns true if a score changed and its
+*				vertex and index info needs to be updated (see CharacterManager::updateOffsets)
+*
+*/
+bool Match::step() {
+	num_of_ticks++;
+	return characters.runFSMs();
+}
+/*
+* Function: userInput
+*
+* Paramters: bool up,
+*			 bool down
+*
+* Return Type: void
+*
+* Description: moves the user's paddle up or down, safe to call from any thread
+*
+*/
+void Match::userInput(bool up, bool down) {
+	characters.userInput(up, down, getUserID());
+}
+
+//getter method
+Messanger & Match::getDispatch() {
+	return dispatch;
+}
+//getter method
+PhysicsCalculator & Match::getPhysics() {
+	return physics;
+}
+//getter method
+AIengine & Match::getAI() {
+	return ai;
+}
+//getter method
+CharacterManager & Match::getCharacters() {
+	return characters;
+}
+//getter method
+int Match::getUserID() const {
+	return p_user->getID();
+}
+//getter method, not to be called while the match is stepping
+glm::vec3 Match::getUserLocation() const {
+	return p_user->getLocation();
+}
+//getter method, not to be called while the match is stepping
+glm::vec3 Match::getBallLocation() const {
+	return p_ball->getLocation();
+}
+//getter method, every point the user scored in the match
+uint32_t Match::getUserPoints() const {
+	return p_homeScore->getNumOfPoints();
+}
+//getter method, every point the computer scored in the match
+uint32_t Match::getComputerPoints() const {
+	return p_awayScore->getNumOfPoints();
+}
+//getter method
+uint64_t Match::getNumOfTicks() const {
+	return num_of_ticks;
+}
+
+
+/*
+* Function: initCharacters
+*
+* Paramters: none
+*
+* Return Type: void
+*
+* Description: initializes the characters with their initial data for the game.
+*				The characters that send each other messages are given each other's
+*				handles here, they do not depend on the order they are instanstiated.
+*				The scores have to be added last, see CharacterManager::updateOffsets
+*
+*/
+void Match::initCharacters() {
+	p_user = new Character_Paddle(*this, 0.125f, glm::vec3{ -0.9f, 0.0f, 0.0f });
+	p_computer = new Character_Paddle(*this, 0.125f, glm::vec3{ 1.0f, 0.0f, 0.0f });
+	p_ball = new Character_Ball(*this, 0.035f, glm::vec3{ 0.0f, 0.035f, 0.0f });
+	p_homeScore = new Character_Score(*this, glm::vec3{ 0.0f, 0.0f, 0.0f });
+	p_awayScore = new Character_Score(*this, glm::vec3{ 1.5f, 0.0f, 0.0f });
+
+	p_ball->setPeers(p_user->getHandle(), p_computer->getHandle(), p_homeScore->getHandle(), p_awayScore->getHandle());
+	p_homeScore->setOpponent(p_awayScore->getHandle());
+	p_awayScore->setOpponent(p_homeScore->getHandle());
+
+	//the paddles are boxes as deep as the lanes behind their faces, see the ball states
+	physics.addPaddle(p_user->getHandle(), -1.0f, -0.9f, 1.0f);
+	physics.addPaddle(p_computer->getHandle(), 0.9f, 1.0f, -1.0f);
+
+	p_user->initMesh(Constants::blue);
+	p_computer->initMesh(Constants::red);
+	p_homeScore->initMesh();
+	p_awayScore->initMesh();
+
+	characters.AddCharacter(p_user);
+	characters.AddCharacter(p_computer);
+	characters.AddCharacter(p_ball);
+	characters.AddCharacter(p_homeScore);
+	characters.AddCharacter(p_awayScore);
+}
@@ -0,0 +1,65 @@
+/****************************************************************************************
+* TITLE:	2D-Pong in 3D																*
+* BY:		Eric Hollas																	*
+*																						*
+* FILE:		Match.h																		*
+* DETAILS:	This file defines a match, one game of pong with everything it needs: the	*
+*				messanger, the physics calculator, the ai engine and the characters.	*
+*				Nothing is shared between matches, so any number of them can be run		*
+*				side by side, in the window or headless on the MatchServer. The			*
+*				characters are created with the match and reach its services through	*
+*				it (see BaseCharacter).													*
+*			A match only runs the game, drawing it is left to the Window.				*
+*																						*
+*****************************************************************************************/
+
+
+#pragma once
+#include "stdafx.h"
+#include "Messanger.h"
+#include "PhysicsCalculator.h"
+#include "AIengine.h"
+#include "CharacterManager.h"
+
+class Character_Paddle;
+class Character_Ball;
+class Character_Score;
+
+class Match {
+public:
+	Match(uint32_t numOfWorkers);
+	~Match();
+
+	bool step();
+
+	void userInput(bool up, bool down);
+
+	Messanger & getDispatch();
+	PhysicsCalculator & getPhysics();
+	AIengine & getAI();
+	CharacterManager & getCharacters();
+
+	int getUserID() const;
+	glm::vec3 getUserLocation() const;
+	glm::vec3 getBallLocation() const;
+	uint32_t getUserPoints() const;
+	uint32_t getComputerPoints() const;
+	uint64_t getNumOfTicks() const;
+
+private:
+	//the services are declared before the characters so they are made first and destroyed last
+	Messanger dispatch;
+	PhysicsCalculator physics;
+	AIengine ai;
+	CharacterManager characters;
+
+	Character_Paddle * p_user;
+	Character_Paddle * p_computer;
+	Character_Ball * p_ball;
+	Character_Score * p_homeScore;
+	Character_Score * p_awayScore;
+
+	uint64_t num_of_ticks;
+
+	void initCharacters();
+};
@@ -0,0 +1,161 @@
+/****************************************************************************************
+* TITLE:	2D-Pong in 3D																*
+* BY:		Eric Hollas																	*
+*																						*
+* FILE:		MatchServer.cpp																*
+*																						*
+* Correponds to MatchServer.h (see for overall description)								*
+*																						*
+*****************************************************************************************/
+
+
+#include "stdafx.h"
+#include "MatchServer.h"
+#include <iomanip>
+
+/*
+* Constructor
+*
+* Parameters: uint32_t numOfMatches
+*
+* creates the matches, each with no workers of its own since the server already runs
+*	a match per core, and a worker for every hardware thread after the calling one
+*
+*/
+MatchServer::MatchServer(uint32_t numOfMatches)
+	: workers(std::max(1u, std::thread::hardware_concurrency()) - 1) {
+	for (uint32_t i = 0; i < numOfMatches; i++) {
+		matches.emplace_back(0);
+	}
+}
+/*
+* Deconstructor
+*/
+MatchServer::~MatchServer() {
+}
+
+/*
+* Function: run
+*
+* Paramters: uint32_t numOfTicks,
+*			 std::ostream &out
+*
+* Return Type: void
+*
+* Description: steps every match numOfTicks times, the shards in parallel, and writes the
+*				time taken, the matches x ticks per second, the points of the bots and
+*				the computers and the messages dropped by full mailboxes to out
+*
+*/
+void MatchServer::run(uint32_t numOfTicks, std::ostream &out) {
+	uint32_t numOfShards = ((uint32_t)matches.size() + SERVER_SHARD_SIZE - 1) / SERVER_SHARD_SIZE;
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	workers.run(numOfShards, [this, numOfTicks](uint32_t shard) {
+		runShard(shard, numOfTicks);
+	});
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	uint64_t userPoints = 0, computerPoints = 0, numOfDropped = 0;
+	for (std::deque<Match>::iterator it = matches.begin(); it != matches.end(); it++) {
+		userPoints += it->getUserPoints();
+		computerPoints += it->getComputerPoints();
+		numOfDropped += it->getDispatch().getNumOfDropped();
+	}
+
+	double steps = (double)matches.size() * (double)numOfTicks;
+	out << "server  " << matches.size() << " matches, " << numOfTicks << " ticks, "
+		<< workers.getNumOfThreads() << " threads" << std::endl;
+	out << std::fixed << std::setprecision(2);
+	out << "seconds " << seconds << "  match ticks/s " << steps / std::max(seconds, 1e-9) << std::endl;
+	out << "bot points " << userPoints << "  computer points " << computerPoints
+		<< "  dropped messages " << numOfDropped << std::endl;
+}
+/*
+* Function: checkReturn
+*
+* Paramters: uint32_t numOfTicks,
+*			 std::ostream &out
+*
+* Return Type: bool
+*
+* Description: steps a match numOfTicks times without moving the user paddle, which
+*				stays in the center where the ball is served. Counts how many times the
+*				ball turns back from the user's side and writes it to out, returns true
+*				if the ball was returned and the computer scored no point
+*
+*/
+bool MatchServer::checkReturn(uint32_t numOfTicks, std::ostream &out) {
+	Match match(0);
+	uint32_t numOfReturns = 0;
+	bool isTowardsUser = true;
+	float lastX = match.getBallLocation().x;
+	for (uint32_t tick = 0; tick < numOfTicks; tick++) {
+		match.step();
+		float x = match.getBallLocation().x;
+		if (isTowardsUser && x > lastX && x < 0.0f) {
+			numOfReturns++;
+		}
+		isTowardsUser = (x < lastX);
+		lastX = x;
+	}
+
+	bool isPassed = (numOfReturns > 0 && match.getComputerPoints() == 0);
+	out << "check   centered paddle returns " << numOfReturns << "  computer points "
+		<< match.getComputerPoints() << ((isPassed) ? "  passed" : "  FAILED") << std::endl;
+	return isPassed;
+}
+/*
+* Function: runShard
+*
+* Paramters: uint32_t shard,
+*			 uint32_t numOfTicks
+*
+* Return Type: void
+*
+* Description: steps the matches of the shard numOfTicks times, a tick at a time for
+*				all of them so the shard stays in the cache, with the bots moving every
+*				SERVER_BOT_INTERVAL ticks
+*
+*/
+void MatchServer::runShard(uint32_t shard, uint32_t numOfTicks) {
+	size_t first = (size_t)shard * SERVER_SHARD_SIZE;
+	size_t last = std::min(first + SERVER_SHARD_SIZE, matches.size());
+	for (uint32_t tick = 0; tick < numOfTicks; tick++) {
+		bool isBotTick = (tick % SERVER_BOT_INTERVAL == 0);
+		for (size_t i = first; i < last; i++) {
+			if (isBotTick) {
+				moveBot(matches[i]);
+			}
+			matches[i].step();
+		}
+	}
+}
+/*
+* Function: moveBot
+*
+* Paramters: Match &match
+*
+* Return Type: void
+*
+* Description: moves the user paddle towards the ball if it is more than
+*				SERVER_BOT_DEADZONE away, the same as pressing a key
+*
+*/
+void MatchServer::moveBot(Match &match) {
+	float distance = match.getBallLocation().z - match.getUserLocation().z;
+	if (distance > SERVER_BOT_DEADZONE) {
+		match.userInput(false, true);
+	}
+	else if (distance < -SERVER_BOT_DEADZONE) {
+		match.userInput(true, false);
+	}
+}
+
+/*
+* the following function is an accessor function
+*
+*/
+uint32_t MatchServer::getNumOfMatches() const {
+	return (uint32_t)matches.size();
+}
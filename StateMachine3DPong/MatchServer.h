@@ -0,0 +1,49 @@
+/****************************************************************************************
+* TITLE:	2D-Pong in 3D																*
+* BY:		Eric Hollas																	*
+*																						*
+* FILE:		MatchServer.h																*
+* DETAILS:	This file defines the match server, which runs many matches without a		*
+*				window. It is run with the --server argument, see main.cpp, and is		*
+*				used to tune the ai and to load test the game.							*
+*			The matches are split into shards of SERVER_SHARD_SIZE and each shard is a	*
+*				task of the WorkerPool, so the shards run in parallel on every core.	*
+*				A match is only ever stepped by the one task of its shard and each		*
+*				has its own services (see Match.h), so the tasks share nothing. The		*
+*				matches themselves run their characters on the thread of their task.	*
+*			The user paddle of each match is played by a bot that every					*
+*				SERVER_BOT_INTERVAL ticks moves the paddle towards the ball.			*
+*			checkReturn is a check of the game itself, run with the --check argument.	*
+*				The user paddle of a match is left in the center, where the serve		*
+*				comes straight at it, and it has to return the ball.					*
+*																						*
+*****************************************************************************************/
+
+
+#pragma once
+#include "stdafx.h"
+#include "Match.h"
+#include "WorkerPool.h"
+
+#define SERVER_SHARD_SIZE 16
+#define SERVER_BOT_INTERVAL 50
+#define SERVER_BOT_DEADZONE 0.03f
+
+class MatchServer {
+public:
+	MatchServer(uint32_t numOfMatches);
+	~MatchServer();
+
+	void run(uint32_t numOfTicks, std::ostream &out);
+	static bool checkReturn(uint32_t numOfTicks, std::ostream &out);
+
+	uint32_t getNumOfMatches() const;
+
+private:
+	//a deque since a match can neither be copied nor moved once its characters point to it
+	std::deque<Match> matches;
+	WorkerPool workers;
+
+	void runShard(uint32_t shard, uint32_t numOfTicks);
+	static void moveBot(Match &match);
+};
@@ -12,17 +12,36 @@
 #include "stdafx.h"
 #include "Messanger.h"
 
+thread_local std::vector<message> * Messanger::p_outbox = NULL;
 
 /*
-* Function: instance
+* Constructor for the locally defined struct mailbox
 *
+* every slot starts free for the sender at its position
 *
-* Description: Retruns a static instance of the class
+*/
+Messanger::mailbox::mailbox() : tail(0), head(0) {
+	for (uint32_t i = 0; i < MAILBOX_CAPACITY; i++) {
+		sequences[i].store(i, std::memory_order_relaxed);
+	}
+}
+
+/*
+* Function: openMailbox
+*
+* Paramters: int address_id
+*
+* Return Type: void
+*
+* Description: adds the mailboxes up to address_id if they are not open yet. Called when
+*				a character is created, it must not be called while another thread is
+*				collecting messages
 *
 */
-Messanger* Messanger::instance() {
-	static Messanger inst;
-	return &inst;
+void Messanger::openMailbox(int address_id) {
+	while (address_id >= 0 && (uint32_t)address_id >= postOffice.size()) {
+		postOffice.emplace_back();
+	}
 }
 
 /*
@@ -32,8 +51,8 @@ Messanger* Messanger::instance() {
 *
 * Return Type: void
 *
-* Description: Takes the parameters, creates a message, and then adds it to the postOffice member
-*				variable for distribution later.
+* Description: Takes the parameters, creates a message, and then adds it to the mailbox of the
+*				receiver for distribution later. Safe to call from any thread.
 *				Note that message_type is enum variable, possible values are defined in Messanger.h
 *
 */
@@ -43,7 +62,7 @@ void Messanger::collect(message_type typ, int to, int from) {
 	msg.sender_id = from;
 	msg.reciever_id = to;
 
-	postOffice.push_back(msg);
+	post(msg);
 }
 void Messanger::collect(message_type typ, int to, int from, float position, float radius, float distance) {
 	message msg;
@@ -55,38 +74,161 @@ void Messanger::collect(message_type typ, int to, int from, float position, floa
 	msg.post_script.radius = radius;
 	msg.post_script.distance = distance;
 
-	postOffice.push_back(msg);
+	post(msg);
 }
 /*
-* Function: distribute
+* Function: hasMail
 *
-* Paramters: int address_id, 
-*			 std::deque<message> &mailbox
+* Paramters: int address_id
 *
 * Return Type: bool
 *
-* Description: Uses the address_id parameter to find all the messages (there may be more than one)
-*				in the postOffice member variable and adds those messages to the mailbox variable,
-*				which is passed by reference. Returns true if there was a message delerived to the
-*				mailbox variable.
-*				Note that once the message has been passed to the mailbox parameter it is deleted
-*				from the postOffice member variable.
+* Description: returns true if there is a message ready in the mailbox of address_id, only
+*				to be called by the owner of the mailbox
 *
 */
-bool Messanger::distribute(int address_id, std::deque<message> &mailbox) {
-	bool isMail = false;
+bool Messanger::hasMail(int address_id) const {
+	if (address_id < 0 || (uint32_t)address_id >= postOffice.size()) {
+		return false;
+	}
+	const mailbox &box = postOffice[address_id];
+	return box.sequences[box.head & (MAILBOX_CAPACITY - 1)].load(std::memory_order_acquire) == box.head + 1;
+}
+/*
+* Function: getMail
+*
+* Paramters: int address_id
+*
+* Return Type: mailSpan
+*
+* Description: returns every message ready in the mailbox of address_id as one span, in
+*				the order their slots were claimed, only to be called by the owner of the
+*				mailbox. The span ends at the first slot that was claimed by a sender but
+*				is not written yet. The messages stay in the mailbox until they are
+*				released, so messages collected while the span is handled do not
+*				overwrite it, they are waiting the next time the mail is read.
+*
+*/
+mailSpan Messanger::getMail(int address_id) {
+	mailSpan mail = { NULL, 0 };
+	if (address_id < 0 || (uint32_t)address_id >= postOffice.size()) {
+		return mail;
+	}
 
-	uint32_t index = 0;
-	while (index < postOffice.size()) {
-		if (postOffice[index].reciever_id == address_id) {
-			mailbox.push_back(postOffice[index]);
-			postOffice.erase(postOffice.begin() + index);
-			isMail = true;
+	mailbox &box = postOffice[address_id];
+	while (mail.size < MAILBOX_CAPACITY) {
+		uint32_t position = box.head + mail.size;
+		if (box.sequences[position & (MAILBOX_CAPACITY - 1)].load(std::memory_order_acquire) != position + 1) {
+			break;
+		}
+		mail.size++;
+	}
+	mail.letters = &box.slots[box.head & (MAILBOX_CAPACITY - 1)];
+	return mail;
+}
+/*
+* Function: release
+*
+* Paramters: int address_id,
+*			 uint32_t count
+*
+* Return Type: void
+*
+* Description: removes the first count messages from the mailbox of address_id, to be
+*				called with the size of the span from getMail once it has been handled.
+*				The slots are then free for the senders again
+*
+*/
+void Messanger::release(int address_id, uint32_t count) {
+	if (address_id < 0 || (uint32_t)address_id >= postOffice.size()) {
+		return;
+	}
+
+	mailbox &box = postOffice[address_id];
+	for (uint32_t i = 0; i < count; i++) {
+		box.sequences[box.head & (MAILBOX_CAPACITY - 1)].store(box.head + MAILBOX_CAPACITY, std::memory_order_release);
+		box.head++;
+	}
+}
+
+//getter method, the messages dropped because their mailbox was full or not opened
+uint32_t Messanger::getNumOfDropped() const {
+	return num_of_dropped.load(std::memory_order_relaxed);
+}
+/*
+* Function: deferTo
+*
+* Paramters: std::vector<message> * outbox
+*
+* Return Type: void
+*
+* Description: the messages collected on the calling thread are added to the end of the
+*				outbox instead of being posted, until deferTo is called with NULL
+*
+*/
+void Messanger::deferTo(std::vector<message> * outbox) {
+	p_outbox = outbox;
+}
+/*
+* Function: commit
+*
+* Paramters: const std::vector<message> &outbox
+*
+* Return Type: void
+*
+* Description: posts the messages of an outbox in the order they were collected
+*
+*/
+void Messanger::commit(const std::vector<message> &outbox) {
+	for (const message &msg : outbox) {
+		post(msg);
+	}
+}
+
+/*
+* Function: post
+*
+* Paramters: const message &msg
+*
+* Return Type: void
+*
+* Description: adds the message to the end of the mailbox of its receiver. The sender
+*				claims the slot at the tail if the reader has released it, writes both
+*				copies of the message and then marks the slot as written. If another
+*				sender claimed the slot first it tries the next one
+*
+*/
+void Messanger::post(const message &msg) {
+	if (p_outbox != NULL) {
+		p_outbox->push_back(msg);
+		return;
+	}
+	if (msg.reciever_id < 0 || (uint32_t)msg.reciever_id >= postOffice.size()) {
+		num_of_dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+
+	mailbox &box = postOffice[msg.reciever_id];
+	uint32_t position = box.tail.load(std::memory_order_relaxed);
+	while (true) {
+		uint32_t slot = position & (MAILBOX_CAPACITY - 1);
+		int32_t difference = (int32_t)(box.sequences[slot].load(std::memory_order_acquire) - position);
+		if (difference == 0) {
+			//on failure position is set to the current tail
+			if (box.tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+				box.slots[slot] = msg;
+				box.slots[slot + MAILBOX_CAPACITY] = msg;
+				box.sequences[slot].store(position + 1, std::memory_order_release);
+				return;
+			}
+		}
+		else if (difference < 0) {
+			//the slot has not been released by the reader, the mailbox is full
+			num_of_dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
 		}
 		else {
-			index++;
+			position = box.tail.load(std::memory_order_relaxed);
 		}
 	}
-
-	return isMail;
 }
\ No newline at end of file
@@ -3,21 +3,36 @@
 * BY:		Eric Hollas																	*
 *																						*
 * FILE:		Messanger.h																	*
-* DETAILS:	This file defines the Messanger. At the end of the file is the macro that	*
-*				defines DISPATCH, the instance of the messanger used throughout the		*
-*				program. DISPATCH will be in charge of collecting and distributing the	*
-*				messages from machine to machine as well as the user input from the		*
-*				Window class.															*
+* DETAILS:	This file defines the Messanger. Each Match has its own messanger, which is	*
+*				in charge of collecting and distributing the messages from machine to	*
+*				machine of that match as well as the user input from the Window class.	*
+*			Every character has its own mailbox, indexed by the character's id. A		*
+*				mailbox is a ring of MAILBOX_CAPACITY messages, so collecting a message	*
+*				is constant time no matter how many characters or messages there are.	*
+*				A character reads its mail as one span and releases it once it has		*
+*				been handled. A message to a full mailbox is counted and dropped.		*
+*			The mailboxes are lock free queues with many producers and one consumer,	*
+*				any thread may collect a message, the input callbacks, physics or ai	*
+*				workers, while only the character that owns a mailbox reads it. A		*
+*				sender claims the next slot of the mailbox and the message is shown		*
+*				to the reader once it is written, so the messages of one thread to a	*
+*				mailbox are read in the order that thread collected them and the		*
+*				messages of different threads in the order their slots were claimed.	*
+*				The mailboxes are opened before any thread collects messages, a			*
+*				message to a mailbox that was not opened is counted and dropped.		*
+*			While the characters run in parallel each thread defers the messages it		*
+*				collects to the outbox of the character it is running, the outboxes		*
+*				are committed in the order of the characters once they all finished.	*
 *																						*
 *****************************************************************************************/
 
 
 #pragma once
 #include "stdafx.h"
+#include <atomic>
 
 
 enum message_type {
-	collision_check,
 	collision_happened,
 	move_up,
 	move_down,
@@ -39,21 +54,63 @@ struct message {
 	}post_script;
 };
 
+//the messages waiting in a mailbox, in the order they were collected
+struct mailSpan {
+	message *letters;
+	uint32_t size;
+
+	message * begin() const {
+		return letters;
+	}
+	message * end() const {
+		return letters + size;
+	}
+};
+
 
 class Messanger {
 public:
-	static Messanger* instance();
+	static const uint32_t MAILBOX_CAPACITY = 64;		//must be a power of two
 
+	void openMailbox(int address_id);
 
 	void collect(message_type msg, int to, int from);
 	void collect(message_type typ, int to, int from, float position, float radius, float distance);
 
-	bool distribute(int address_id, std::deque<message> &mailbox);
+	bool hasMail(int address_id) const;
+	mailSpan getMail(int address_id);
+	void release(int address_id, uint32_t count);
+
+	uint32_t getNumOfDropped() const;
+
+	static void deferTo(std::vector<message> * outbox);
+	void commit(const std::vector<message> &outbox);
 
 
 private:
-	std::vector<message> postOffice;
+	struct mailbox {
+		//each message is written to its slot and again MAILBOX_CAPACITY slots after it,
+		//	so the waiting messages are one contiguous run even when the ring wraps around
+		message slots[2 * MAILBOX_CAPACITY];
 
-};
+		//the sequence of a slot is its position when it is free for a sender and its
+		//	position + 1 once the message is written, the positions only grow and wrap
+		//	around at 2^32. The tail is shared by the senders, the head is only used by
+		//	the reader, each is on its own cache line
+		std::atomic<uint32_t> sequences[MAILBOX_CAPACITY];
+		alignas(64) std::atomic<uint32_t> tail;
+		alignas(64) uint32_t head;
 
-#define DISPATCH Messanger::instance()
\ No newline at end of file
+		mailbox();
+	};
+
+	//indexed by the id of the receiver, a deque so a mailbox never moves when more are added
+	std::deque<mailbox> postOffice;
+
+	std::atomic<uint32_t> num_of_dropped{ 0 };
+
+	//the outbox the messages collected on this thread go to instead of the mailboxes, NULL to post them
+	static thread_local std::vector<message> * p_outbox;
+
+	void post(const message &msg);
+};
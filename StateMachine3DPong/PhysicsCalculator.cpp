@@ -11,16 +11,110 @@
 
 #include "stdafx.h"
 #include "PhysicsCalculator.h"
+#include "BaseCharacter.h"
+#if PHYSICS_SSE
+#include <emmintrin.h>
+#endif
 
 /*
-* Function: instance
+* The batch kernels. The scalar functions are the physics of one ball, the SSE loops in
+*	stepBalls and testPaddle do the same for four balls at a time and the scalar
+*	functions finish the balls that are left over.
+*	A ball turns radians(720) for each unit it rolls (see ballRoll), so its spin turns
+*	by the quaternion of half that angle about the axis perpendicular to its velocity.
+*	The move of a tick is short, so the sine and cosine of the half angle are taken from
+*	their series, which are exact to float precision for any speed the ball can have.
+*/
+static const float ROLL_HALF_ANGLE = glm::radians(360.0f);
+
+static void stepBall(float &x, float &z, float &velocityX, float &velocityZ, float radius,
+					 float &spinX, float &spinY, float &spinZ, float &spinW) {
+	float squared = ROLL_HALF_ANGLE * ROLL_HALF_ANGLE * (velocityX * velocityX + velocityZ * velocityZ);
+	//sin(half angle) / speed and cos(half angle)
+	float scale = ROLL_HALF_ANGLE * (1.0f + squared * (-1.0f / 6.0f + squared * (1.0f / 120.0f)));
+	float turn = 1.0f + squared * (-0.5f + squared * (1.0f / 24.0f));
+	float turnX = velocityZ * scale;
+	float turnZ = -velocityX * scale;
+
+	//the spin is multiplied by the turn on the right, the same as the matrix of ballRoll
+	float newX = spinW * turnX + spinX * turn + spinY * turnZ;
+	float newY = spinY * turn - spinX * turnZ + spinZ * turnX;
+	float newZ = spinW * turnZ - spinY * turnX + spinZ * turn;
+	float newW = spinW * turn - spinX * turnX - spinZ * turnZ;
+	spinX = newX;
+	spinY = newY;
+	spinZ = newZ;
+	spinW = newW;
+
+	//a ball that passed a wall this tick is mirrored back by the wall, the same as the time of impact
+	//	and reflection of integrate for one contact
+	x += velocityX;
+	z += velocityZ;
+	float limit = FIELD_WALL - radius;
+	if (z > limit && velocityZ > 0.0f) {
+		z = 2.0f * limit - z;
+		velocityZ = -velocityZ;
+	}
+	else if (z < -limit && velocityZ < 0.0f) {
+		z = -2.0f * limit - z;
+		velocityZ = -velocityZ;
+	}
+}
+
+static bool testBall(float x, float z, float velocityX, float velocityZ, float radius,
+					 glm::vec3 paddle, float paddleRadius, float faceNormal, float &distance) {
+	float approach = velocityX * faceNormal;
+	float gap = (x - paddle.x) * faceNormal - radius;
+	if (!(approach < 0.0f) || gap > -approach || gap < -radius) {
+		return false;
+	}
+	float time = std::max(gap, 0.0f) / -approach;
+	distance = z + velocityZ * time - paddle.z;
+	return std::abs(distance) <= paddleRadius + radius;
+}
+
+/*
+* Constructor
+*
+* sets the planes of the walls, the hits on the paddles are not sent anywhere
+*
+*/
+PhysicsCalculator::PhysicsCalculator() {
+	walls[0] = { glm::vec3{ 0.0f, 0.0f, -1.0f }, -FIELD_WALL };
+	walls[1] = { glm::vec3{ 0.0f, 0.0f, 1.0f }, -FIELD_WALL };
+	p_dispatch = NULL;
+}
+/*
+* Constructor
+*
+* Parameters: Messanger &dispatch
+*
+* sets the planes of the walls, the hits on the paddles are sent with the messanger
+*
+*/
+PhysicsCalculator::PhysicsCalculator(Messanger &dispatch) : PhysicsCalculator() {
+	p_dispatch = &dispatch;
+}
+
+/*
+* Function: addPaddle
 *
-* Description: Retruns a static instance of the class
+* Paramters:	EntityHandle handle,
+*				float minX,
+*				float maxX,
+*				float faceNormal
+*
+* Return Type: void
+*
+* Description: Makes the entity of the handle a paddle that integrate sweeps the moving
+*				entities against. The paddle is read from the entities every tick, so it
+*				may move, its radius is half its length on the z axis. A paddle is only
+*				hit by an entity moving against faceNormal.
 *
 */
-PhysicsCalculator* PhysicsCalculator::instance() {
-	static PhysicsCalculator inst;
-	return &inst;
+void PhysicsCalculator::addPaddle(EntityHandle handle, float minX, float maxX, float faceNormal) {
+	paddle temp = { handle, minX, maxX, faceNormal };
+	paddles.push_back(temp);
 }
 
 /*
@@ -98,53 +192,422 @@ void PhysicsCalculator::determineHitResultant(float &degrees, float &speed, floa
 	}
 }
 /*
+* Function: sweepSpherePlane
+*
+* Paramters:	float &time,		passed by reference
+*				glm::vec3 center,
+*				glm::vec3 displacement,
+*				float radius,
+*				glm::vec3 normal,
+*				float offset
+*
+* Return Type: bool
+*
+* Description: Returns true if the sphere touches the plane while its center moves from
+*				center by displacement, time is then the fraction of displacement it
+*				moved before it touched. Only a sphere moving against the normal hits
+*				the plane, a sphere that is already past the plane and moving further
+*				into it hits at time 0.
+*
+*/
+bool PhysicsCalculator::sweepSpherePlane(float &time, glm::vec3 center, glm::vec3 displacement, float radius,
+										 glm::vec3 normal, float offset) {
+	float approach = glm::dot(normal, displacement);
+	if (approach >= 0.0f) {
+		return false;
+	}
+	//the distance from the surface of the sphere to the plane
+	float gap = glm::dot(normal, center) - offset - radius;
+	if (gap <= 0.0f) {
+		time = 0.0f;
+		return true;
+	}
+	time = gap / -approach;
+	return time <= 1.0f;
+}
+/*
+* Function: sweepSphereBox
+*
+* Paramters:	float &time,		passed by reference
+*				glm::vec3 &normal,	passed by reference
+*				glm::vec3 center,
+*				glm::vec3 displacement,
+*				float radius,
+*				glm::vec3 boxMin,
+*				glm::vec3 boxMax
+*
+* Return Type: bool
+*
+* Description: Returns true if the sphere touches the box from boxMin to boxMax while
+*				its center moves from center by displacement. time is then the fraction
+*				of displacement it moved before it touched and normal the direction
+*				from the box to the sphere where they touch. A sphere that already
+*				overlaps the box hits at time 0. The game is flat, so the test is in
+*				the plane of the field and the y axis is ignored.
+*				The sphere touches the box when its center is inside the box grown by
+*				the radius with rounded corners, so the center is traced as a point
+*				against that shape: first against the grown box, then against the
+*				circle of the corner if it entered the grown box outside both sides
+*				of the box.
+*
+*/
+bool PhysicsCalculator::sweepSphereBox(float &time, glm::vec3 &normal, glm::vec3 center, glm::vec3 displacement, float radius,
+									   glm::vec3 boxMin, glm::vec3 boxMax) {
+	const int axes[2] = { 0, 2 };
+	float enter = 0.0f, leave = 1.0f;
+	int enterAxis = -1;
+	float enterSide = 0.0f;
+
+	for (int axis : axes) {
+		float low = boxMin[axis] - radius;
+		float high = boxMax[axis] + radius;
+		if (displacement[axis] == 0.0f) {
+			if (center[axis] < low || center[axis] > high) {
+				return false;
+			}
+			continue;
+		}
+		float nearTime = (low - center[axis]) / displacement[axis];
+		float farTime = (high - center[axis]) / displacement[axis];
+		float side = -1.0f;
+		if (nearTime > farTime) {
+			std::swap(nearTime, farTime);
+			side = 1.0f;
+		}
+		if (nearTime > enter) {
+			enter = nearTime;
+			enterAxis = axis;
+			enterSide = side;
+		}
+		leave = std::min(leave, farTime);
+		if (enter > leave) {
+			return false;
+		}
+	}
+
+	glm::vec3 point = center + displacement * enter;
+	bool isOutsideX = point.x < boxMin.x || point.x > boxMax.x;
+	bool isOutsideZ = point.z < boxMin.z || point.z > boxMax.z;
+	if (!(isOutsideX && isOutsideZ)) {
+		time = enter;
+		normal = glm::vec3{ 0.0f, 0.0f, 0.0f };
+		if (enterAxis == -1) {
+			//the sphere already overlaps the box, it is pushed back the way it came
+			float length = glm::length(glm::vec3{ displacement.x, 0.0f, displacement.z });
+			if (length > 0.0f) {
+				normal = glm::vec3{ -displacement.x / length, 0.0f, -displacement.z / length };
+			}
+		}
+		else {
+			normal[enterAxis] = enterSide;
+		}
+		return true;
+	}
+
+	//the center entered a corner of the grown box, it hits only if it hits the circle of the corner
+	glm::vec3 corner = glm::vec3{ (point.x < boxMin.x) ? boxMin.x : boxMax.x, 0.0f, (point.z < boxMin.z) ? boxMin.z : boxMax.z };
+	glm::vec3 offset = glm::vec3{ center.x - corner.x, 0.0f, center.z - corner.z };
+	glm::vec3 direction = glm::vec3{ displacement.x, 0.0f, displacement.z };
+	float a = glm::dot(direction, direction);
+	float b = glm::dot(offset, direction);
+	float c = glm::dot(offset, offset) - radius * radius;
+	if (c <= 0.0f) {
+		time = 0.0f;
+		normal = offset / std::sqrt(glm::dot(offset, offset));
+		return true;
+	}
+	float discriminant = b * b - a * c;
+	if (b >= 0.0f || discriminant < 0.0f) {
+		return false;
+	}
+	float hitTime = (-b - std::sqrt(discriminant)) / a;
+	if (hitTime > 1.0f) {
+		return false;
+	}
+	time = hitTime;
+	normal = (offset + direction * hitTime) / radius;
+	return true;
+}
+/*
+* Function: integrate
+*
+* Paramters:	EntityStore &entities,
+*				uint32_t first,
+*				uint32_t last
+*
+* Return Type: void
+*
+* Description: Moves the entities from index first up to but not including last along
+*				their velocities and rolls their uniform matrices, entities without a
+*				velocity are left as they are. Ranges that do not overlap may be
+*				integrated on different threads.
+*				A moving entity bounces off the walls and the paddles: it is moved to
+*				the time of impact, its velocity is reflected or, off a paddle, set by
+*				determineHitResultant from where it hit, and the rest of the move is
+*				swept again, up to MAX_CONTACTS_PER_TICK times in one tick. The paddles
+*				are read where they are this tick, so no range may be integrated while
+*				a paddle is still moving. Each paddle hit is sent to the entity as a
+*				collision_happened from the paddle once it was moved.
+*
+*/
+void PhysicsCalculator::integrate(EntityStore &entities, uint32_t first, uint32_t last) {
+	glm::vec3 * locations = entities.getLocations();
+	glm::vec3 * velocities = entities.getVelocities();
+	float * radii = entities.getRadii();
+	glm::mat4 * matrices = entities.getMatrices();
+
+	for (uint32_t i = first; i < last; i++) {
+		if (velocities[i].x == 0.0f && velocities[i].z == 0.0f) {
+			continue;
+		}
+		glm::vec3 velocity = velocities[i];
+		float remaining = 1.0f;
+		for (uint32_t contact = 0; contact <= MAX_CONTACTS_PER_TICK && remaining > 0.0f; contact++) {
+			glm::vec3 displacement = velocity * remaining;
+			float time = 1.0f;
+			const plane * p_Wall = NULL;
+			for (const plane &wall : walls) {
+				float wallTime;
+				if (sweepSpherePlane(wallTime, locations[i], displacement, radii[i], wall.normal, wall.offset) && wallTime < time) {
+					time = wallTime;
+					p_Wall = &wall;
+				}
+			}
+			const paddle * p_Paddle = NULL;
+			uint32_t paddleIndex = 0;
+			for (const paddle &block : paddles) {
+				uint32_t index = entities.find(block.handle);
+				if (index == i || !(velocity.x * block.faceNormal < 0.0f)) {
+					continue;
+				}
+				float paddleTime;
+				glm::vec3 normal;
+				glm::vec3 boxMin = glm::vec3{ block.minX, 0.0f, locations[index].z - radii[index] };
+				glm::vec3 boxMax = glm::vec3{ block.maxX, 0.0f, locations[index].z + radii[index] };
+				if (sweepSphereBox(paddleTime, normal, locations[i], displacement, radii[i], boxMin, boxMax) && paddleTime < time) {
+					time = paddleTime;
+					p_Wall = NULL;
+					p_Paddle = &block;
+					paddleIndex = index;
+				}
+			}
+			if (time > 0.0f) {
+				locations[i] += displacement * time;
+				matrices[i] = ballRoll(displacement * time, matrices[i]);
+			}
+			if ((p_Wall == NULL && p_Paddle == NULL) || contact == MAX_CONTACTS_PER_TICK) {
+				break;
+			}
+			if (p_Wall != NULL) {
+				velocity = velocity - p_Wall->normal * (2.0f * glm::dot(velocity, p_Wall->normal));
+			}
+			else {
+				//the paddle sends the entity off at an angle that grows the farther from its center it hit
+				float distance, degrees, speed;
+				float paddleRadius = radii[paddleIndex];
+				if (!isCollision(distance, locations[i].z, radii[i], locations[paddleIndex].z, paddleRadius)) {
+					distance = (locations[i].z < locations[paddleIndex].z) ? -10.0f : 10.0f;
+				}
+				determineHitResultant(degrees, speed, distance, paddleRadius);
+				if (p_Paddle->faceNormal < 0.0f) {
+					degrees += 180.0f;
+				}
+				float angle = glm::radians(degrees);
+				velocity = glm::vec3{ speed * std::cos(angle), 0.0f, speed * std::sin(angle) };
+				if (p_dispatch != NULL) {
+					p_dispatch->collect(collision_happened, entities.getOwner(i)->getID(), entities.getOwner(paddleIndex)->getID(),
+						locations[i].z, paddleRadius, distance);
+				}
+			}
+			remaining -= remaining * time;
+		}
+		velocities[i] = velocity;
+	}
+}
+/*
 * Function: ballRoll
 *
-* Paramters:	float degrees, 
-*				float speed, 
-*				glm::vec3 &location,	passed by reference
-*				bool isReflecting,
+* Paramters:	glm::vec3 velocity,
 *				glm::mat4 oldmatrix
 *
 * Return Type: glm::mat4
 *
 * Description: Calculates and returns the uniform matrix for the ball's next position
-*				and orientation.
-*				Location is passed by reference to use to update the location of the ball
-*				which will be used to determine collisions and future ball rolls.
+*				and orientation after it rolls the distance of velocity.
 *
 */
-glm::mat4 PhysicsCalculator::ballRoll(float degrees, 
-									  float speed, 
-									  glm::vec3 &location, 
-									  bool isReflecting, 
-									  glm::mat4 oldmatrix) {
-	//determines the change in location
-	float x_component = speed * cos(glm::radians(degrees));
-	float z_component = speed * sin(glm::radians(degrees));
-	//makes perpendicular so the rotation of the ball is counter-clockwise
-	float axis = 270.0f + degrees;
-
-	glm::mat4 rotationMatrix;
-
-	//changes the axis and z_component if the ball is on a reflecting path
-	if (isReflecting) {
-		z_component = - z_component;
-		axis = 270.0f - degrees;
-	}
-
-	//updates the location
-	location.x += x_component;
-	location.z += z_component;
-
-	//calculates and returns the matrix
-	glm::mat4 translationMatrix = glm::mat4{ 0.0f, 0.0f, 0.0f, 0.0f,
-											 0.0f, 0.0f, 0.0f, 0.0f,
-											 0.0f, 0.0f, 0.0f, 0.0f,
-											 x_component, 0.0f, z_component, 0.0f
-											};
-	translationMatrix = oldmatrix + translationMatrix;
-	axis = glm::radians(axis);
-	rotationMatrix = glm::rotate(glm::mat4(1.0f), speed * glm::radians(720.0f), glm::vec3{ cos(axis), 0.0f, sin(axis) });
+glm::mat4 PhysicsCalculator::ballRoll(glm::vec3 velocity, glm::mat4 oldmatrix) {
+	float speed = sqrt(velocity.x * velocity.x + velocity.z * velocity.z);
+
+	//the translation is added to the last column of the old matrix
+	glm::mat4 translationMatrix = oldmatrix;
+	translationMatrix[3][0] += velocity.x;
+	translationMatrix[3][2] += velocity.z;
+
+	//the axis is perpendicular to the velocity so the rotation of the ball is counter-clockwise
+	glm::vec3 axis = glm::vec3{ velocity.z / speed, 0.0f, -velocity.x / speed };
+	glm::mat4 rotationMatrix = glm::rotate(glm::mat4(1.0f), speed * glm::radians(720.0f), axis);
 	return translationMatrix * rotationMatrix;
+}
+/*
+* Function: stepBalls
+*
+* Paramters:	BallBatch &balls,
+*				uint32_t first,
+*				uint32_t last
+*
+* Return Type: void
+*
+* Description: Moves the balls from index first up to but not including last along their
+*				velocities for one tick, rolls their spins and bounces them off the walls.
+*				A ball bounces off a wall at most once a tick, which is exact unless a ball
+*				crosses the whole field in a tick. Ranges that do not overlap may be
+*				stepped on different threads.
+*
+*/
+void PhysicsCalculator::stepBalls(BallBatch &balls, uint32_t first, uint32_t last) {
+	float * xs = balls.getX();
+	float * zs = balls.getZ();
+	float * velocitiesX = balls.getVelocityX();
+	float * velocitiesZ = balls.getVelocityZ();
+	float * radii = balls.getRadii();
+	float * spinsX = balls.getSpinX();
+	float * spinsY = balls.getSpinY();
+	float * spinsZ = balls.getSpinZ();
+	float * spinsW = balls.getSpinW();
+
+	uint32_t i = first;
+#if PHYSICS_SSE
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 negative = _mm_set1_ps(-0.0f);
+	const __m128 wall = _mm_set1_ps(FIELD_WALL);
+	const __m128 halfAngle = _mm_set1_ps(ROLL_HALF_ANGLE);
+	const __m128 halfAngleSquared = _mm_set1_ps(ROLL_HALF_ANGLE * ROLL_HALF_ANGLE);
+
+	for (; i + 4 <= last; i += 4) {
+		__m128 x = _mm_loadu_ps(xs + i);
+		__m128 z = _mm_loadu_ps(zs + i);
+		__m128 velocityX = _mm_loadu_ps(velocitiesX + i);
+		__m128 velocityZ = _mm_loadu_ps(velocitiesZ + i);
+		__m128 radius = _mm_loadu_ps(radii + i);
+		__m128 spinX = _mm_loadu_ps(spinsX + i);
+		__m128 spinY = _mm_loadu_ps(spinsY + i);
+		__m128 spinZ = _mm_loadu_ps(spinsZ + i);
+		__m128 spinW = _mm_loadu_ps(spinsW + i);
+
+		__m128 squared = _mm_mul_ps(halfAngleSquared, _mm_add_ps(_mm_mul_ps(velocityX, velocityX), _mm_mul_ps(velocityZ, velocityZ)));
+		__m128 scale = _mm_mul_ps(halfAngle, _mm_add_ps(one, _mm_mul_ps(squared,
+			_mm_add_ps(_mm_set1_ps(-1.0f / 6.0f), _mm_mul_ps(squared, _mm_set1_ps(1.0f / 120.0f))))));
+		__m128 turn = _mm_add_ps(one, _mm_mul_ps(squared,
+			_mm_add_ps(_mm_set1_ps(-0.5f), _mm_mul_ps(squared, _mm_set1_ps(1.0f / 24.0f)))));
+		__m128 turnX = _mm_mul_ps(velocityZ, scale);
+		__m128 turnZ = _mm_xor_ps(_mm_mul_ps(velocityX, scale), negative);
+
+		_mm_storeu_ps(spinsX + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(spinW, turnX), _mm_mul_ps(spinX, turn)), _mm_mul_ps(spinY, turnZ)));
+		_mm_storeu_ps(spinsY + i, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(spinY, turn), _mm_mul_ps(spinX, turnZ)), _mm_mul_ps(spinZ, turnX)));
+		_mm_storeu_ps(spinsZ + i, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(spinW, turnZ), _mm_mul_ps(spinY, turnX)), _mm_mul_ps(spinZ, turn)));
+		_mm_storeu_ps(spinsW + i, _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(spinW, turn), _mm_mul_ps(spinX, turnX)), _mm_mul_ps(spinZ, turnZ)));
+
+		x = _mm_add_ps(x, velocityX);
+		z = _mm_add_ps(z, velocityZ);
+
+		//the balls past a wall and moving into it are mirrored back by the wall, the others are kept
+		__m128 high = _mm_sub_ps(wall, radius);
+		__m128 low = _mm_xor_ps(high, negative);
+		__m128 isOverHigh = _mm_and_ps(_mm_cmpgt_ps(z, high), _mm_cmpgt_ps(velocityZ, zero));
+		__m128 isUnderLow = _mm_and_ps(_mm_cmplt_ps(z, low), _mm_cmplt_ps(velocityZ, zero));
+		__m128 isBouncing = _mm_or_ps(isOverHigh, isUnderLow);
+		__m128 limit = _mm_or_ps(_mm_and_ps(isOverHigh, high), _mm_and_ps(isUnderLow, low));
+		__m128 mirrored = _mm_sub_ps(_mm_add_ps(limit, limit), z);
+		z = _mm_or_ps(_mm_and_ps(isBouncing, mirrored), _mm_andnot_ps(isBouncing, z));
+		velocityZ = _mm_xor_ps(velocityZ, _mm_and_ps(isBouncing, negative));
+
+		_mm_storeu_ps(xs + i, x);
+		_mm_storeu_ps(zs + i, z);
+		_mm_storeu_ps(velocitiesZ + i, velocityZ);
+	}
+#endif
+	for (; i < last; i++) {
+		stepBall(xs[i], zs[i], velocitiesX[i], velocitiesZ[i], radii[i], spinsX[i], spinsY[i], spinsZ[i], spinsW[i]);
+	}
+}
+/*
+* Function: testPaddle
+*
+* Paramters:	BallBatch &balls,
+*				uint32_t first,
+*				uint32_t last,
+*				glm::vec3 paddle,
+*				float paddleRadius,
+*				float faceNormal,
+*				uint8_t * hits,
+*				float * distances
+*
+* Return Type: uint32_t
+*
+* Description: Tests the next move of the balls from index first up to but not including
+*				last against the face of the paddle at paddle, which is paddleRadius long
+*				on each side of its center. faceNormal is 1 if the face looks along the x
+*				axis and -1 if it looks against it. hits[i - first] is 1 if the ball
+*				touches the face during its move and 0 if not, and for a hit
+*				distances[i - first] is where along the paddle it touches, the same as
+*				the distance of isCollision. Returns the number of hits. To be called
+*				before stepBalls moves the balls
+*
+*/
+uint32_t PhysicsCalculator::testPaddle(BallBatch &balls, uint32_t first, uint32_t last, glm::vec3 paddle, float paddleRadius,
+									   float faceNormal, uint8_t * hits, float * distances) {
+	float * xs = balls.getX();
+	float * zs = balls.getZ();
+	float * velocitiesX = balls.getVelocityX();
+	float * velocitiesZ = balls.getVelocityZ();
+	float * radii = balls.getRadii();
+
+	uint32_t numOfHits = 0;
+	uint32_t i = first;
+#if PHYSICS_SSE
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 absolute = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+	const __m128 normal = _mm_set1_ps(faceNormal);
+	const __m128 paddleX = _mm_set1_ps(paddle.x);
+	const __m128 paddleZ = _mm_set1_ps(paddle.z);
+	const __m128 length = _mm_set1_ps(paddleRadius);
+
+	for (; i + 4 <= last; i += 4) {
+		__m128 radius = _mm_loadu_ps(radii + i);
+		__m128 velocityZ = _mm_loadu_ps(velocitiesZ + i);
+		__m128 approach = _mm_mul_ps(_mm_loadu_ps(velocitiesX + i), normal);
+		__m128 gap = _mm_sub_ps(_mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(xs + i), paddleX), normal), radius);
+		__m128 closing = _mm_sub_ps(zero, approach);
+
+		__m128 isHit = _mm_cmplt_ps(approach, zero);
+		isHit = _mm_and_ps(isHit, _mm_cmple_ps(gap, closing));
+		isHit = _mm_and_ps(isHit, _mm_cmpge_ps(gap, _mm_sub_ps(zero, radius)));
+
+		//the balls that do not approach divide by one so no lane divides by zero
+		__m128 divisor = _mm_or_ps(_mm_and_ps(isHit, closing), _mm_andnot_ps(isHit, one));
+		__m128 time = _mm_div_ps(_mm_max_ps(gap, zero), divisor);
+		__m128 distance = _mm_sub_ps(_mm_add_ps(_mm_loadu_ps(zs + i), _mm_mul_ps(velocityZ, time)), paddleZ);
+		isHit = _mm_and_ps(isHit, _mm_cmple_ps(_mm_and_ps(distance, absolute), _mm_add_ps(length, radius)));
+
+		_mm_storeu_ps(distances + (i - first), distance);
+		int mask = _mm_movemask_ps(isHit);
+		for (uint32_t lane = 0; lane < 4; lane++) {
+			hits[i - first + lane] = (mask >> lane) & 1;
+		}
+		numOfHits += (uint32_t)(((mask >> 0) & 1) + ((mask >> 1) & 1) + ((mask >> 2) & 1) + ((mask >> 3) & 1));
+	}
+#endif
+	for (; i < last; i++) {
+		float distance = 0.0f;
+		bool isHit = testBall(xs[i], zs[i], velocitiesX[i], velocitiesZ[i], radii[i], paddle, paddleRadius, faceNormal, distance);
+		hits[i - first] = isHit ? 1 : 0;
+		distances[i - first] = distance;
+		if (isHit) {
+			numOfHits++;
+		}
+	}
+	return numOfHits;
 }
\ No newline at end of file
@@ -3,25 +3,85 @@
 * BY:		Eric Hollas																	*
 *																						*
 * FILE:		PhysicsCalculator.h															*
-* DETAILS:	This file defines the instance class that contains the functions that are	*
-*				used to calculate the game physics, namely the ball collision,			*
-*				trajectory, and the ball's uniform matrix.								*
+* DETAILS:	This file defines the class that contains the functions that are used to	*
+*				calculate the game physics, namely the ball collision, trajectory, and	*
+*				the ball's uniform matrix. Each Match has its own.						*
+*			The characters that move on their own have a velocity in the EntityStore,	*
+*				integrate moves a range of them in one loop over its arrays.			*
+*			The collisions are swept, a moving sphere is tested along the whole move	*
+*				of a tick and the time of impact is the fraction of the move before it	*
+*				touches, so a fast sphere can not pass through a wall between ticks.	*
+*			The paddles are swept the same way. A moving entity that touches the box	*
+*				of a paddle is moved to the time of impact, sent off by					*
+*				determineHitResultant and moved the rest of the tick, and only then		*
+*				is it told of the hit with a collision_happened message.				*
+*			stepBalls and testPaddle are the same physics for a BallBatch, they run		*
+*				four balls at a time with SSE where the compiler targets x86 or x64.	*
 *																						*
 *****************************************************************************************/
 
 
 #pragma once
 #include "stdafx.h"
+#include "EntityStore.h"
+#include "BallBatch.h"
+#include "Messanger.h"
+
+//the walls along the sides of the field are at -FIELD_WALL and FIELD_WALL on the z axis
+#define FIELD_WALL 0.8f
+//the most contacts one entity resolves in a tick, the rest of its move is dropped after that
+#define MAX_CONTACTS_PER_TICK 4
+//the batch kernels use SSE where the compiler targets x86 or x64, a scalar loop anywhere else
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define PHYSICS_SSE true
+#else
+#define PHYSICS_SSE false
+#endif
 
 class PhysicsCalculator {
 public:
-	static PhysicsCalculator* instance();
+	PhysicsCalculator();
+	PhysicsCalculator(Messanger &dispatch);
+
+	void addPaddle(EntityHandle handle, float minX, float maxX, float faceNormal);
 
 	bool isCollision(float &distance, float positionBall, float radiusBall, float positionBlock, float radiusBlock);
 
 	void determineHitResultant(float &degrees, float &speed, float distance, float blockRadius);
 
-	glm::mat4 ballRoll(float degrees, float speed, glm::vec3 &location, bool isReflecting, glm::mat4 oldMatrix);
-};
+	bool sweepSpherePlane(float &time, glm::vec3 center, glm::vec3 displacement, float radius,
+		glm::vec3 normal, float offset);
+	bool sweepSphereBox(float &time, glm::vec3 &normal, glm::vec3 center, glm::vec3 displacement, float radius,
+		glm::vec3 boxMin, glm::vec3 boxMax);
+
+	void integrate(EntityStore &entities, uint32_t first, uint32_t last);
+
+	glm::mat4 ballRoll(glm::vec3 velocity, glm::mat4 oldMatrix);
+
+	void stepBalls(BallBatch &balls, uint32_t first, uint32_t last);
+	uint32_t testPaddle(BallBatch &balls, uint32_t first, uint32_t last, glm::vec3 paddle, float paddleRadius,
+		float faceNormal, uint8_t * hits, float * distances);
 
-#define PHYSICS PhysicsCalculator::instance()
\ No newline at end of file
+private:
+	//the points p of a plane are dot(normal, p) = offset, the normal faces into the field
+	struct plane {
+		glm::vec3 normal;
+		float offset;
+	};
+
+	plane walls[2];
+
+	//a paddle is the box from minX to maxX on the x axis and its location plus and minus its
+	//	radius on the z axis, the face of the paddle points along faceNormal on the x axis
+	struct paddle {
+		EntityHandle handle;
+		float minX;
+		float maxX;
+		float faceNormal;
+	};
+
+	std::vector<paddle> paddles;
+
+	//where the hits are sent, NULL if nothing is told of them
+	Messanger * p_dispatch;
+};
@@ -30,28 +30,14 @@ public:
 	*
 	*/
 	void execute(Character_Ball * p_ball) override {
+		//the ball is moved along its velocity by the physics calculator of the match, after
+		//   the characters ran. It bounces off the walls and the paddles there within the tick,
+		//   so a fast ball can not pass the user's paddle between two ticks (see PhysicsCalculator::integrate)
 		glm::vec3 location = p_ball->getLocation();
-		//calls PHYSICS, the physics calculator, to determine the next uniform matrix,
-		//   location will be passed by reference
-		p_ball->setUniformMatrix(PHYSICS->ballRoll(p_ball->getTrajectoryAngle(),
-			p_ball->getTrajectorySpeed(),
-			location,
-			p_ball->isReflecting(),
-			p_ball->getUniformMatrix()));
-		//updates location
-		p_ball->setLocation(location);
-
-		//checks for each case to send a message to a paddle for a collision check or if it needs to reflect
 		float radius = p_ball->getRadius();
-		if (!(location.z < (0.8f - radius) && location.z >(-0.8f + radius))) {
-			p_ball->reflect();
-		}
-		if (location.x <= -0.9f + radius) {
-			DISPATCH->collect(collision_check, 0, p_ball->getID(), location.z, p_ball->getRadius(), 0.0f);
-		}
 		if (location.x <= -1.0f + radius) {
 			p_ball->resetBall();
-			DISPATCH->collect(point_scored, 4, 2);
+			p_ball->getDispatch().collect(point_scored, p_ball->getAwayScoreID(), p_ball->getID());
 		}
 	}
 	/*
@@ -61,19 +47,16 @@ public:
 	*
 	* Return Type: void
 	*
-	* Description: re-init's the uniform matrix to the position it is in and then changes the state of the ball
-	*				to move to the computer
-	*				also calculates the future ball position by calling AI_ENGINE, the instance of the AIengine class,
+	* Description: changes the state of the ball to move to the computer
+	*				also calculates the future ball position by calling the AIengine of the match,
 	*				it then sends a message to the computer paddle to enter the PaddleSmartMoveState
 	*
 	*/
 	void exit(Character_Ball * p_ball) {
-		p_ball->setUniformMatrix(glm::translate(glm::mat4(1.0f), p_ball->getLocation()));
 		p_ball->aimAtComputer();
-		AI_ENGINE->calcTargetPosition(p_ball->getLocation().z, p_ball->getTrajectoryAngle(), p_ball->getTrajectorySpeed());
-		//the id's listed in this message are based off of id's known for each object found in the initCharacters function
-		//	in the Window class
-		DISPATCH->collect(ai_signal, 1, 2);
+		p_ball->getAI().calcTargetPosition(p_ball->getLocation(), p_ball->getRadius(), p_ball->getTrajectoryAngle(), p_ball->getTrajectorySpeed());
+		//the peers of the ball are set in the initCharacters function in the Match class
+		p_ball->getDispatch().collect(ai_signal, p_ball->getComputerPaddleID(), p_ball->getID());
 	}
 	/*
 	* Function: onMessage
@@ -85,17 +68,13 @@ public:
 	*
 	* Description: Processes the event that a message was sent to this character
 	*				for this character there only viable message it should receive
-	*				is that a collision happened
+	*				is that a collision happened with the user's paddle, the physics
+	*				calculator already sent the ball off the paddle
 	*
 	*/
 	void onMessage(Character_Ball * p_ball, message &msg) override {
-		if (msg.letter == collision_happened) {
-			float spd, dgr;
-			//calls PHYSICS, the physics calculator to determine the trajectory to reflect in,
-			//   dgr and spd are degrees and speed and are passed by reference
-			PHYSICS->determineHitResultant(dgr, spd, msg.post_script.distance, msg.post_script.radius);
-
-			p_ball->setTrajectoryInfo(spd, dgr);
+		if (msg.letter == collision_happened && msg.sender_id == p_ball->getUserPaddleID()) {
+			p_ball->followVelocity();
 			exit(p_ball);
 		}
 	}
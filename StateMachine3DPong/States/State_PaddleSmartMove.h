@@ -4,7 +4,7 @@
 *																						*
 * FILE:		PaddleSmartMoveState.h														*
 * DETAILS:	This file defines the state in which the paddle character is moving			*
-*				according to the calculations of the AI_ENGINE, defined in AIengine.h	*
+*				according to the calculations of the AIengine of its match				*
 *																						*
 *****************************************************************************************/
 
@@ -29,7 +29,7 @@ public:
 	*
 	* Return Type: void
 	*
-	* Description: Calls AI_ENGINE, the instance of the AIengine class, to get the target position
+	* Description: Calls the AIengine of the match to get the target position
 	*				then determines if the paddle should stop moving, move up or move down
 	*				Note that the uniform matrix for the paddle is calculated and set here
 	*
@@ -37,7 +37,7 @@ public:
 	*/
 	void execute(Character_Paddle * p_character) override {
 		float zPosition = p_character->getLocation().z;
-		float target = AI_ENGINE->getTargetPosition();
+		float target = p_character->getAI().getTargetPosition();
 
 		if (zPosition - target < Constants::ACCURACY_EPSILON &&
 			zPosition - target > -Constants::ACCURACY_EPSILON) {
@@ -71,30 +71,12 @@ public:
 	* Return Type: void
 	*
 	* Description: Processes the event that a message was sent to this character
-	*				for this character the only viable message is collision_check.
-	*				Collision check determines if there was a collision, if so
-	*				responds to sender that there was a collision, otherwise does nothing
+	*				for this character there are no viable messages, the hits of the
+	*				ball are found by the physics calculator
 	*
 	*/
 	void onMessage(Character_Paddle * p_character, message &msg) override {
-		float dist;
-		bool isCollision;
-		switch (msg.letter) {
-		case collision_check:
-			//calls PHYSICS, the physics calculator to determine if there was a collision
-			//      dist is passed by reference, it will be sent in the response if there 
-			//		was a collision
-			isCollision = PHYSICS->isCollision(dist,
-				msg.post_script.position,
-				msg.post_script.radius,
-				p_character->getLocation().z,
-				p_character->getRadius());
-			if (isCollision) {
-				//calls DISPATCH, the messanger instance, to send the response message
-				DISPATCH->collect(collision_happened, 2, 1, msg.post_script.position, p_character->getRadius(), dist);
-			}
-			break;
-		}
+		//do nothing
 	}
 
 	/*
@@ -33,30 +33,12 @@ public:
 	* Return Type: void
 	*
 	* Description: Processes the event that a message was sent to this character
-	*				for this character the viable messages are collision_check,
-	*				move_up, move_down, and ai_signal
-	*				Collision check determines if there was a collision, if so
-	*				responds to sender that there was a collision, otherwise does nothing
+	*				for this character the viable messages are move_up, move_down,
+	*				and ai_signal
 	*
 	*/
 	void onMessage(Character_Paddle * p_character, message &msg) override {
-		float dist;
-		bool isCollision;
 		switch (msg.letter) {
-		case collision_check:
-			//calls PHYSICS, the physics calculator to determine if there was a collision
-			//      dist is passed by reference, it will be sent in the response if there 
-			//		was a collision
-			isCollision = PHYSICS->isCollision(dist,
-				msg.post_script.position,
-				msg.post_script.radius,
-				p_character->getLocation().z,
-				p_character->getRadius());
-			if (isCollision) {
-				//calls DISPATCH, the messanger instance, to send the response message
-				DISPATCH->collect(collision_happened, 2, p_character->getID(), msg.post_script.position, p_character->getRadius(), dist);
-			}
-			break;
 		case move_up:
 			//changes state
 			p_character->moveUp();
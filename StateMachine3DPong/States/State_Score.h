@@ -35,9 +35,8 @@ public:
 	*				for this character the only viable messages it should receive
 	*				are point_scored (one score has changed) or game_over (both scores need to change)
 	*
-	*				this function calls DISPATCH, which is the messanger instance
-	*				also, the id's used to send the messages are known in the Window
-	*				class function initCharacters
+	*				this function calls the messanger of the match, the other score
+	*				is the opponent set in Match::initCharacters
 	*
 	*/
 
@@ -46,12 +45,7 @@ public:
 			bool needReset = p_character->ScorePoint();
 			if (!needReset) {
 				p_character->ScoreReset();
-				if (p_character->getID() == 3) {
-					DISPATCH->collect(game_over, 4, 3);
-				}
-				else {
-					DISPATCH->collect(game_over, 3, 4);
-				}
+				p_character->getDispatch().collect(game_over, p_character->getOpponentID(), p_character->getID());
 			}
 		}
 		else if (msg.letter == game_over) {
@@ -0,0 +1,132 @@
+/****************************************************************************************
+* TITLE:	2D-Pong in 3D																*
+* BY:		Eric Hollas																	*
+*																						*
+* FILE:		StaticStateMachine.h														*
+* DETAILS:	This file defines the StaticStateMachine class, the state machine the		*
+*				characters use. It manages the same states as the StateMachine class	*
+*				but the states a character can be in are listed in its type, so the		*
+*				machine only stores the index of the current state. A transition to a	*
+*				state that is not in the list does not compile. Running the machine		*
+*				goes through a chain of comparisons on the index that the templates		*
+*				unroll, which the compiler turns into a switch and the execute and		*
+*				onMessage functions of the states are called by name instead of			*
+*				through the virtual table, so they are inlined.							*
+*			The StateMachine class is kept to compare the two, see Benchmark.h.			*
+*																						*
+*****************************************************************************************/
+
+
+#pragma once
+#include "../../StateMachine3DPong/States/BaseState.h"
+#include <type_traits>
+
+/*
+* stateIndex finds the index of target_type in the list of states, the list must
+*	contain target_type
+*/
+template <class target_type, class... state_types>
+struct stateIndex;
+
+template <class target_type, class... rest_types>
+struct stateIndex<target_type, target_type, rest_types...> {
+	static const uint8_t value = 0;
+};
+
+template <class target_type, class first_type, class... rest_types>
+struct stateIndex<target_type, first_type, rest_types...> {
+	static const uint8_t value = 1 + stateIndex<target_type, rest_types...>::value;
+};
+
+/*
+* stateList is true if target_type is in the list of states
+*/
+template <class target_type, class... state_types>
+struct stateList : std::false_type {};
+
+template <class target_type, class first_type, class... rest_types>
+struct stateList<target_type, first_type, rest_types...>
+	: std::integral_constant<bool, std::is_same<target_type, first_type>::value || stateList<target_type, rest_types...>::value> {};
+
+/*
+* stateDispatch calls the functions of the state at an index of the list, the
+*	functions are named with the state's class so the calls are not virtual
+*/
+template <class character_type, class... state_types>
+struct stateDispatch;
+
+template <class character_type, class state_type>
+struct stateDispatch<character_type, state_type> {
+	static void execute(uint8_t index, character_type * p_owner) {
+		state_type::instance()->state_type::execute(p_owner);
+	}
+	static void onMessage(uint8_t index, character_type * p_owner, message &msg) {
+		state_type::instance()->state_type::onMessage(p_owner, msg);
+	}
+};
+
+template <class character_type, class state_type, class... rest_types>
+struct stateDispatch<character_type, state_type, rest_types...> {
+	static void execute(uint8_t index, character_type * p_owner) {
+		if (index == 0) {
+			state_type::instance()->state_type::execute(p_owner);
+		}
+		else {
+			stateDispatch<character_type, rest_types...>::execute(index - 1, p_owner);
+		}
+	}
+	static void onMessage(uint8_t index, character_type * p_owner, message &msg) {
+		if (index == 0) {
+			state_type::instance()->state_type::onMessage(p_owner, msg);
+		}
+		else {
+			stateDispatch<character_type, rest_types...>::onMessage(index - 1, p_owner, msg);
+		}
+	}
+};
+
+//the first state in the list is the state the machine starts in
+template <class character_type, class... state_types>
+class StaticStateMachine {
+public:
+	static_assert(sizeof...(state_types) > 0 && sizeof...(state_types) <= 255, "a StaticStateMachine has 1 to 255 states");
+
+	StaticStateMachine(character_type * character) {
+		p_owner = character;
+		currState = 0;
+		prevState = 0;
+	}
+
+	template <class state_type>
+	void setCurrentState() {
+		static_assert(stateList<state_type, state_types...>::value, "the state is not one of the states of this machine");
+		prevState = currState;
+		currState = stateIndex<state_type, state_types...>::value;
+	}
+	void runSM() const {
+		stateDispatch<character_type, state_types...>::execute(currState, p_owner);
+	}
+
+	void handleMessage(message &msg) {
+		stateDispatch<character_type, state_types...>::onMessage(currState, p_owner, msg);
+	}
+
+	template <class state_type>
+	bool isCurrentState() const {
+		static_assert(stateList<state_type, state_types...>::value, "the state is not one of the states of this machine");
+		return currState == stateIndex<state_type, state_types...>::value;
+	}
+	uint8_t getCurrentState() const {
+		return currState;
+	}
+	uint8_t getPreviousState() const {
+		return prevState;
+	}
+
+
+private:
+	character_type * p_owner;
+
+	uint8_t currState;
+	uint8_t prevState;
+};
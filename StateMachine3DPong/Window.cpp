@@ -10,22 +10,22 @@
 
 #include "stdafx.h"
 #include "Window.h"
-#include "Character_Paddle.h"
-#include "Character_Ball.h"
-#include "Character_Score.h"
 
 //declaration of static member variables 
-Messanger Window::dispatch = Messanger();
 Clock Window::timer = Clock();
-int Window::user_id = -1;
 
 /*
 * Constructor
 *
-* initializes the GLFWwindow variable
+* initializes the GLFWwindow variable, the match has the hardware threads to itself
+*	so its characters run on all of them (see CharacterManager)
 *
 */
-Window::Window() throw(Exception) {
+Window::Window() throw(Exception)
+	: game(std::max(1u, std::thread::hardware_concurrency()) - 1),
+	  simulationClock(SIMULATION_TICKS_PER_SECOND, SIMULATION_MAX_CATCH_UP) {
+	isSimulating = false;
+	areOffsetsChanged = false;
 	try{
 		pEyeOfTheBeholder = new Camera::pointOfView();
 
@@ -38,6 +38,7 @@ Window::Window() throw(Exception) {
 			throw Exception("Failed to create window", "Window.cpp", "Window-Constructor");
 		}
 
+		glfwSetWindowUserPointer(pWindow, this);
 		glfwSetKeyCallback(pWindow, keyCallback);
 	}
 	catch(Exception &excpt){
@@ -48,6 +49,7 @@ Window::Window() throw(Exception) {
 * Deconstructor
 */
 Window::~Window() {
+	stopSimulation();
 	glfwDestroyWindow(pWindow);
 	glfwTerminate();
 }
@@ -59,37 +61,52 @@ Window::~Window() {
 *
 * Return Type: void
 *
-* Description: runs the main game loop
+* Description: runs the main game loop. The characters are updated in ticks of
+*				a fixed length (see FixedTimestep.h), either before each frame or
+*				on the simulation thread, and each frame draws the characters
+*				between the last two ticks so the motion is smooth at any frame rate
 *
 */
 void Window::runGame() {
 	try{
-		initCharacters();
-		renderer.initVulkan(pWindow, *CharacterList.getOffsets());
+		renderer.initVulkan(pWindow, *game.getCharacters().getOffsets());
 		initCamera();
 		Camera::UniformBufferObject ubo;
 		ubo.proj = pEyeOfTheBeholder->getPerspectiveMatrix();
 		ubo.view = pEyeOfTheBeholder->getLookAtMatrix();
 
+		//the first call starts the clock
+		runSimulation(std::chrono::steady_clock::now());
+		if (SIMULATION_THREAD) {
+			isSimulating = true;
+			simulation = std::thread(&Window::simulate, this);
+		}
+
 		while (!glfwWindowShouldClose(pWindow)) {
 			glfwPollEvents();
 
 			timer.startTimer();
 
-			bool updateOffsets = CharacterList.runFSMs();
-
-			if (updateOffsets) {
-				CharacterList.updateOffsets();
-				renderer.updateGeometryBuffers(*CharacterList.getOffsets());
+			FixedTimestep::time_point now = std::chrono::steady_clock::now();
+			if (!SIMULATION_THREAD) {
+				runSimulation(now);
 			}
 
-			renderer.updateUniformBuffer(ubo, CharacterList.getUniformMatrices());
+			{
+				std::lock_guard<std::mutex> guard(simulation_lock);
+				if (areOffsetsChanged) {
+					renderer.updateGeometryBuffers(*game.getCharacters().getOffsets());
+					areOffsetsChanged = false;
+				}
+				renderer.updateUniformBuffer(ubo, game.getCharacters().getInterpolatedMatrices(simulationClock.getAlpha(now)));
+			}
 			renderer.drawFrame();
 
 			timer.calcFrameStats();
 			displayFrameStats();
 		}
 
+		stopSimulation();
 		renderer.cleanup();
 	}
 	catch(Exception &excpt){
@@ -98,6 +115,64 @@ void Window::runGame() {
 }
 
 
+/*
+* Function: runSimulation
+*
+* Paramters: FixedTimestep::time_point now
+*
+* Return Type: FixedTimestep::time_point
+*
+* Description: runs every tick that is due by now and returns when the next tick
+*				is due. The new vertex and index info of the scores is put in the
+*				offsets here, the frame updates the geometry buffers with it
+*
+*/
+FixedTimestep::time_point Window::runSimulation(FixedTimestep::time_point now) {
+	std::lock_guard<std::mutex> guard(simulation_lock);
+	uint32_t numOfTicks = simulationClock.advance(now);
+	for (uint32_t i = 0; i < numOfTicks; i++) {
+		if (game.step()) {
+			game.getCharacters().updateOffsets();
+			areOffsetsChanged = true;
+		}
+	}
+	return simulationClock.getNextTick();
+}
+/*
+* Function: simulate
+*
+* Paramters: none
+*
+* Return Type: void
+*
+* Description: the loop of the simulation thread, it sleeps until the next tick is due.
+*				A sleep may last longer than a tick, the ticks that were missed run
+*				together when it wakes
+*
+*/
+void Window::simulate() {
+	while (isSimulating) {
+		std::this_thread::sleep_until(runSimulation(std::chrono::steady_clock::now()));
+	}
+}
+/*
+* Function: stopSimulation
+*
+* Paramters: none
+*
+* Return Type: void
+*
+* Description: stops the simulation thread and waits for it, if it is running
+*
+*/
+void Window::stopSimulation() {
+	isSimulating = false;
+	if (simulation.joinable()) {
+		simulation.join();
+	}
+}
+
+
 /*
 * Function: keyCallback
 *
@@ -105,17 +180,20 @@ void Window::runGame() {
 *
 * 
 * Description: the standard key callback function for the GLFWwindow
+*				the moves are posted straight to the user paddle's mailbox in the
+*				match of the window, which is safe from any thread
 *
 */
 void Window::keyCallback(GLFWwindow *pW, int key, int scancode, int action, int mods) {
+	Window * p_window = static_cast<Window*>(glfwGetWindowUserPointer(pW));
 	if (key == GLFW_KEY_ESCAPE) {
 		glfwSetWindowShouldClose(pW, GLFW_TRUE);
 	}
 	else if (key == GLFW_KEY_UP) {
-		DISPATCH->collect(move_up, user_id, -1);
+		p_window->game.userInput(true, false);
 	}
 	else if (key == GLFW_KEY_DOWN) {
-		DISPATCH->collect(move_down, user_id, -1);
+		p_window->game.userInput(false, true);
 	}
 }
 
@@ -145,42 +223,6 @@ void Window::initCamera() {
 	pEyeOfTheBeholder->farPerspective = 10.0f;
 }
 /*
-* Function: initCharacters
-*
-* Paramters: none
-*
-* Return Type: void
-*
-* Description: initializes the characters with their initial data for the game
-*				since this is a small game, it is plain to see that the characters
-*				id's obvious in this method from the order they are instanstiated
-*
-*/
-void Window::initCharacters() {
-	Character_Paddle * pUser, *pComputer;
-	Character_Ball * pBall;
-	Character_Score * pHomeScore, * pAwayScore;
-
-	pUser = new Character_Paddle(0.125f, glm::vec3{ -0.9f, 0.0f, 0.0f });		//user_id = 0
-	pComputer = new Character_Paddle(0.125f, glm::vec3{ 1.0f, 0.0f, 0.0f });	//computer_id = 1
-	pBall = new Character_Ball(0.035f, glm::vec3{ 0.0f, 0.035f, 0.0f });		//ball_id = 2
-	pHomeScore = new Character_Score(glm::vec3{ 0.0f, 0.0f, 0.0f });			//homeScore_id = 3
-	pAwayScore = new Character_Score(glm::vec3{ 1.5f, 0.0f, 0.0f });			//awayScore_id = 4
-
-	pUser->initMesh(Constants::blue);
-	pComputer->initMesh(Constants::red);
-	pHomeScore->initMesh();
-	pAwayScore->initMesh();
-
-	user_id = pUser->getID();
-
-	CharacterList.AddCharacter(pUser);
-	CharacterList.AddCharacter(pComputer);
-	CharacterList.AddCharacter(pBall);
-	CharacterList.AddCharacter(pHomeScore);
-	CharacterList.AddCharacter(pAwayScore);
-}
-/*
 * Function: displayFrameStats
 *
 * Paramters: none
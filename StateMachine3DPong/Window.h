@@ -6,9 +6,9 @@
 * DETAILS:	This file defines the Window class to present the rendered images to the	*
 *				display. It also manages the clock object for frame stats and the		*
 *				camera object for the user point of view. Also, the window will act		*
-*				as the user interface for the user taking in input and dispersing it	*
-*				the input to the Messanger. Since so many things are being called		*
-*				and handled in this file. The main loop for the game will run in this	*
+*				as the user interface for the user taking in input and passing it to	*
+*				the Match it draws. Since so many things are being called and			*
+*				handled in this file. The main loop for the game will run in this		*
 *				object and the render engine will be managed in this file. Thus the		*
 *				window object will called and run the main method.						*
 *																						*
@@ -18,8 +18,18 @@
 #include "stdafx.h"
 #include "../../VulkanRenderEngine/RenderEngine/Clock.h"
 #include "../../VulkanRenderEngine/RenderEngine/RenderEngine.h"
-#include "CharacterManager.h"
-#include "Messanger.h"
+#include "Match.h"
+#include "FixedTimestep.h"
+#include <thread>
+#include <mutex>
+#include <atomic>
+
+//the characters move a fixed distance each tick, so the tick rate sets the speed of the game
+#define SIMULATION_TICKS_PER_SECOND 3000.0
+//the most ticks run to catch up at once, a tenth of a second
+#define SIMULATION_MAX_CATCH_UP 300
+//true to run the ticks on their own thread, false to run them before each frame
+#define SIMULATION_THREAD false
 
 class Window {
 public:
@@ -35,13 +45,21 @@ private:
 	Camera::pointOfView * pEyeOfTheBeholder;
 
 	RenderEngine renderer;
-	CharacterManager CharacterList;
+	Match game;
 
-	static int user_id;
 	static Clock timer;
-	static Messanger dispatch;
+
+	FixedTimestep simulationClock;
+	std::thread simulation;
+	std::atomic<bool> isSimulating;
+	//guards the match, the clock and areOffsetsChanged between the simulation and the frames
+	std::mutex simulation_lock;
+	bool areOffsetsChanged;
+
+	FixedTimestep::time_point runSimulation(FixedTimestep::time_point now);
+	void simulate();
+	void stopSimulation();
 
 	void initCamera();
-	void initCharacters();
 	void displayFrameStats();
 };
@@ -0,0 +1,144 @@
+/****************************************************************************************
+* TITLE:	2D-Pong in 3D																*
+* BY:		Eric Hollas																	*
+*																						*
+* FILE:		WorkerPool.cpp																*
+*																						*
+* Correponds to WorkerPool.h (see for overall description)								*
+*																						*
+*****************************************************************************************/
+
+
+#include "stdafx.h"
+#include "WorkerPool.h"
+
+/*
+* Constructor
+*
+* Parameters: uint32_t numOfWorkers
+*
+* starts the worker threads, the thread that calls run also takes tasks
+*	so a pool of 0 workers runs every task on the calling thread
+*
+*/
+WorkerPool::WorkerPool(uint32_t numOfWorkers) {
+	p_task = NULL;
+	num_of_tasks = 0;
+	generation = 0;
+	num_of_busy = 0;
+	isStopping = false;
+	next_task = 0;
+
+	for (uint32_t i = 0; i < numOfWorkers; i++) {
+		workers.push_back(std::thread(&WorkerPool::work, this));
+	}
+}
+/*
+* Deconstructor
+*
+* wakes the workers to stop and waits for them
+*
+*/
+WorkerPool::~WorkerPool() {
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		isStopping = true;
+	}
+	wake.notify_all();
+	for (std::thread &worker : workers) {
+		worker.join();
+	}
+}
+
+/*
+* Function: run
+*
+* Paramters: uint32_t numOfTasks,
+*			 const std::function<void(uint32_t)> &task
+*
+* Return Type: void
+*
+* Description: calls task once for every number from 0 to numOfTasks - 1 across the
+*				workers and the calling thread, and returns once every call returned.
+*				A single task is run on the calling thread without waking the workers.
+*				Only one thread may call run at a time
+*
+*/
+void WorkerPool::run(uint32_t numOfTasks, const std::function<void(uint32_t)> &task) {
+	if (numOfTasks <= 1 || workers.empty()) {
+		for (uint32_t i = 0; i < numOfTasks; i++) {
+			task(i);
+		}
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		p_task = &task;
+		num_of_tasks = numOfTasks;
+		next_task.store(0, std::memory_order_relaxed);
+		num_of_busy = (uint32_t)workers.size();
+		generation++;
+	}
+	wake.notify_all();
+
+	runTasks();
+
+	//every worker takes part in every run, so the task is not used once they all finished
+	std::unique_lock<std::mutex> guard(lock);
+	finished.wait(guard, [this] { return num_of_busy == 0; });
+	p_task = NULL;
+}
+
+//getter method, the workers and the thread that calls run
+uint32_t WorkerPool::getNumOfThreads() const {
+	return (uint32_t)workers.size() + 1;
+}
+
+/*
+* Function: work
+*
+* Paramters: none
+*
+* Return Type: void
+*
+* Description: the loop of a worker thread, sleeps until the next run and takes its tasks
+*
+*/
+void WorkerPool::work() {
+	uint64_t seenGeneration = 0;
+	std::unique_lock<std::mutex> guard(lock);
+	while (true) {
+		wake.wait(guard, [this, seenGeneration] { return isStopping || generation != seenGeneration; });
+		if (isStopping) {
+			return;
+		}
+		seenGeneration = generation;
+
+		guard.unlock();
+		runTasks();
+		guard.lock();
+
+		num_of_busy--;
+		if (num_of_busy == 0) {
+			finished.notify_one();
+		}
+	}
+}
+/*
+* Function: runTasks
+*
+* Paramters: none
+*
+* Return Type: void
+*
+* Description: takes the next task of the run until there are none left
+*
+*/
+void WorkerPool::runTasks() {
+	uint32_t task = next_task.fetch_add(1, std::memory_order_relaxed);
+	while (task < num_of_tasks) {
+		(*p_task)(task);
+		task = next_task.fetch_add(1, std::memory_order_relaxed);
+	}
+}
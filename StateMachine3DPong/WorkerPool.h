@@ -0,0 +1,51 @@
+/****************************************************************************************
+* TITLE:	2D-Pong in 3D																*
+* BY:		Eric Hollas																	*
+*																						*
+* FILE:		WorkerPool.h																*
+* DETAILS:	This file defines the pool of worker threads that the CharacterManager uses	*
+*				to run the characters in parallel. The threads are started once and		*
+*				sleep between runs, so a run every tick does not pay for creating		*
+*				threads. A run splits the work into numbered tasks, the workers and		*
+*				the thread that called run take the tasks one at a time until none		*
+*				are left and run returns once every task is finished.					*
+*																						*
+*****************************************************************************************/
+
+
+#pragma once
+#include "stdafx.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+
+class WorkerPool {
+public:
+	WorkerPool(uint32_t numOfWorkers);
+	~WorkerPool();
+
+	void run(uint32_t numOfTasks, const std::function<void(uint32_t)> &task);
+
+	uint32_t getNumOfThreads() const;
+
+private:
+	std::vector<std::thread> workers;
+
+	std::mutex lock;
+	std::condition_variable wake;
+	std::condition_variable finished;
+
+	//the run the workers are on, set by run while holding the lock
+	const std::function<void(uint32_t)> * p_task;
+	uint32_t num_of_tasks;
+	uint64_t generation;
+	uint32_t num_of_busy;
+	bool isStopping;
+
+	std::atomic<uint32_t> next_task;
+
+	void work();
+	void runTasks();
+};
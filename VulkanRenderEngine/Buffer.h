@@ -72,16 +72,18 @@ namespace vkAPI {
 			* Function: copyTo
 			*
 			* Paramters: void * pData,
-			*			 VkDeviceSize devSize
+			*			 VkDeviceSize devSize,
+			*			 VkDeviceSize offset
 			*
 			* Return Type: void
 			*
-			* Description: coppies the data parameter to the pMapped member variable
+			* Description: coppies the data parameter to the pMapped member variable,
+			*				offset is in bytes from the start of the mapped memory
 			*
 			*/
-			void copyTo(void * pData, VkDeviceSize devSize) {
+			void copyTo(const void * pData, VkDeviceSize devSize, VkDeviceSize offset = 0) {
 				assert(pMapped);
-				memcpy(pMapped, pData, devSize);
+				memcpy((char*)pMapped + offset, pData, devSize);
 			}
 			/*
 			* Function: unmap
@@ -175,6 +177,7 @@ namespace vkAPI {
 					if (initBufferMemory(physclDev, propFlags)) {
 						throw Exception("failed to allocate buffer memory", "Buffer.h", "createBuffer");
 					}
+					return VK_SUCCESS;
 				}
 				catch (Exception &excpt) {
 					throw excpt;
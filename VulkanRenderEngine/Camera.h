@@ -6,6 +6,8 @@
 * DETAILS:	This file describes the camera object and is made to store the constant
 *				uniform buffer data to the shaders. Also, it is made to easily change
 *				the values in the Window class for which it will be apart.
+*			The Frustum is built from the view and projection matrices and is used
+*				to skip the objects and grid cells that can not be on screen.
 */
 #pragma once
 #define GLM_FORCE_RADIANS
@@ -21,6 +23,120 @@ namespace Camera {
 		glm::mat4 proj;
 	};
 
+	/*
+	* Function: ndcToPlane
+	*
+	* Paramters: const glm::mat4 &inverseViewProj,
+	*			 glm::vec2 ndc,					the point in normalized device coordinates
+	*			 float planeZ,					the world z of the plane to hit
+	*			 glm::vec3 &hit
+	*
+	* Return Type: bool
+	*
+	* Description: turns the point into a ray from the near plane to the far plane and sets hit
+	*				to where that ray meets the plane z = planeZ. Returns false if the ray is
+	*				parallel to the plane, hit is then the start of the ray, or if the plane
+	*				is behind the near plane.
+	*
+	*/
+	inline bool ndcToPlane(const glm::mat4 &inverseViewProj, glm::vec2 ndc, float planeZ, glm::vec3 &hit) {
+		glm::vec4 nearPoint = inverseViewProj * glm::vec4(ndc.x, ndc.y, 0.0f, 1.0f);
+		glm::vec4 farPoint = inverseViewProj * glm::vec4(ndc.x, ndc.y, 1.0f, 1.0f);
+		glm::vec3 rayStart = glm::vec3(nearPoint.x, nearPoint.y, nearPoint.z) * (1.0f / nearPoint.w);
+		glm::vec3 rayEnd = glm::vec3(farPoint.x, farPoint.y, farPoint.z) * (1.0f / farPoint.w);
+
+		hit = rayStart;
+		if (rayEnd.z == rayStart.z) {
+			return false;
+		}
+		float t = (planeZ - rayStart.z) / (rayEnd.z - rayStart.z);
+		hit = rayStart + (rayEnd - rayStart) * t;
+		return t >= 0.0f;
+	}
+
+	struct Frustum {
+		//the six planes as (normal, distance), the normals point into the frustum
+		//	and are normalized so a plane gives the distance to a point
+		glm::vec4 planes[6];
+		glm::mat4 inverseViewProj;
+
+		Frustum() {}
+		/*
+		* Constructor
+		*
+		* Parameters: const glm::mat4 &viewProj,	the projection matrix times the view matrix
+		*
+		* extracts the planes from the rows of the matrix, the clip volume of vulkan
+		*	is -w <= x, y <= w and 0 <= z <= w
+		*
+		*/
+		Frustum(const glm::mat4 &viewProj) {
+			glm::vec4 rows[4];
+			for (int i = 0; i < 4; i++) {
+				rows[i] = glm::vec4(viewProj[0][i], viewProj[1][i], viewProj[2][i], viewProj[3][i]);
+			}
+			planes[0] = rows[3] + rows[0];	//left
+			planes[1] = rows[3] - rows[0];	//right
+			planes[2] = rows[3] + rows[1];	//top
+			planes[3] = rows[3] - rows[1];	//bottom
+			planes[4] = rows[2];			//near
+			planes[5] = rows[3] - rows[2];	//far
+			for (glm::vec4 &plane : planes) {
+				plane /= glm::length(glm::vec3(plane));
+			}
+			inverseViewProj = glm::inverse(viewProj);
+		}
+
+		/*
+		* Function: isSphereVisible
+		*
+		* Paramters: glm::vec3 center,
+		*			 float radius
+		*
+		* Return Type: bool
+		*
+		* Description: returns false if the sphere is completely outside one of the planes.
+		*				A sphere near a corner of the frustum can pass without being on
+		*				screen, it is only drawn for nothing.
+		*
+		*/
+		bool isSphereVisible(glm::vec3 center, float radius) const {
+			for (const glm::vec4 &plane : planes) {
+				if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) {
+					return false;
+				}
+			}
+			return true;
+		}
+		/*
+		* Function: getPlaneBounds
+		*
+		* Paramters: float planeZ,
+		*			 glm::vec2 &minCorner,
+		*			 glm::vec2 &maxCorner
+		*
+		* Return Type: bool
+		*
+		* Description: sets the corners to the rectangle of the plane z = planeZ that can be on
+		*				screen, by hitting the plane with the rays of the four corners of the
+		*				screen. Returns false if one of the rays misses the plane, which only
+		*				happens when the camera does not look at the plane.
+		*
+		*/
+		bool getPlaneBounds(float planeZ, glm::vec2 &minCorner, glm::vec2 &maxCorner) const {
+			static const glm::vec2 corners[] = { { -1.0f, -1.0f }, { 1.0f, -1.0f }, { -1.0f, 1.0f }, { 1.0f, 1.0f } };
+			for (int i = 0; i < 4; i++) {
+				glm::vec3 hit;
+				if (!ndcToPlane(inverseViewProj, corners[i], planeZ, hit)) {
+					return false;
+				}
+				minCorner = (i == 0) ? glm::vec2(hit) : glm::min(minCorner, glm::vec2(hit));
+				maxCorner = (i == 0) ? glm::vec2(hit) : glm::max(maxCorner, glm::vec2(hit));
+			}
+			return true;
+		}
+	};
+
 	struct pointOfView {
 		glm::vec3 eye, at, up;
 		float fovy, ratio, nearPerspective, farPerspective;
@@ -33,5 +149,82 @@ namespace Camera {
 		glm::mat4 getPerspectiveMatrix() const {
 			return glm::perspective(fovy, ratio, nearPerspective, farPerspective);
 		}
+
+		/*
+		* Function: screenToPlane
+		*
+		* Paramters: glm::vec2 screen,		the cursor position in window coordinates
+		*			 glm::vec2 windowSize,	the width and height of the window
+		*			 float planeZ			the world z of the plane to hit
+		*
+		* Return Type: glm::vec3
+		*
+		* Description: inverts the view and projection to turn the cursor position into a ray
+		*				from the near plane to the far plane and returns where that ray hits the
+		*				plane z = planeZ. Window coordinates map straight to vulkan's normalized
+		*				device coordinates since both have y pointing down.
+		*
+		*/
+		glm::vec3 screenToPlane(glm::vec2 screen, glm::vec2 windowSize, float planeZ) const {
+			glm::mat4 inverseViewProj = glm::inverse(getPerspectiveMatrix() * getLookAtMatrix());
+			float ndcX = (2.0f * screen.x / windowSize.x) - 1.0f;
+			float ndcY = (2.0f * screen.y / windowSize.y) - 1.0f;
+
+			//a ray parallel to the plane never hits it, the start of the ray is returned
+			glm::vec3 hit;
+			ndcToPlane(inverseViewProj, glm::vec2(ndcX, ndcY), planeZ, hit);
+			return hit;
+		}
+
+		Frustum getFrustum() const {
+			return Frustum(getPerspectiveMatrix() * getLookAtMatrix());
+		}
+		bool isSphereVisible(glm::vec3 center, float radius) const {
+			return getFrustum().isSphereVisible(center, radius);
+		}
+
+		/*
+		* Function: pan
+		*
+		* Paramters: glm::vec2 offset
+		*
+		* Return Type: void
+		*
+		* Description: moves the eye and the point it looks at together, x along the right of
+		*				the camera and y along its up vector. Note the projection is not flipped
+		*				for vulkan, so the up vector points down on the screen.
+		*
+		*/
+		void pan(glm::vec2 offset) {
+			glm::vec3 forward = glm::normalize(at - eye);
+			glm::vec3 right = glm::normalize(glm::cross(forward, up));
+			glm::vec3 cameraUp = glm::cross(right, forward);
+			glm::vec3 move = right * offset.x + cameraUp * offset.y;
+			eye += move;
+			at += move;
+		}
+		/*
+		* Function: zoom
+		*
+		* Paramters: float factor,
+		*			 float minDistance,
+		*			 float maxDistance
+		*
+		* Return Type: void
+		*
+		* Description: scales the distance from the eye to the point it looks at by factor,
+		*				kept between minDistance and maxDistance. The far plane is moved
+		*				out with the eye so the point looked at is never clipped.
+		*
+		*/
+		void zoom(float factor, float minDistance, float maxDistance) {
+			glm::vec3 offset = eye - at;
+			float distance = glm::clamp(glm::length(offset) * factor, minDistance, maxDistance);
+			eye = at + glm::normalize(offset) * distance;
+			farPerspective = glm::max(farPerspective, distance * 2.0f);
+		}
+		float getDistance() const {
+			return glm::length(eye - at);
+		}
 	};
 }
\ No newline at end of file
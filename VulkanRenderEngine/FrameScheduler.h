@@ -0,0 +1,156 @@
+/*
+* TITLE:	Vulkan Render Engine
+* BY:		Eric Hollas
+*
+* FILE:		FrameScheduler.h
+* DETAILS:	This file defines the frame scheduler object. A game that only changes on
+*				input or at known times does not need to draw every loop, so the main
+*				loop sleeps in glfwWaitEventsTimeout until an event arrives, a wake up
+*				that was scheduled is due or a requested frame is allowed by the frame
+*				rate cap. A frame is only drawn when one was requested since the last.
+*/
+#pragma once
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+#include <chrono>
+#include <cstdint>
+
+class FrameScheduler {
+public:
+	typedef std::chrono::steady_clock::time_point time_point;
+
+	FrameScheduler() {
+		frame_interval = std::chrono::steady_clock::duration::zero();
+		last_frame = std::chrono::steady_clock::now() - std::chrono::hours(1);
+		isFrameRequested = true;
+		isWakeScheduled = false;
+		num_of_frames = 0;
+		num_of_wakes = 0;
+	}
+	~FrameScheduler() {}
+
+	/*
+	* Function: setFrameCap
+	*
+	* Paramters: double framesPerSecond,	0 for no cap
+	*
+	* Return Type: void
+	*
+	* Description: sets the least time between two frames
+	*
+	*/
+	void setFrameCap(double framesPerSecond) {
+		frame_interval = std::chrono::steady_clock::duration::zero();
+		if (framesPerSecond > 0.0) {
+			frame_interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / framesPerSecond));
+		}
+	}
+	/*
+	* Function: requestFrame
+	*
+	* Paramters: none
+	*
+	* Return Type: void
+	*
+	* Description: to be called whenever something that is drawn changed, the next
+	*				frame the cap allows will be drawn
+	*
+	*/
+	void requestFrame() {
+		isFrameRequested = true;
+	}
+	/*
+	* Function: scheduleWake
+	*
+	* Paramters: time_point time
+	*
+	* Return Type: void
+	*
+	* Description: makes waitForEvents return by the time even if no event arrives, only
+	*				the earliest wake up is kept and it is dropped once it has passed
+	*
+	*/
+	void scheduleWake(time_point time) {
+		if (!isWakeScheduled || time < wake_time) {
+			wake_time = time;
+			isWakeScheduled = true;
+		}
+	}
+	/*
+	* Function: waitForEvents
+	*
+	* Paramters: none
+	*
+	* Return Type: void
+	*
+	* Description: processes the glfw events, sleeping until the first one arrives or until
+	*				the next requested frame or wake up is due. Without a requested frame or
+	*				a wake up it sleeps until an event arrives
+	*
+	*/
+	void waitForEvents() {
+		time_point now = std::chrono::steady_clock::now();
+		bool hasDeadline = isFrameRequested || isWakeScheduled;
+		time_point deadline = (isFrameRequested) ? last_frame + frame_interval : wake_time;
+		if (isWakeScheduled && wake_time < deadline) {
+			deadline = wake_time;
+		}
+
+		if (!hasDeadline) {
+			glfwWaitEvents();
+		}
+		else if (deadline <= now) {
+			glfwPollEvents();
+		}
+		else {
+			glfwWaitEventsTimeout(std::chrono::duration<double>(deadline - now).count());
+		}
+		num_of_wakes++;
+
+		if (isWakeScheduled && wake_time <= std::chrono::steady_clock::now()) {
+			isWakeScheduled = false;
+		}
+	}
+	/*
+	* Function: beginFrame
+	*
+	* Paramters: none
+	*
+	* Return Type: bool
+	*
+	* Description: returns true if a frame was requested and the cap allows it now, the
+	*				caller then draws the frame. The request is cleared
+	*
+	*/
+	bool beginFrame() {
+		time_point now = std::chrono::steady_clock::now();
+		if (!isFrameRequested || now < last_frame + frame_interval) {
+			return false;
+		}
+		isFrameRequested = false;
+		last_frame = now;
+		num_of_frames++;
+		return true;
+	}
+
+	/*
+	* the following functions are accessor functions, the wakes are the times the loop
+	*	ran, which is more than the frames when the loop woke for nothing to draw
+	*
+	*/
+	uint64_t getNumOfFrames() const {
+		return num_of_frames;
+	}
+	uint64_t getNumOfWakes() const {
+		return num_of_wakes;
+	}
+
+private:
+	std::chrono::steady_clock::duration frame_interval;
+	time_point last_frame;
+	time_point wake_time;
+	bool isFrameRequested;
+	bool isWakeScheduled;
+	uint64_t num_of_frames;
+	uint64_t num_of_wakes;
+};
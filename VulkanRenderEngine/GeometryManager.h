@@ -22,6 +22,7 @@
 
 #include <vector>
 #include <array>
+#include <algorithm>
 
 namespace Geometry {
 	enum color {
@@ -43,7 +44,7 @@ namespace Geometry {
 		gray
 	};
 	inline glm::vec3 getColor(color cl) {
-		const std::vector<glm::vec3> color_pallette = {
+		static const glm::vec3 color_pallette[] = {
 			{ 1.0f, 1.0f, 1.0f }, //white
 			{ 1.0f, 0.0f, 0.0f }, //red
 			{ 0.6f, 0.0f, 0.0f }, //darkRed
@@ -124,10 +125,32 @@ namespace Geometry {
 	public:
 		GeometryManager() {
 		}
+		//the vectors free themselves, destroying them here as well freed them twice
 		~GeometryManager() {
-			geometryInfo.~vector();
 		}
 
+		/*
+		* Function: addMesh
+		*
+		* Paramters: const std::vector<Geometry::Vertex> &vertices
+		*			 const std::vector<uint32_t> &indices
+		*
+		* Return Type: uint32_t
+		*
+		* Description: registers a mesh that any number of objects can share and returns its id.
+		*				The mesh is copied once here, afterwards the id can be passed to addObject
+		*				and updateObject so that changing an object's geometry does not copy
+		*				or allocate any vertex or index data.
+		*
+		*/
+		uint32_t addMesh(const std::vector<Geometry::Vertex> &vertices, const std::vector<uint32_t> &indices) {
+			mesh temp;
+			temp.vertexBuffer = vertices;
+			temp.indexBuffer = indices;
+			setBounds(temp);
+			meshes.push_back(temp);
+			return static_cast<uint32_t>(meshes.size() - 1);
+		}
 		/*
 		* Function: addObject
 		*
@@ -138,24 +161,36 @@ namespace Geometry {
 		*
 		* Description: takes the parameters to calc and add the offsets to the class member variables
 		*				it also accumulates the vertices and indices into class memeber variables
+		*				the object owns its own copy of the mesh
 		*
 		*/
 		void addObject(std::vector<Geometry::Vertex> vertices, std::vector<uint32_t> indices) {
+			uint32_t meshID = addMesh(vertices, indices);
+			addObject(meshID);
+			geometryInfo.back().ownMesh = meshID;
+		}
+		/*
+		* Function: addObject
+		*
+		* Paramters: uint32_t meshID
+		*
+		* Return Type: void
+		*
+		* Description: adds an object that draws the mesh registered with addMesh
+		*
+		*/
+		void addObject(uint32_t meshID) {
 			offset temp;
-
+			temp.mesh = meshID;
+			temp.ownMesh = NO_MESH;
 			if (geometryInfo.empty()) {
 				temp.offset_index = 0;
 				temp.offset_vertex = 0;
-				temp.indexBuffer = indices;
-				temp.vertexBuffer = vertices;
 			}
 			else {
-				temp.offset_index = geometryInfo.back().offset_index + geometryInfo.back().indexBuffer.size();
-				temp.offset_vertex = geometryInfo.back().offset_vertex + geometryInfo.back().vertexBuffer.size();
-				temp.indexBuffer = indices;
-				temp.vertexBuffer = vertices;
+				temp.offset_index = geometryInfo.back().offset_index + getIndiciesInObject(geometryInfo.size() - 1);
+				temp.offset_vertex = geometryInfo.back().offset_vertex + getVerticesInObject(geometryInfo.size() - 1);
 			}
-
 			geometryInfo.push_back(temp);
 		}
 		/*
@@ -169,6 +204,9 @@ namespace Geometry {
 		*
 		*/
 		void deleteLast() {
+			if (geometryInfo.back().ownMesh == meshes.size() - 1) {
+				meshes.pop_back();
+			}
 			geometryInfo.pop_back();
 		}
 		/*
@@ -184,24 +222,97 @@ namespace Geometry {
 		*				parameters that were passed. Then updates the offset data for the objects that
 		*				come after that object in the vector of objects. Order must be maintained to match
 		*				the order of the uniform matrices, which are not tracked here.
+		*				Prefer the overload that takes a mesh id for geometry that changes often.
 		*
 		*/
 		void updateObject(uint32_t object, std::vector<Vertex> vertices, std::vector<uint32_t> indices) {
 			if (object < geometryInfo.size()) {
-				geometryInfo[object].indexBuffer.clear();
-				geometryInfo[object].vertexBuffer.clear();
-				geometryInfo[object].indexBuffer = indices;
-				geometryInfo[object].vertexBuffer = vertices;
-
+				if (geometryInfo[object].ownMesh == NO_MESH) {
+					geometryInfo[object].ownMesh = addMesh(vertices, indices);
+				}
+				else {
+					meshes[geometryInfo[object].ownMesh].vertexBuffer = vertices;
+					meshes[geometryInfo[object].ownMesh].indexBuffer = indices;
+					setBounds(meshes[geometryInfo[object].ownMesh]);
+				}
+				updateObject(object, geometryInfo[object].ownMesh);
+			}
+		}
+		/*
+		* Function: updateObject
+		*
+		* Paramters: uint32_t object,
+		*			 uint32_t meshID
+		*
+		* Return Type: void
+		*
+		* Description: changes the object to draw the mesh registered with addMesh, then updates the
+		*				offsets of the objects that come after it. No vertex or index data is copied.
+		*
+		*/
+		void updateObject(uint32_t object, uint32_t meshID) {
+			if (object < geometryInfo.size() && meshID < meshes.size()) {
+				geometryInfo[object].mesh = meshID;
 				while (++object < geometryInfo.size()) {
-					geometryInfo[object].offset_index = geometryInfo[object - 1].indexBuffer.size() + geometryInfo[object - 1].offset_index;
-					geometryInfo[object].offset_vertex = geometryInfo[object - 1].vertexBuffer.size() + geometryInfo[object - 1].offset_vertex;
+					geometryInfo[object].offset_index = getIndiciesInObject(object - 1) + geometryInfo[object - 1].offset_index;
+					geometryInfo[object].offset_vertex = getVerticesInObject(object - 1) + geometryInfo[object - 1].offset_vertex;
 				}
 			}
 		}
+		/*
+		* Function: updateObjects
+		*
+		* Paramters: const std::vector<uint32_t> &objects,
+		*			 uint32_t meshID
+		*
+		* Return Type: void
+		*
+		* Description: changes every object in the objects parameter to draw the mesh registered
+		*				with addMesh as one batch, the offsets are only recalculated once starting
+		*				from the first object changed.
+		*
+		*/
+		void updateObjects(const std::vector<uint32_t> &objects, uint32_t meshID) {
+			if (meshID >= meshes.size()) {
+				return;
+			}
+			uint32_t first = static_cast<uint32_t>(geometryInfo.size());
+			for (uint32_t object : objects) {
+				if (object < geometryInfo.size()) {
+					geometryInfo[object].mesh = meshID;
+					first = std::min(first, object);
+				}
+			}
+			while (++first < geometryInfo.size()) {
+				geometryInfo[first].offset_index = getIndiciesInObject(first - 1) + geometryInfo[first - 1].offset_index;
+				geometryInfo[first].offset_vertex = getVerticesInObject(first - 1) + geometryInfo[first - 1].offset_vertex;
+			}
+		}
 
 		/*
-		* The following 8 functions are generic accessor methods, but they do compile their necessary
+		* Function: getBoundingSphere
+		*
+		* Paramters: uint32_t object,
+		*			 glm::vec3 &center,
+		*			 float &radius
+		*
+		* Return Type: void
+		*
+		* Description: sets the sphere around the mesh the object draws, in the space of the
+		*				mesh before the object's model matrix is applied
+		*
+		*/
+		void getBoundingSphere(uint32_t object, glm::vec3 &center, float &radius) const {
+			center = glm::vec3(0.0f);
+			radius = 0.0f;
+			if (object < geometryInfo.size()) {
+				center = meshes[geometryInfo[object].mesh].center;
+				radius = meshes[geometryInfo[object].mesh].radius;
+			}
+		}
+
+		/*
+		* The following 9 functions are generic accessor methods, but they do compile their necessary
 		*		before returning the data if need be.
 		*
 		*/
@@ -209,66 +320,88 @@ namespace Geometry {
 			return geometryInfo.size();
 		}
 		uint32_t getVertexOffset(int object) const {
-			if (object > geometryInfo.size()) {
+			if (object >= geometryInfo.size()) {
 				return 0;
 			}
 			return geometryInfo[object].offset_vertex;
 		}
 		uint32_t getIndexOffset(int object) const {
-			if (object > geometryInfo.size()) {
+			if (object >= geometryInfo.size()) {
 				return 0;
 			}
 			return geometryInfo[object].offset_index;
 		}
 		uint32_t getIndiciesInObject(int object) const {
-			if (object > geometryInfo.size()) {
+			if (object >= geometryInfo.size()) {
 				return 0;
 			}
-			return geometryInfo[object].indexBuffer.size();
+			return meshes[geometryInfo[object].mesh].indexBuffer.size();
+		}
+		uint32_t getVerticesInObject(int object) const {
+			if (object >= geometryInfo.size()) {
+				return 0;
+			}
+			return meshes[geometryInfo[object].mesh].vertexBuffer.size();
 		}
-
 		uint32_t getTotalVertices() const {
-			return (geometryInfo.back().offset_vertex + geometryInfo.back().vertexBuffer.size());
+			return (geometryInfo.back().offset_vertex + getVerticesInObject(geometryInfo.size() - 1));
 		}
 		uint32_t getTotalIndices() const {
-			return (geometryInfo.back().offset_index + geometryInfo.back().indexBuffer.size());
+			return (geometryInfo.back().offset_index + getIndiciesInObject(geometryInfo.size() - 1));
 		}
-
 		std::vector<uint32_t> getIndicies() const {
 			std::vector<uint32_t> indices;
-			std::vector<offset>::const_iterator it = geometryInfo.begin();
-
-			while (it != geometryInfo.end()) {
-				offset temp = *it;
-				indices.insert(indices.end(), temp.indexBuffer.begin(), temp.indexBuffer.end());
-				it++;
+			indices.reserve(getTotalIndices());
+			for (const offset &object : geometryInfo) {
+				const std::vector<uint32_t> &indexBuffer = meshes[object.mesh].indexBuffer;
+				indices.insert(indices.end(), indexBuffer.begin(), indexBuffer.end());
 			}
-
 			return indices;
 		}
 		std::vector<Geometry::Vertex> getVertices() const {
 			std::vector<Vertex> vertices;
-			std::vector<offset>::const_iterator it = geometryInfo.begin();
-
-			while (it != geometryInfo.end()) {
-				offset temp = *it;
-				vertices.insert(vertices.end(), temp.vertexBuffer.begin(), temp.vertexBuffer.end());
-				it++;
+			vertices.reserve(getTotalVertices());
+			for (const offset &object : geometryInfo) {
+				const std::vector<Vertex> &vertexBuffer = meshes[object.mesh].vertexBuffer;
+				vertices.insert(vertices.end(), vertexBuffer.begin(), vertexBuffer.end());
 			}
-
 			return vertices;
 		}
-
 	private:
-		struct offset {
+		static const uint32_t NO_MESH = 0xFFFFFFFF;
+
+		struct mesh {
 			std::vector<Vertex> vertexBuffer;
 			std::vector<uint32_t> indexBuffer;
-
+			glm::vec3 center;		//the bounding sphere of the vertices
+			float radius;
+		};
+		//an object draws meshes[mesh], ownMesh is the mesh the object was given its own
+		//	copy of through the vector overloads, or NO_MESH if it only uses shared meshes
+		struct offset {
+			uint32_t mesh;
+			uint32_t ownMesh;
 			uint32_t offset_index;
 			uint32_t offset_vertex;
 		};
-
+		std::vector<mesh> meshes;
 		std::vector<offset> geometryInfo;
 
+		//centers the bounding sphere of the mesh on the middle of its vertices' box
+		static void setBounds(mesh &target) {
+			glm::vec3 minPos(0.0f), maxPos(0.0f);
+			if (!target.vertexBuffer.empty()) {
+				minPos = maxPos = target.vertexBuffer[0].pos;
+			}
+			for (const Vertex &vert : target.vertexBuffer) {
+				minPos = glm::min(minPos, vert.pos);
+				maxPos = glm::max(maxPos, vert.pos);
+			}
+			target.center = (minPos + maxPos) * 0.5f;
+			target.radius = 0.0f;
+			for (const Vertex &vert : target.vertexBuffer) {
+				target.radius = std::max(target.radius, glm::length(vert.pos - target.center));
+			}
+		}
 	};
 }
\ No newline at end of file
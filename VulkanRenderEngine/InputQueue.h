@@ -0,0 +1,101 @@
+/*
+* TITLE:	Vulkan Render Engine
+* BY:		Eric Hollas
+*
+* FILE:		InputQueue.h
+* DETAILS:	This file defines the input queue object, a lock free queue of timestamped
+*				input events with one producer and one consumer. The glfw callbacks push
+*				the events as they arrive and the main loop drains every waiting event in
+*				order as one batch, so no input is lost between two loops. The producer
+*				and the consumer may be on different threads, an input thread can sample
+*				the devices while the main loop is drawing, it then wakes a sleeping loop
+*				with glfwPostEmptyEvent.
+*			The queue is a ring of CAPACITY events. Each side only writes its own index,
+*				the tail is released after the event is written and the head after it
+*				is read, so no lock is needed. A push to a full queue is counted and
+*				dropped, the count shows if the capacity ever needs to grow.
+*/
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <cstdint>
+
+struct InputEvent {
+	enum input_type : uint8_t {
+		input_key,
+		input_mouse_button,
+		input_scroll
+	};
+
+	input_type type;
+	int32_t code;			//the glfw key or mouse button
+	int32_t action;			//GLFW_PRESS, GLFW_RELEASE or GLFW_REPEAT
+	int32_t mods;
+	double x;				//the cursor position of a mouse button, the offsets of a scroll
+	double y;
+	std::chrono::steady_clock::time_point time;		//when the callback received the event
+};
+
+class InputQueue {
+public:
+	static const uint32_t CAPACITY = 1024;		//must be a power of two
+
+	InputQueue() : head(0), tail(0), num_of_dropped(0) {}
+	~InputQueue() {}
+
+	/*
+	* Function: push
+	*
+	* Paramters: const InputEvent &event
+	*
+	* Return Type: bool
+	*
+	* Description: adds the event to the end of the queue, only to be called by the
+	*				producer. Returns false and counts the event as dropped if the
+	*				queue is full
+	*
+	*/
+	bool push(const InputEvent &event) {
+		uint32_t currentTail = tail.load(std::memory_order_relaxed);
+		if (currentTail - head.load(std::memory_order_acquire) == CAPACITY) {
+			num_of_dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		events[currentTail & (CAPACITY - 1)] = event;
+		tail.store(currentTail + 1, std::memory_order_release);
+		return true;
+	}
+	/*
+	* Function: drain
+	*
+	* Paramters: std::vector<InputEvent> &batch
+	*
+	* Return Type: uint32_t
+	*
+	* Description: moves every waiting event to the end of batch in the order they were
+	*				pushed and returns how many were moved, only to be called by the consumer
+	*
+	*/
+	uint32_t drain(std::vector<InputEvent> &batch) {
+		uint32_t currentHead = head.load(std::memory_order_relaxed);
+		uint32_t currentTail = tail.load(std::memory_order_acquire);
+		for (uint32_t i = currentHead; i != currentTail; i++) {
+			batch.push_back(events[i & (CAPACITY - 1)]);
+		}
+		head.store(currentTail, std::memory_order_release);
+		return currentTail - currentHead;
+	}
+
+	uint32_t getNumOfDropped() const {
+		return num_of_dropped.load(std::memory_order_relaxed);
+	}
+
+private:
+	//the indices only grow and wrap around at 2^32, each is on its own cache line so
+	//	the producer and the consumer do not invalidate each other's line
+	alignas(64) std::atomic<uint32_t> head;
+	alignas(64) std::atomic<uint32_t> tail;
+	alignas(64) std::atomic<uint32_t> num_of_dropped;
+	InputEvent events[CAPACITY];
+};
@@ -0,0 +1,296 @@
+/*
+* TITLE:	Vulkan Render Engine
+* BY:		Eric Hollas
+*
+* FILE:		InstancedGrid.h
+* DETAILS:	This file defines the InstancedGrid object. It describes a board of evenly
+*				spaced cells that is rendered with a single instanced draw call.
+*				Each cell is one instance and owns one byte of state, the byte selects
+*				which glyph (a prebuilt mesh) the grid shader draws for that cell.
+*				The glyphs are registered once before the render engine is initialized,
+*				afterwards a change to the board is a single byte write to the state.
+*			Since the cells are evenly spaced, the cells that can be on screen are found
+*				with arithmetic on the visible rectangle instead of testing every cell.
+*/
+
+#pragma once
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include "GeometryManager.h"
+
+//the path of the compiled grid.vert, a game that draws a grid may define its own in stdafx.h
+#ifndef GRID_VERTEX_SHADER_PATH
+#define GRID_VERTEX_SHADER_PATH "Shaders/gridvert.spv"
+#endif
+
+namespace Geometry {
+	// the layout of a glyph vertex in the std430 storage buffer read by grid.vert
+	struct GlyphVertex {
+		glm::vec4 pos;
+		glm::vec4 color;
+	};
+
+	// the push constant block of grid.vert, order and padding must match the shader
+	struct GridLayout {
+		glm::vec4 origin;			//xy: position of cell (0, 0), z: scale of each glyph
+		glm::vec4 step;				//x: distance between columns, y: distance between rows
+		uint32_t columns;
+		uint32_t verticesPerGlyph;
+		uint32_t indicesPerGlyph;
+		uint32_t padding;
+	};
+
+	class InstancedGrid {
+	public:
+		/*
+		* Constructor
+		*
+		* Parameters: uint32_t rows,
+		*			  uint32_t columns,
+		*			  glm::vec2 origin,		the position of the cell at row 0 and column 0
+		*			  glm::vec2 step,		the offset between neighboring columns (x) and rows (y)
+		*			  float scale			the scale applied to every glyph
+		*
+		*/
+		InstancedGrid(uint32_t rows, uint32_t columns, glm::vec2 origin, glm::vec2 step, float scale) {
+			numRows = rows;
+			numColumns = columns;
+			layout.origin = glm::vec4(origin.x, origin.y, scale, 0.0f);
+			layout.step = glm::vec4(step.x, step.y, 0.0f, 0.0f);
+			layout.columns = columns;
+			layout.verticesPerGlyph = 0;
+			layout.indicesPerGlyph = 0;
+			layout.padding = 0;
+			glyphMin = glm::vec2(0.0f);
+			glyphMax = glm::vec2(0.0f);
+
+			//the state buffer is read by the shader as uints, so it is padded to 4 bytes
+			states.resize(((rows * columns) + 3) & ~3u, 0);
+			dirtyBegin = 0;
+			dirtyEnd = static_cast<uint32_t>(states.size());
+		}
+
+		/*
+		* Function: addGlyph
+		*
+		* Paramters: const std::vector<Vertex> &vertices,
+		*			 const std::vector<uint32_t> &indices
+		*
+		* Return Type: uint8_t
+		*
+		* Description: registers a mesh that a cell can show and returns its id, which is
+		*				the value to write into a cell's state. The meshes are padded to the
+		*				size of the largest glyph when the glyph buffers are built, the extra
+		*				indices repeat the first index so they only form degenerate triangles.
+		*				All glyphs must be added before the render engine is initialized.
+		*
+		*/
+		uint8_t addGlyph(const std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices) {
+			glyph temp;
+			temp.vertices = vertices;
+			temp.indices = indices;
+			glyphs.push_back(temp);
+
+			for (const Vertex &vert : vertices) {
+				glyphMin = glm::min(glyphMin, glm::vec2(vert.pos));
+				glyphMax = glm::max(glyphMax, glm::vec2(vert.pos));
+			}
+
+			layout.verticesPerGlyph = std::max(layout.verticesPerGlyph, static_cast<uint32_t>(vertices.size()));
+			layout.indicesPerGlyph = std::max(layout.indicesPerGlyph, static_cast<uint32_t>(indices.size()));
+
+			return static_cast<uint8_t>(glyphs.size() - 1);
+		}
+		/*
+		* Function: setState
+		*
+		* Paramters: uint32_t cell,
+		*			 uint8_t glyphID
+		*
+		* Return Type: void
+		*
+		* Description: sets the glyph a cell shows, the cell is indexed as column + row * columns
+		*
+		*/
+		void setState(uint32_t cell, uint8_t glyphID) {
+			if (cell < numRows * numColumns && states[cell] != glyphID) {
+				states[cell] = glyphID;
+				dirtyBegin = std::min(dirtyBegin, cell);
+				dirtyEnd = std::max(dirtyEnd, cell + 1);
+			}
+		}
+		/*
+		* Function: fill
+		*
+		* Paramters: uint8_t glyphID
+		*
+		* Return Type: void
+		*
+		* Description: sets every cell of the grid to the same glyph
+		*
+		*/
+		void fill(uint8_t glyphID) {
+			std::fill(states.begin(), states.begin() + (numRows * numColumns), glyphID);
+			dirtyBegin = 0;
+			dirtyEnd = numRows * numColumns;
+		}
+		/*
+		* Function: clearDirty
+		*
+		* Paramters: none
+		*
+		* Return Type: void
+		*
+		* Description: to be called by the render engine once the dirty range of the
+		*				state has been copied to the gpu
+		*
+		*/
+		void clearDirty() {
+			dirtyBegin = static_cast<uint32_t>(states.size());
+			dirtyEnd = 0;
+		}
+
+		/*
+		* Function: getVisibleRange
+		*
+		* Paramters: glm::vec2 minCorner,
+		*			 glm::vec2 maxCorner,	the rectangle of the plane z = 0 that is on screen
+		*			 uint32_t &firstRow,
+		*			 uint32_t &lastRow,
+		*			 uint32_t &firstColumn,
+		*			 uint32_t &lastColumn
+		*
+		* Return Type: bool
+		*
+		* Description: sets the rows and columns of the cells whose glyph box overlaps the
+		*				rectangle, the ranges are inclusive. Cell n of a row or column spans
+		*				origin + n * step plus the box of the glyphs, so each range is solved
+		*				for n directly. Returns false if no cell overlaps the rectangle.
+		*
+		*/
+		bool getVisibleRange(glm::vec2 minCorner, glm::vec2 maxCorner, uint32_t &firstRow, uint32_t &lastRow, uint32_t &firstColumn, uint32_t &lastColumn) const {
+			float scale = layout.origin.z;
+			return getVisibleRange(minCorner.x - scale * glyphMax.x, maxCorner.x - scale * glyphMin.x, layout.origin.x, layout.step.x, numColumns, firstColumn, lastColumn)
+				&& getVisibleRange(minCorner.y - scale * glyphMax.y, maxCorner.y - scale * glyphMin.y, layout.origin.y, layout.step.y, numRows, firstRow, lastRow);
+		}
+
+		/*
+		* Function: getGlyphVertices
+		*
+		* Paramters: none
+		*
+		* Return Type: std::vector<GlyphVertex>
+		*
+		* Description: compiles the vertices of every glyph into one vector, glyph n starts
+		*				at n * verticesPerGlyph. Only called when the buffers are created.
+		*
+		*/
+		std::vector<GlyphVertex> getGlyphVertices() const {
+			std::vector<GlyphVertex> compiled(glyphs.size() * layout.verticesPerGlyph);
+			for (size_t i = 0; i < glyphs.size(); i++) {
+				for (size_t j = 0; j < glyphs[i].vertices.size(); j++) {
+					GlyphVertex &vert = compiled[i * layout.verticesPerGlyph + j];
+					vert.pos = glm::vec4(glyphs[i].vertices[j].pos, 1.0f);
+					vert.color = glm::vec4(glyphs[i].vertices[j].color, 1.0f);
+				}
+			}
+			return compiled;
+		}
+		/*
+		* Function: getGlyphIndices
+		*
+		* Paramters: none
+		*
+		* Return Type: std::vector<uint32_t>
+		*
+		* Description: compiles the indices of every glyph into one vector, glyph n starts
+		*				at n * indicesPerGlyph. The indices stay local to their glyph.
+		*
+		*/
+		std::vector<uint32_t> getGlyphIndices() const {
+			std::vector<uint32_t> compiled(glyphs.size() * layout.indicesPerGlyph, 0);
+			for (size_t i = 0; i < glyphs.size(); i++) {
+				std::copy(glyphs[i].indices.begin(), glyphs[i].indices.end(), compiled.begin() + i * layout.indicesPerGlyph);
+			}
+			return compiled;
+		}
+
+		/*
+		* The following functions are generic accessor methods
+		*
+		*/
+		uint32_t getNumOfCells() const {
+			return numRows * numColumns;
+		}
+		uint32_t getNumOfRows() const {
+			return numRows;
+		}
+		uint32_t getNumOfColumns() const {
+			return numColumns;
+		}
+		uint32_t getNumOfGlyphs() const {
+			return static_cast<uint32_t>(glyphs.size());
+		}
+		uint8_t getState(uint32_t cell) const {
+			return states[cell];
+		}
+		const uint8_t * getStates() const {
+			return states.data();
+		}
+		uint32_t getStateSize() const {
+			return static_cast<uint32_t>(states.size());
+		}
+		GridLayout getLayout() const {
+			return layout;
+		}
+		bool isDirty() const {
+			return dirtyBegin < dirtyEnd;
+		}
+		uint32_t getDirtyBegin() const {
+			return dirtyBegin;
+		}
+		uint32_t getDirtyEnd() const {
+			return dirtyEnd;
+		}
+
+	private:
+		struct glyph {
+			std::vector<Vertex> vertices;
+			std::vector<uint32_t> indices;
+		};
+
+		uint32_t numRows;
+		uint32_t numColumns;
+		GridLayout layout;
+		std::vector<glyph> glyphs;
+		std::vector<uint8_t> states;
+		uint32_t dirtyBegin;
+		uint32_t dirtyEnd;
+		glm::vec2 glyphMin;		//the box around every glyph before it is scaled
+		glm::vec2 glyphMax;
+
+		//solves low <= origin + n * step <= high for the cells n in [0, count)
+		static bool getVisibleRange(float low, float high, float origin, float step, uint32_t count, uint32_t &first, uint32_t &last) {
+			if (count == 0 || low > high) {
+				return false;
+			}
+			if (step == 0.0f) {
+				first = 0;
+				last = count - 1;
+				return low <= origin && origin <= high;
+			}
+			float begin = (((step > 0.0f) ? low : high) - origin) / step;
+			float end = (((step > 0.0f) ? high : low) - origin) / step;
+			if (end < 0.0f || begin > static_cast<float>(count - 1)) {
+				return false;
+			}
+			first = static_cast<uint32_t>(std::max(0.0f, std::ceil(begin)));
+			last = static_cast<uint32_t>(std::min(static_cast<float>(count - 1), std::floor(end)));
+			return first <= last;
+		}
+	};
+}
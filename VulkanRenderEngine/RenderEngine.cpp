@@ -17,20 +17,24 @@
 /*
 * Function: initVulkan
 *
-* Paramters: GLFWwindow *pW
+* Paramters: GLFWwindow *pW,
+*			 Geometry::GeometryManager &management,
+*			 Geometry::InstancedGrid *pNewGrid
 *
 * Return Type: void
 *
 * Description: calls the various create functions to initialize the vulkan api
 *				keep in mind, order is important for certain function calls if
 *				it needs to be edited
+*				pNewGrid is optional, when it is passed the grid is drawn with one
+*				instanced draw call after the objects in the GeometryManager
 *
 */
-void RenderEngine::initVulkan(GLFWwindow *pW, Geometry::GeometryManager &management) throw(Exception) {
+void RenderEngine::initVulkan(GLFWwindow *pW, Geometry::GeometryManager &management, Geometry::InstancedGrid *pNewGrid) throw(Exception) {
 	try {
 		pWindow = pW;
-		pOffsetManager;
 		pOffsetManager = &management;
+		pGrid = pNewGrid;
 
 		createInstance();
 		Utilities::Debug::setupDebugCallback(instance, &callback);
@@ -44,12 +48,17 @@ void RenderEngine::initVulkan(GLFWwindow *pW, Geometry::GeometryManager &managem
 		createGraphicsPipeline();
 		createCommandPool();
 		createDepthResources();
+		createPickResources();
 		createFramebuffers();
 		createVertexBuffer();
 		createIndexBuffer();
 		createUniformBuffer();
+		if (pGrid != nullptr) {
+			createGridBuffers();
+		}
 		createDescriptorPool();
 		createDescriptorSet();
+		resetDrawList();
 		createCommandBuffers();
 		createSemaphores();
 	}
@@ -77,7 +86,16 @@ void RenderEngine::cleanup() {
 	vkDestroyDescriptorPool(device, descriptorPool, nullptr);
 
 	vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
+	if (pGrid != nullptr) {
+		vkDestroyDescriptorSetLayout(device, gridDescriptorSetLayout, nullptr);
+		pGridStateBuffer->unmap();
+		pGridStateBuffer->~BufferObject();
+		pGlyphVertexBuffer->~BufferObject();
+		pGlyphIndexBuffer->~BufferObject();
+	}
 
+	pPickBuffer->unmap();
+	pPickBuffer->~BufferObject();
 	pViewUniformBuffer->~BufferObject();
 	pDynamicUniformBuffer->~BufferObject();
 	pIndexBuffer->~BufferObject();
@@ -111,10 +129,18 @@ void RenderEngine::cleanup() {
 * Return Type: void
 *
 * Description: updates the dynamic uniform buffer data and the uniform buffer data, the function
-*				will take in data from the event manager in main loop found in the window object
+*				will take in data from the event manager in main loop found in the window object.
+*				The draw list is culled against the view and projection of the ubo.
+*				If they changed the pick image no longer matches them, pickObject()
+*				returns PICK_NONE until a frame is drawn with the new ones
 *
 */
 void RenderEngine::updateUniformBuffer(Camera::UniformBufferObject ubo, std::vector<glm::mat4> uniformMatrices) {
+	if (ubo.view != pickView.view || ubo.proj != pickView.proj) {
+		isPickImageDrawn = false;
+		pickView = ubo;
+	}
+
 	for (uint32_t i = 0; i < pOffsetManager->getNumOfObjects(); i++) {
 		glm::mat4* modelMat = (glm::mat4*)(((uint64_t)dynamicUBO.pModel + (i * dynamicAlignment)));
 		*modelMat = uniformMatrices[i];
@@ -130,6 +156,10 @@ void RenderEngine::updateUniformBuffer(Camera::UniformBufferObject ubo, std::vec
 	pViewUniformBuffer->map(sz, 0);
 	pViewUniformBuffer->copyTo(&ubo, sz);
 	pViewUniformBuffer->unmap();
+
+	if (FRUSTUM_CULLING) {
+		cullDrawList(ubo, uniformMatrices);
+	}
 }
 /*
 * Function: drawFrame
@@ -140,7 +170,8 @@ void RenderEngine::updateUniformBuffer(Camera::UniformBufferObject ubo, std::vec
 *
 * Description: ensures the swapchain does not need to be recreated and submits the queue to the
 *				command buffer for drawing a frame and then submits the rendered frame to the
-*				swap chain
+*				swap chain. The command buffers are recorded again first if the culled draw
+*				list changed, which waits for the gpu so it only happens as the camera moves
 *
 */
 void RenderEngine::drawFrame() throw(Exception) {
@@ -157,6 +188,12 @@ void RenderEngine::drawFrame() throw(Exception) {
 			throw Exception("failed to acquire swap chain image", "RenderEngine.cpp", "drawFrame");
 		}
 
+		if (isDrawListChanged) {
+			vkQueueWaitIdle(graphicsQueue);
+			vkFreeCommandBuffers(device, commandPool, static_cast<uint32_t>(commandBuffers.size()), commandBuffers.data());
+			createCommandBuffers();
+		}
+
 		//get semaphore info
 		VkSemaphore waitSemaphores[] = { imageAvailableSemaphore };
 		VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
@@ -175,6 +212,7 @@ void RenderEngine::drawFrame() throw(Exception) {
 		if (vkQueueSubmit(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE) != VK_SUCCESS) {
 			throw Exception("failed to submit draw command buffer", "RenderEngine.cpp", "drawFrame");
 		}
+		isPickImageDrawn = true;
 
 		//submits the present queue to the swapchain
 		VkSwapchainKHR swapChains[] = { swapchain };
@@ -226,6 +264,117 @@ void RenderEngine::updateGeometryBuffers(Geometry::GeometryManager &newManagemen
 		throw excpt;
 	}
 }
+/*
+* Function: updateGridStates
+*
+* Paramters: none
+*
+* Return Type: void
+*
+* Description: copies the cell states that changed since the last call from the
+*				InstancedGrid to the state buffer read by the grid shader, the
+*				command buffers do not need to be recreated. Does nothing if no
+*				grid was passed to initVulkan or if no cell has changed
+*
+*/
+void RenderEngine::updateGridStates() {
+	if (pGrid == nullptr || !pGrid->isDirty()) {
+		return;
+	}
+	uint32_t begin = pGrid->getDirtyBegin();
+	uint32_t end = pGrid->getDirtyEnd();
+	pGridStateBuffer->copyTo(pGrid->getStates() + begin, end - begin, begin);
+	pGrid->clearDirty();
+}
+/*
+* Function: pickObject
+*
+* Paramters: uint32_t x,
+*			 uint32_t y
+*
+* Return Type: uint32_t
+*
+* Description: returns the id of what was drawn at the pixel (x, y) of the last frame,
+*				which works for any mesh since the id is written by the shaders to
+*				the pick attachment. An object in the GeometryManager is returned as
+*				its index + 1, a grid cell as its cell index or'd with PICK_GRID_CELL
+*				and PICK_NONE if nothing was drawn there or the camera moved since.
+*				This waits for the gpu to finish the frame, so it is meant to be
+*				called once per click on meshes that are not on a grid, a grid cell
+*				is found faster from the camera (see screenToPlane in Camera.h)
+*
+*/
+uint32_t RenderEngine::pickObject(uint32_t x, uint32_t y) throw(Exception) {
+	try {
+		if (!isPickImageDrawn || x >= swapchainExtent.width || y >= swapchainExtent.height) {
+			return PICK_NONE;
+		}
+		vkQueueWaitIdle(graphicsQueue);
+
+		VkCommandBuffer commandBuffer = beginSingleTimeCommands();
+
+		//makes the writes of the render pass visible to the copy
+		VkImageMemoryBarrier barrier = {};
+		barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.image = pickImage;
+		barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		barrier.subresourceRange.baseMipLevel = 0;
+		barrier.subresourceRange.levelCount = 1;
+		barrier.subresourceRange.baseArrayLayer = 0;
+		barrier.subresourceRange.layerCount = 1;
+		barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+		vkCmdPipelineBarrier(commandBuffer,
+							 VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+							 VK_PIPELINE_STAGE_TRANSFER_BIT,
+							 0,
+							 0,
+							 nullptr,
+							 0,
+							 nullptr,
+							 1,
+							 &barrier);
+
+		//copies the one pixel under the cursor
+		VkBufferImageCopy region = {};
+		region.bufferOffset = 0;
+		region.bufferRowLength = 0;
+		region.bufferImageHeight = 0;
+		region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		region.imageSubresource.mipLevel = 0;
+		region.imageSubresource.baseArrayLayer = 0;
+		region.imageSubresource.layerCount = 1;
+		region.imageOffset = { static_cast<int32_t>(x), static_cast<int32_t>(y), 0 };
+		region.imageExtent = { 1, 1, 1 };
+		vkCmdCopyImageToBuffer(commandBuffer, pickImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, pPickBuffer->buffer, 1, &region);
+
+		endSingleTimeCommands(commandBuffer);
+
+		uint32_t id;
+		memcpy(&id, pPickBuffer->pMapped, sizeof(uint32_t));
+		return id;
+	}
+	catch (Exception &excpt) {
+		throw excpt;
+	}
+}
+/*
+* The following functions are generic accessor methods for what the command buffers draw
+*
+*/
+uint32_t RenderEngine::getNumOfDrawnObjects() const {
+	return static_cast<uint32_t>(drawnObjects.size());
+}
+uint32_t RenderEngine::getNumOfDrawnCells() const {
+	if (!isGridDrawn) {
+		return 0;
+	}
+	return (gridLastRow - gridFirstRow + 1) * (gridLastColumn - gridFirstColumn + 1);
+}
 
 
 
@@ -444,6 +593,10 @@ void RenderEngine::cleanupSwapchain() {
 	vkDestroyImage(device, depthImage, nullptr);
 	vkFreeMemory(device, depthImageMemory, nullptr);
 
+	vkDestroyImageView(device, pickImageView, nullptr);
+	vkDestroyImage(device, pickImage, nullptr);
+	vkFreeMemory(device, pickImageMemory, nullptr);
+
 	for (auto framebuffer : swapchainFramebuffers) {
 		vkDestroyFramebuffer(device, framebuffer, nullptr);
 	}
@@ -452,6 +605,10 @@ void RenderEngine::cleanupSwapchain() {
 
 	vkDestroyPipeline(device, graphicsPipeline, nullptr);
 	vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+	if (pGrid != nullptr) {
+		vkDestroyPipeline(device, gridPipeline, nullptr);
+		vkDestroyPipelineLayout(device, gridPipelineLayout, nullptr);
+	}
 	vkDestroyRenderPass(device, renderPass, nullptr);
 
 	for (auto imageView : swapchainImageViews) {
@@ -490,6 +647,7 @@ void RenderEngine::recreateSwapchain() throw(Exception) {
 		createRenderPass();
 		createGraphicsPipeline();
 		createDepthResources();
+		createPickResources();
 		createFramebuffers();
 		createCommandBuffers();
 	}
@@ -598,7 +756,7 @@ void RenderEngine::createFramebuffers() throw(Exception) {
 		swapchainFramebuffers.resize(swapchainImageViews.size());
 
 		for (size_t i = 0; i < swapchainImageViews.size(); i++) {
-			std::array<VkImageView, 2> attachments = { swapchainImageViews[i], depthImageView };
+			std::array<VkImageView, 3> attachments = { swapchainImageViews[i], depthImageView, pickImageView };
 
 			VkFramebufferCreateInfo framebufferInfo = {};
 			framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
@@ -848,6 +1006,45 @@ void RenderEngine::createDepthResources() throw(Exception) {
 	}
 }
 /*
+* Function: createPickResources
+*
+* Paramters: none
+*
+* Return Type: void
+*
+* Description: creates the image and view of the pick attachment, which is the size of
+*				the swapchain, and the first time it is called the host visible buffer
+*				that pickObject() copies a pixel of the pick attachment into
+*
+*/
+void RenderEngine::createPickResources() throw(Exception) {
+	try {
+		createImage(VK_FORMAT_R32_UINT,
+					VK_IMAGE_TILING_OPTIMAL,
+					VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+					VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+					pickImage,
+					pickImageMemory);
+		pickImageView = createView(pickImage, VK_FORMAT_R32_UINT, VK_IMAGE_ASPECT_COLOR_BIT);
+		isPickImageDrawn = false;
+
+		if (pPickBuffer == nullptr) {
+			pPickBuffer = new vkAPI::Buffer::BufferObject(device);
+			if (pPickBuffer->createBuffer(sizeof(uint32_t),
+										  VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+										  physicalDevice,
+										  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)) {
+				throw Exception("failed to create pick buffer", "RenderEngine.cpp", "createPickResources");
+			}
+			pPickBuffer->bind();
+			pPickBuffer->map();
+		}
+	}
+	catch (Exception &excpt) {
+		throw excpt;
+	}
+}
+/*
 * Function: beginSingleTimeCommands
 *
 * Paramters: none
@@ -1028,6 +1225,7 @@ void RenderEngine::updateVertexBuffer() throw(Exception) {
 		createVertexBuffer();
 		createIndexBuffer();
 
+		resetDrawList();
 		createCommandBuffers();
 	}
 	catch (Exception &excpt) {
@@ -1134,6 +1332,91 @@ void RenderEngine::createUniformBuffer() throw(Exception) {
 		throw excpt;
 	}
 }
+/*
+* Function: createStorageBuffer
+*
+* Paramters: vkAPI::Buffer::BufferObject *&pBuffer,
+*			 const void *pData,
+*			 VkDeviceSize bufferSize
+*
+* Return Type: void
+*
+* Description: uses a staging buffer to create a device local storage buffer
+*				that holds the data parameter, the buffer is returned through pBuffer
+*
+*/
+void RenderEngine::createStorageBuffer(vkAPI::Buffer::BufferObject *&pBuffer, const void *pData, VkDeviceSize bufferSize) throw(Exception) {
+	try {
+		//creates the staging buffer
+		vkAPI::Buffer::BufferObject * pStagingBuffer;
+		pStagingBuffer = new vkAPI::Buffer::BufferObject(device);
+		if (pStagingBuffer->createBuffer(bufferSize,
+										 VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+										 physicalDevice,
+										 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)) {
+			throw Exception("failed to create buffer", "RenderEngine.cpp", "createStorageBuffer");
+		}
+		pStagingBuffer->bind();
+
+		pStagingBuffer->map(bufferSize);
+		pStagingBuffer->copyTo(pData, bufferSize);
+		pStagingBuffer->unmap();
+
+		//creates the storage buffer
+		pBuffer = new vkAPI::Buffer::BufferObject(device);
+		if (pBuffer->createBuffer(bufferSize,
+								  VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+								  physicalDevice,
+								  VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT)) {
+			throw Exception("failed to create buffer", "RenderEngine.cpp", "createStorageBuffer");
+		}
+		pBuffer->bind();
+
+		copyBuffer(pStagingBuffer->buffer, pBuffer->buffer, bufferSize);
+
+		pStagingBuffer->~BufferObject();
+	}
+	catch (Exception &excpt) {
+		throw excpt;
+	}
+}
+/*
+* Function: createGridBuffers
+*
+* Paramters: none
+*
+* Return Type: void
+*
+* Description: creates the buffers read by the grid shader. The glyph vertices and
+*				indices never change so they are device local, the cell states
+*				are written every time a cell changes so that buffer is host visible
+*				and stays mapped until cleanup
+*
+*/
+void RenderEngine::createGridBuffers() throw(Exception) {
+	try {
+		std::vector<Geometry::GlyphVertex> glyphVertices = pGrid->getGlyphVertices();
+		std::vector<uint32_t> glyphIndices = pGrid->getGlyphIndices();
+		createStorageBuffer(pGlyphVertexBuffer, glyphVertices.data(), sizeof(Geometry::GlyphVertex) * glyphVertices.size());
+		createStorageBuffer(pGlyphIndexBuffer, glyphIndices.data(), sizeof(uint32_t) * glyphIndices.size());
+
+		VkDeviceSize bufferSize = pGrid->getStateSize();
+		pGridStateBuffer = new vkAPI::Buffer::BufferObject(device);
+		if (pGridStateBuffer->createBuffer(bufferSize,
+										   VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+										   physicalDevice,
+										   VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT)) {
+			throw Exception("failed to create grid state buffer", "RenderEngine.cpp", "createGridBuffers");
+		}
+		pGridStateBuffer->bind();
+		pGridStateBuffer->map();
+		pGridStateBuffer->copyTo(pGrid->getStates(), bufferSize);
+		pGrid->clearDirty();
+	}
+	catch (Exception &excpt) {
+		throw excpt;
+	}
+}
 
 
 //**********************End of functions pretain to the various buffers******************************************************
@@ -1162,11 +1445,20 @@ void RenderEngine::createDescriptorPool() throw(Exception) {
 		poolSizeDynm.descriptorCount = 1;
 		std::vector<VkDescriptorPoolSize> sizes = { poolSize, poolSizeDynm };
 
+		//the grid descriptor set needs the view uniform buffer and three storage buffers
+		if (pGrid != nullptr) {
+			sizes[0].descriptorCount++;
+			VkDescriptorPoolSize poolSizeStorage = {};
+			poolSizeStorage.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+			poolSizeStorage.descriptorCount = 3;
+			sizes.push_back(poolSizeStorage);
+		}
+
 		VkDescriptorPoolCreateInfo poolInfo = {};
 		poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
 		poolInfo.poolSizeCount = static_cast<uint32_t>(sizes.size());
 		poolInfo.pPoolSizes = sizes.data();
-		poolInfo.maxSets = 1;
+		poolInfo.maxSets = (pGrid != nullptr) ? 2 : 1;
 
 		if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
 			throw Exception("failed to create descriptor pool", "RenderEngine.cpp", "createDescriptorPool");
@@ -1220,6 +1512,34 @@ void RenderEngine::createDescriptorSet() throw(Exception) {
 		std::vector<VkWriteDescriptorSet> writes = { descriptorWrite, descriptorWriteDynm };
 
 		vkUpdateDescriptorSets(device, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+
+		//the grid set shares the view uniform buffer, then binds the state and glyph buffers
+		if (pGrid != nullptr) {
+			allocInfo.pSetLayouts = &gridDescriptorSetLayout;
+			if (vkAllocateDescriptorSets(device, &allocInfo, &gridDescriptorSet) != VK_SUCCESS) {
+				throw Exception("failed to allocate grid descriptor set", "RenderEngine.cpp", "createDescriptorSet");
+			}
+
+			std::array<VkDescriptorBufferInfo, 4> gridInfos = {
+				bufferViewInfo,
+				pGridStateBuffer->setupDescriptorInfo(),
+				pGlyphVertexBuffer->setupDescriptorInfo(),
+				pGlyphIndexBuffer->setupDescriptorInfo()
+			};
+			std::vector<VkWriteDescriptorSet> gridWrites;
+			for (uint32_t binding = 0; binding < gridInfos.size(); binding++) {
+				VkWriteDescriptorSet write = {};
+				write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+				write.dstSet = gridDescriptorSet;
+				write.dstBinding = binding;
+				write.descriptorType = (binding == 0) ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+				write.descriptorCount = 1;
+				write.pBufferInfo = &gridInfos[binding];
+				gridWrites.push_back(write);
+			}
+
+			vkUpdateDescriptorSets(device, static_cast<uint32_t>(gridWrites.size()), gridWrites.data(), 0, nullptr);
+		}
 	}
 	catch (Exception &excpt) {
 		throw excpt;
@@ -1260,6 +1580,28 @@ void RenderEngine::createDescriptorSetLayout() throw(Exception) {
 		if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &descriptorSetLayout) != VK_SUCCESS) {
 			throw Exception("failed to create descriptor set layout", "RenderEngine.cpp", "createDescriptorSetLayout");
 		}
+
+		//the grid layout is binding 0 for the view uniform buffer, 1 for the cell states,
+		//	2 for the glyph vertices, and 3 for the glyph indices
+		if (pGrid != nullptr) {
+			std::vector<VkDescriptorSetLayoutBinding> gridLayouts = { uboLayoutBinding };
+			for (uint32_t binding = 1; binding < 4; binding++) {
+				VkDescriptorSetLayoutBinding storageBinding = {};
+				storageBinding.binding = binding;
+				storageBinding.descriptorCount = 1;
+				storageBinding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+				storageBinding.pImmutableSamplers = nullptr;
+				storageBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+				gridLayouts.push_back(storageBinding);
+			}
+
+			layoutInfo.bindingCount = static_cast<uint32_t>(gridLayouts.size());
+			layoutInfo.pBindings = gridLayouts.data();
+
+			if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &gridDescriptorSetLayout) != VK_SUCCESS) {
+				throw Exception("failed to create grid descriptor set layout", "RenderEngine.cpp", "createDescriptorSetLayout");
+			}
+		}
 	}
 	catch (Exception &excpt) {
 		throw excpt;
@@ -1281,7 +1623,8 @@ void RenderEngine::createDescriptorSetLayout() throw(Exception) {
 * Return Type: void
 *
 * Description: creates the render pass to add the color attachment for color
-*				blending and the depth attacment for the depth buffer
+*				blending and the depth attacment for the depth buffer, and the
+*				pick attachment that stores the id of the object drawn at each pixel
 *
 */
 void RenderEngine::createRenderPass() throw(Exception) {
@@ -1294,15 +1637,18 @@ void RenderEngine::createRenderPass() throw(Exception) {
 		VkAttachmentReference   colorAttachmentRef = vkAPI::InitStructs::AttachmentRef(0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
 		VkAttachmentDescription depthAttachment = vkAPI::InitStructs::AttachmentInfo(depthFormat, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
 		VkAttachmentReference   depthAttachmentRef = vkAPI::InitStructs::AttachmentRef(1, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+		VkAttachmentDescription pickAttachment = vkAPI::InitStructs::AttachmentInfo(VK_FORMAT_R32_UINT, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+		VkAttachmentReference   pickAttachmentRef = vkAPI::InitStructs::AttachmentRef(2, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+		std::array<VkAttachmentReference, 2> colorAttachmentRefs = { colorAttachmentRef, pickAttachmentRef };
 		VkSubpassDependency     dependency = vkAPI::InitStructs::SubpassDepend();
 
 		VkSubpassDescription subpass = {};
 		subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-		subpass.colorAttachmentCount = 1;
-		subpass.pColorAttachments = &colorAttachmentRef;
+		subpass.colorAttachmentCount = static_cast<uint32_t>(colorAttachmentRefs.size());
+		subpass.pColorAttachments = colorAttachmentRefs.data();
 		subpass.pDepthStencilAttachment = &depthAttachmentRef;
 
-		std::array<VkAttachmentDescription, 2> attachments = { colorAttachment, depthAttachment };
+		std::array<VkAttachmentDescription, 3> attachments = { colorAttachment, depthAttachment, pickAttachment };
 
 		VkRenderPassCreateInfo renderPassInfo = {};
 		renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
@@ -1373,10 +1719,12 @@ void RenderEngine::createGraphicsPipeline() throw(Exception) {
 		//setting up multisample state struct for pipeline object
 		VkPipelineMultisampleStateCreateInfo multisampling = vkAPI::InitStructs::MultiSampleInfo();
 
-		//setting up color blend state struct for pipeline object
-		VkPipelineColorBlendAttachmentState colorBlendAttachment = vkAPI::InitStructs::ColorBlendAttachmentInfo();
+		//setting up color blend state struct for pipeline object, one for the color and one for the pick attachment
+		std::array<VkPipelineColorBlendAttachmentState, 2> colorBlendAttachments = { vkAPI::InitStructs::ColorBlendAttachmentInfo(),
+																					  vkAPI::InitStructs::ColorBlendAttachmentInfo() };
 		VkPipelineColorBlendStateCreateInfo colorBlending = vkAPI::InitStructs::ColorBlendInfo();
-		colorBlending.pAttachments = &colorBlendAttachment;
+		colorBlending.attachmentCount = static_cast<uint32_t>(colorBlendAttachments.size());
+		colorBlending.pAttachments = colorBlendAttachments.data();
 
 		//setting up depth stencil state struct for pipeline object
 		VkPipelineDepthStencilStateCreateInfo depthStencil = {};
@@ -1418,6 +1766,38 @@ void RenderEngine::createGraphicsPipeline() throw(Exception) {
 			throw Exception("failed to create graphics pipeline", "RenderEngine.cpp", "createGraphicsPipeLine");
 		}
 
+		//the grid pipeline has no vertex input, the grid shader reads the glyphs from storage buffers
+		//	and the grid layout is passed as a push constant
+		if (pGrid != nullptr) {
+			auto gridShaderCode = Utilities::ReadFile(GRID_VERTEX_SHADER_PATH);
+			VkShaderModule gridShaderModule = Utilities::createShaderModule(gridShaderCode, device);
+			VkPipelineShaderStageCreateInfo gridShaderStages[] = { vkAPI::InitStructs::ShaderInfo(true, gridShaderModule), fragShaderStageInfo };
+
+			VkPipelineVertexInputStateCreateInfo gridVertexInputInfo = {};
+			gridVertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+
+			VkPushConstantRange pushConstant = {};
+			pushConstant.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+			pushConstant.offset = 0;
+			pushConstant.size = sizeof(Geometry::GridLayout);
+
+			pipelineLayoutInfo.pSetLayouts = &gridDescriptorSetLayout;
+			pipelineLayoutInfo.pushConstantRangeCount = 1;
+			pipelineLayoutInfo.pPushConstantRanges = &pushConstant;
+			if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &gridPipelineLayout) != VK_SUCCESS) {
+				throw Exception("failed to create grid pipeline layout", "RenderEngine.cpp", "createGraphicsPipeLine");
+			}
+
+			pipelineInfo.pStages = gridShaderStages;
+			pipelineInfo.pVertexInputState = &gridVertexInputInfo;
+			pipelineInfo.layout = gridPipelineLayout;
+			if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &gridPipeline) != VK_SUCCESS) {
+				throw Exception("failed to create grid pipeline", "RenderEngine.cpp", "createGraphicsPipeLine");
+			}
+
+			vkDestroyShaderModule(device, gridShaderModule, nullptr);
+		}
+
 		//destroy the shaders
 		vkDestroyShaderModule(device, fragShaderModule, nullptr);
 		vkDestroyShaderModule(device, vertShaderModule, nullptr);
@@ -1521,10 +1901,11 @@ void RenderEngine::createCommandBuffers() throw(Exception) {
 		beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
 
-		std::array<VkClearValue, 2> clearValues = {};
+		std::array<VkClearValue, 3> clearValues = {};
 		glm::vec3 clearCol = Geometry::getColor(Geometry::black);
 		clearValues[0].color = { clearCol.x, clearCol.y, clearCol.z, 1.0f };
 		clearValues[1].depthStencil = { 1.0f, 0 };
+		clearValues[2].color.uint32[0] = PICK_NONE;
 
 		VkRenderPassBeginInfo renderPassInfo = {};
 		renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
@@ -1547,8 +1928,9 @@ void RenderEngine::createCommandBuffers() throw(Exception) {
 			vkCmdBindIndexBuffer(commandBuffers[i], pIndexBuffer->buffer, 0, VK_INDEX_TYPE_UINT32);
 
 			//draws each object to pair with the correct unifrom matrix with the dynamic uniform buffer
-			//   each object is managed by the offset manager
-			for (uint32_t objectIndex = 0; objectIndex < pOffsetManager->getNumOfObjects(); objectIndex++) {
+			//   each object is managed by the offset manager, the object index is passed as the
+			//   first instance so the shader can write it to the pick attachment
+			for (uint32_t objectIndex : drawnObjects) {
 				uint32_t dynamicOffset = objectIndex * static_cast<uint32_t>(dynamicAlignment);
 				vkCmdBindDescriptorSets(commandBuffers[i],
 										VK_PIPELINE_BIND_POINT_GRAPHICS,
@@ -1563,7 +1945,33 @@ void RenderEngine::createCommandBuffers() throw(Exception) {
 								 1,
 								 pOffsetManager->getIndexOffset(objectIndex),
 								 pOffsetManager->getVertexOffset(objectIndex),
-								 0);
+								 objectIndex);
+			}
+
+			//draws the visible cells of the grid, each instance is one cell and the grid shader
+			//	picks the glyph from the cell's state. The instance index counts from firstInstance,
+			//	so whole rows are one call and a range of columns is one call per row
+			if (pGrid != nullptr && isGridDrawn) {
+				Geometry::GridLayout gridLayout = pGrid->getLayout();
+				vkCmdBindPipeline(commandBuffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, gridPipeline);
+				vkCmdBindDescriptorSets(commandBuffers[i],
+										VK_PIPELINE_BIND_POINT_GRAPHICS,
+										gridPipelineLayout,
+										0,
+										1,
+										&gridDescriptorSet,
+										0,
+										nullptr);
+				vkCmdPushConstants(commandBuffers[i], gridPipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(Geometry::GridLayout), &gridLayout);
+				uint32_t columns = pGrid->getNumOfColumns();
+				if (gridFirstColumn == 0 && gridLastColumn == columns - 1) {
+					vkCmdDraw(commandBuffers[i], gridLayout.indicesPerGlyph, (gridLastRow - gridFirstRow + 1) * columns, 0, gridFirstRow * columns);
+				}
+				else {
+					for (uint32_t row = gridFirstRow; row <= gridLastRow; row++) {
+						vkCmdDraw(commandBuffers[i], gridLayout.indicesPerGlyph, gridLastColumn - gridFirstColumn + 1, 0, row * columns + gridFirstColumn);
+					}
+				}
 			}
 
 			vkCmdEndRenderPass(commandBuffers[i]);
@@ -1572,11 +1980,92 @@ void RenderEngine::createCommandBuffers() throw(Exception) {
 				throw Exception("failed to record command buffer", "RenderEngine.cpp", "createCommandBuffer");
 			}
 		}
+		isDrawListChanged = false;
 	}
 	catch (Exception &excpt) {
 		throw excpt;
 	}
 }
+/*
+* Function: resetDrawList
+*
+* Paramters: none
+*
+* Return Type: void
+*
+* Description: sets the draw list to every object and every cell of the grid, used
+*				until the first cull and whenever the objects change
+*
+*/
+void RenderEngine::resetDrawList() {
+	drawnObjects.resize(pOffsetManager->getNumOfObjects());
+	for (uint32_t i = 0; i < drawnObjects.size(); i++) {
+		drawnObjects[i] = i;
+	}
+	isGridDrawn = (pGrid != nullptr && pGrid->getNumOfCells() > 0);
+	if (isGridDrawn) {
+		gridFirstRow = 0;
+		gridLastRow = pGrid->getNumOfRows() - 1;
+		gridFirstColumn = 0;
+		gridLastColumn = pGrid->getNumOfColumns() - 1;
+	}
+}
+/*
+* Function: cullDrawList
+*
+* Paramters: const Camera::UniformBufferObject &ubo,
+*			 const std::vector<glm::mat4> &uniformMatrices
+*
+* Return Type: void
+*
+* Description: builds the view frustum from the ubo and keeps the objects whose bounding
+*				sphere, moved and scaled by its model matrix, is inside of it. The grid
+*				lies on the plane z = 0, so its visible cells are the range of rows and
+*				columns under the part of the plane that is on screen. Marks the draw
+*				list as changed if it is different from what the command buffers draw
+*
+*/
+void RenderEngine::cullDrawList(const Camera::UniformBufferObject &ubo, const std::vector<glm::mat4> &uniformMatrices) {
+	Camera::Frustum frustum(ubo.proj * ubo.view);
+
+	culledObjects.clear();
+	for (uint32_t i = 0; i < pOffsetManager->getNumOfObjects() && i < uniformMatrices.size(); i++) {
+		glm::vec3 center;
+		float radius;
+		pOffsetManager->getBoundingSphere(i, center, radius);
+
+		const glm::mat4 &model = uniformMatrices[i];
+		float scale = std::max(glm::length(glm::vec3(model[0])), std::max(glm::length(glm::vec3(model[1])), glm::length(glm::vec3(model[2]))));
+		if (frustum.isSphereVisible(glm::vec3(model * glm::vec4(center, 1.0f)), radius * scale)) {
+			culledObjects.push_back(i);
+		}
+	}
+	if (culledObjects != drawnObjects) {
+		drawnObjects.swap(culledObjects);
+		isDrawListChanged = true;
+	}
+
+	if (pGrid != nullptr) {
+		uint32_t firstRow = 0, lastRow = pGrid->getNumOfRows() - 1;
+		uint32_t firstColumn = 0, lastColumn = pGrid->getNumOfColumns() - 1;
+		bool isVisible = pGrid->getNumOfCells() > 0;
+
+		//a camera that does not look at the plane draws the whole grid
+		glm::vec2 minCorner, maxCorner;
+		if (isVisible && frustum.getPlaneBounds(0.0f, minCorner, maxCorner)) {
+			isVisible = pGrid->getVisibleRange(minCorner, maxCorner, firstRow, lastRow, firstColumn, lastColumn);
+		}
+
+		if (isVisible != isGridDrawn || (isVisible && (firstRow != gridFirstRow || lastRow != gridLastRow || firstColumn != gridFirstColumn || lastColumn != gridLastColumn))) {
+			isGridDrawn = isVisible;
+			gridFirstRow = firstRow;
+			gridLastRow = lastRow;
+			gridFirstColumn = firstColumn;
+			gridLastColumn = lastColumn;
+			isDrawListChanged = true;
+		}
+	}
+}
 
 
 //**********************End of functions pretain to the command buffer*******************************************************
@@ -2,23 +2,38 @@
 #include "stdafx.h"
 #include "Exception.h"
 #include "GeometryManager.h"
+#include "InstancedGrid.h"
 #include "Camera.h"
 #include "Buffer.h"
 
+// skips the objects and grid cells outside of the view frustum when the command buffers are recorded
+#define FRUSTUM_CULLING true
+
 class RenderEngine {
 public:
-	void initVulkan(GLFWwindow *pW, Geometry::GeometryManager &newManagement) throw(Exception);
+	void initVulkan(GLFWwindow *pW, Geometry::GeometryManager &newManagement, Geometry::InstancedGrid *pNewGrid = nullptr) throw(Exception);
 	void cleanup();
 
 	void updateUniformBuffer(Camera::UniformBufferObject ubo, std::vector<glm::mat4> uniformMats);
 	void drawFrame() throw(Exception);
 
 	void updateGeometryBuffers(Geometry::GeometryManager &newManagement) throw(Exception);
+	void updateGridStates();
+
+	uint32_t pickObject(uint32_t x, uint32_t y) throw(Exception);
+
+	uint32_t getNumOfDrawnObjects() const;
+	uint32_t getNumOfDrawnCells() const;
 
+	// the values returned by pickObject(), an object in the GeometryManager is returned as
+	//	its index + 1 and a grid cell is returned as its cell index with PICK_GRID_CELL set
+	static const uint32_t PICK_NONE = 0;
+	static const uint32_t PICK_GRID_CELL = 0x80000000;
 
 private:
 	GLFWwindow * pWindow;
 	Geometry::GeometryManager *			 pOffsetManager;
+	Geometry::InstancedGrid *			 pGrid = nullptr;
 
 	VkInstance							 instance;
 	VkDebugReportCallbackEXT			 callback;
@@ -39,6 +54,12 @@ private:
 	VkDeviceMemory						 depthImageMemory;
 	VkImageView							 depthImageView;
 
+	VkImage								 pickImage;
+	VkDeviceMemory						 pickImageMemory;
+	VkImageView							 pickImageView;
+	bool								 isPickImageDrawn = false;
+	Camera::UniformBufferObject			 pickView;		//the view and projection the pick image is drawn with
+
 	Geometry::DynamicUniformBufferObject dynamicUBO;
 	size_t								 dynamicAlignment;
 
@@ -46,14 +67,22 @@ private:
 	vkAPI::Buffer::BufferObject *		 pIndexBuffer;
 	vkAPI::Buffer::BufferObject *		 pViewUniformBuffer;
 	vkAPI::Buffer::BufferObject *		 pDynamicUniformBuffer;
+	vkAPI::Buffer::BufferObject *		 pGridStateBuffer;
+	vkAPI::Buffer::BufferObject *		 pGlyphVertexBuffer;
+	vkAPI::Buffer::BufferObject *		 pGlyphIndexBuffer;
+	vkAPI::Buffer::BufferObject *		 pPickBuffer = nullptr;
 
 	VkDescriptorPool					 descriptorPool;
 	VkDescriptorSet						 descriptorSet;
 	VkDescriptorSetLayout				 descriptorSetLayout;
+	VkDescriptorSet						 gridDescriptorSet;
+	VkDescriptorSetLayout				 gridDescriptorSetLayout;
 
 	VkRenderPass						 renderPass;
 	VkPipelineLayout					 pipelineLayout;
 	VkPipeline							 graphicsPipeline;
+	VkPipelineLayout					 gridPipelineLayout;
+	VkPipeline							 gridPipeline;
 
 	VkSemaphore							 imageAvailableSemaphore;
 	VkSemaphore							 renderFinishedSemaphore;
@@ -61,6 +90,17 @@ private:
 	VkCommandPool						 commandPool;
 	std::vector<VkCommandBuffer>		 commandBuffers;
 
+	//what the command buffers draw, the objects by index and the grid as an inclusive
+	//	range of rows and columns. They are re-recorded when the culled list changes
+	std::vector<uint32_t>				 drawnObjects;
+	std::vector<uint32_t>				 culledObjects;
+	bool								 isGridDrawn = false;
+	uint32_t							 gridFirstRow = 0;
+	uint32_t							 gridLastRow = 0;
+	uint32_t							 gridFirstColumn = 0;
+	uint32_t							 gridLastColumn = 0;
+	bool								 isDrawListChanged = false;
+
 
 	void createInstance() throw(Exception);
 	bool checkValidationLayerSupport();
@@ -83,6 +123,7 @@ private:
 	VkImageView createView(VkImage image, VkFormat format, VkImageAspectFlags aspectFlags) throw(Exception);
 	void transitionImageLayout(VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout) throw(Exception);
 	void createDepthResources();
+	void createPickResources() throw(Exception);
 	VkCommandBuffer beginSingleTimeCommands();
 	void endSingleTimeCommands(VkCommandBuffer commandBuffer);
 
@@ -91,6 +132,8 @@ private:
 	void updateVertexBuffer() throw(Exception);
 	void createIndexBuffer() throw(Exception);
 	void createUniformBuffer() throw(Exception);
+	void createStorageBuffer(vkAPI::Buffer::BufferObject *&pBuffer, const void *pData, VkDeviceSize bufferSize) throw(Exception);
+	void createGridBuffers() throw(Exception);
 
 	void createDescriptorPool() throw(Exception);
 	void createDescriptorSet() throw(Exception);
@@ -103,4 +146,6 @@ private:
 
 	void createCommandPool() throw(Exception);
 	void createCommandBuffers() throw(Exception);
+	void resetDrawList();
+	void cullDrawList(const Camera::UniformBufferObject &ubo, const std::vector<glm::mat4> &uniformMatrices);
 };
\ No newline at end of file
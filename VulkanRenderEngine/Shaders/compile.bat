@@ -1,3 +1,4 @@
 C:/VulkanSDK/1.0.65.1/Bin32/glslangValidator.exe -V shader.vert
 C:/VulkanSDK/1.0.65.1/Bin32/glslangValidator.exe -V shader.frag
+C:/VulkanSDK/1.0.65.1/Bin32/glslangValidator.exe -V grid.vert -o gridvert.spv
 pause
\ No newline at end of file
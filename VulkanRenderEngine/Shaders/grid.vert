@@ -0,0 +1,57 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+
+layout(binding = 0) uniform UniformBufferObject {
+    mat4 view;
+    mat4 proj;
+} ubo;
+
+//one byte per cell, packed four to a uint
+layout(std430, binding = 1) readonly buffer CellStates {
+    uint states[];
+} cells;
+
+struct GlyphVertex {
+    vec4 pos;
+    vec4 color;
+};
+
+layout(std430, binding = 2) readonly buffer GlyphVertices {
+    GlyphVertex vertices[];
+} glyphVerts;
+
+layout(std430, binding = 3) readonly buffer GlyphIndices {
+    uint indices[];
+} glyphInds;
+
+layout(push_constant) uniform GridLayout {
+    vec4 origin;
+    vec4 step;
+    uint columns;
+    uint verticesPerGlyph;
+    uint indicesPerGlyph;
+    uint padding;
+} grid;
+
+layout(location = 0) out vec3 fragColor;
+//the pick id of the cell, the high bit marks ids that belong to grid cells
+layout(location = 1) flat out uint fragID;
+
+out gl_PerVertex {
+    vec4 gl_Position;
+};
+
+void main() {
+    uint cell = gl_InstanceIndex;
+    uint glyph = (cells.states[cell >> 2] >> ((cell & 3u) * 8u)) & 0xFFu;
+
+    uint index = glyphInds.indices[glyph * grid.indicesPerGlyph + gl_VertexIndex];
+    GlyphVertex vert = glyphVerts.vertices[glyph * grid.verticesPerGlyph + index];
+
+    vec2 offset = grid.origin.xy + vec2(cell % grid.columns, cell / grid.columns) * grid.step.xy;
+    vec3 position = vec3(offset, 0.0) + grid.origin.z * vert.pos.xyz;
+
+    gl_Position = ubo.proj * ubo.view * vec4(position, 1.0);
+    fragColor = vert.color.rgb;
+    fragID = 0x80000000u | cell;
+}
@@ -2,9 +2,12 @@
 #extension GL_ARB_separate_shader_objects : enable
 
 layout(location = 0) in vec3 fragColor;
+layout(location = 1) flat in uint fragID;
 
 layout(location = 0) out vec4 outColor;
+layout(location = 1) out uint outID;
 
 void main() {
     outColor = vec4(fragColor, 1.0);
+    outID = fragID;
 }
\ No newline at end of file
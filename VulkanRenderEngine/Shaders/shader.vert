@@ -13,6 +13,8 @@ layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inColor;
 
 layout(location = 0) out vec3 fragColor;
+//the pick id of the object, objects are drawn with the object index as the first instance
+layout(location = 1) flat out uint fragID;
 
 out gl_PerVertex {
     vec4 gl_Position;
@@ -21,4 +23,5 @@ out gl_PerVertex {
 void main() {
     gl_Position = ubo.proj * ubo.view *  bo.model * vec4(inPosition, 1.0);
     fragColor = inColor;
+    fragID = uint(gl_InstanceIndex) + 1u;
 }
\ No newline at end of file
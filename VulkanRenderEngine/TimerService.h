@@ -0,0 +1,194 @@
+/*
+* TITLE:	Vulkan Render Engine
+* BY:		Eric Hollas
+*
+* FILE:		TimerService.h
+* DETAILS:	This file defines the timer service object. Callbacks are scheduled for a time
+*				on the monotonic steady_clock, once or every period, and are run by the main
+*				loop when they are due. The earliest time is passed to the FrameScheduler as
+*				a wake up, so a loop that sleeps until its next event still runs every timer
+*				on time without checking the clock every frame.
+*			A repeating timer is scheduled from its first time and not from when it ran,
+*				so it does not drift. If the loop was away for several periods the callback
+*				is run once for the latest of them.
+*/
+#pragma once
+#include "FrameScheduler.h"
+#include <functional>
+#include <algorithm>
+#include <vector>
+#include <map>
+
+class TimerService {
+public:
+	typedef std::chrono::steady_clock::time_point time_point;
+	typedef std::chrono::steady_clock::duration duration;
+	// the callback is passed the time it was scheduled for, not the time it ran
+	typedef std::function<void(time_point)> callback;
+
+	static const uint32_t NO_TIMER = 0;
+
+	TimerService() {
+		next_id = NO_TIMER + 1;
+	}
+	~TimerService() {}
+
+	/*
+	* Function: schedule
+	*
+	* Paramters: time_point time,
+	*			 callback function
+	*
+	* Return Type: uint32_t
+	*
+	* Description: runs the function once at the time and returns the id of the timer
+	*
+	*/
+	uint32_t schedule(time_point time, callback function) {
+		return add(time, duration::zero(), function);
+	}
+	/*
+	* Function: scheduleEvery
+	*
+	* Paramters: time_point first,
+	*			 duration period,
+	*			 callback function
+	*
+	* Return Type: uint32_t
+	*
+	* Description: runs the function at first and then every period after it until the
+	*				timer is cancelled, returns the id of the timer
+	*
+	*/
+	uint32_t scheduleEvery(time_point first, duration period, callback function) {
+		return add(first, std::max(period, duration(1)), function);
+	}
+	/*
+	* Function: cancel
+	*
+	* Paramters: uint32_t id
+	*
+	* Return Type: void
+	*
+	* Description: stops the timer, an id that is not scheduled is ignored
+	*
+	*/
+	void cancel(uint32_t id) {
+		timers.erase(id);
+	}
+	bool isScheduled(uint32_t id) const {
+		return timers.find(id) != timers.end();
+	}
+
+	/*
+	* Function: runDue
+	*
+	* Paramters: time_point now
+	*
+	* Return Type: uint32_t
+	*
+	* Description: runs every callback that is due by now in the order of their times and
+	*				returns how many ran. A callback may schedule or cancel timers
+	*
+	*/
+	uint32_t runDue(time_point now) {
+		uint32_t numRan = 0;
+		while (!queue.empty() && queue.front().time <= now) {
+			std::pop_heap(queue.begin(), queue.end(), later);
+			entry due = queue.back();
+			queue.pop_back();
+
+			//a timer that was cancelled or rescheduled leaves its old entry behind
+			std::map<uint32_t, timer>::iterator found = timers.find(due.id);
+			if (found == timers.end() || found->second.time != due.time) {
+				continue;
+			}
+
+			time_point tick = due.time;
+			callback function = found->second.function;
+			if (found->second.period == duration::zero()) {
+				timers.erase(found);
+			}
+			else {
+				duration period = found->second.period;
+				tick += ((now - tick) / period) * period;
+				found->second.time = tick + period;
+				push(tick + period, due.id);
+			}
+
+			function(tick);
+			numRan++;
+		}
+		return numRan;
+	}
+	/*
+	* Function: getNextTime
+	*
+	* Paramters: time_point &time
+	*
+	* Return Type: bool
+	*
+	* Description: sets time to when the next timer is due, returns false if none is scheduled
+	*
+	*/
+	bool getNextTime(time_point &time) {
+		while (!queue.empty()) {
+			std::map<uint32_t, timer>::const_iterator found = timers.find(queue.front().id);
+			if (found != timers.end() && found->second.time == queue.front().time) {
+				time = queue.front().time;
+				return true;
+			}
+			std::pop_heap(queue.begin(), queue.end(), later);
+			queue.pop_back();
+		}
+		return false;
+	}
+	/*
+	* Function: scheduleWake
+	*
+	* Paramters: FrameScheduler &scheduler
+	*
+	* Return Type: void
+	*
+	* Description: wakes the loop of the scheduler when the next timer is due
+	*
+	*/
+	void scheduleWake(FrameScheduler &scheduler) {
+		time_point next;
+		if (getNextTime(next)) {
+			scheduler.scheduleWake(next);
+		}
+	}
+
+private:
+	struct timer {
+		time_point time;
+		duration period;		//zero for a timer that runs once
+		callback function;
+	};
+	// the min heap of due times, ordered by time then id so that timers due at the same time run in the order they were added
+	struct entry {
+		time_point time;
+		uint32_t id;
+	};
+
+	uint32_t next_id;
+	std::map<uint32_t, timer> timers;
+	std::vector<entry> queue;
+
+	uint32_t add(time_point time, duration period, callback function) {
+		uint32_t id = next_id++;
+		timer temp = { time, period, function };
+		timers[id] = temp;
+		push(time, id);
+		return id;
+	}
+	void push(time_point time, uint32_t id) {
+		entry temp = { time, id };
+		queue.push_back(temp);
+		std::push_heap(queue.begin(), queue.end(), later);
+	}
+	static bool later(const entry &a, const entry &b) {
+		return (a.time != b.time) ? a.time > b.time : a.id > b.id;
+	}
+};